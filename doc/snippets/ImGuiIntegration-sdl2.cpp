@@ -118,6 +118,8 @@ redraw();
 }
 }
 
+void drawEvent() override;
+void tickEvent() override;
 void viewportEvent(ViewportEvent& event) override;
 void pointerPressEvent(PointerEvent& event) override;
 void pointerReleaseEvent(PointerEvent& event) override;
@@ -148,6 +150,25 @@ void MyApp::pointerReleaseEvent(PointerEvent& event) {
 // ...
 /* [Context-events] */
 
+/* [Context-usage-on-demand] */
+void MyApp::drawEvent() {
+    _imgui.newFrame();
+
+    // ImGui widget calls and drawing here ...
+
+    _imgui.drawFrame();
+
+    swapBuffers();
+}
+
+void MyApp::tickEvent() {
+    /* Called once every main loop iteration, which is at most every 16 ms
+       with setMinimalLoopPeriod(16.0_msec) called in the constructor */
+    if(_imgui.wantsRedraw())
+        redraw();
+}
+/* [Context-usage-on-demand] */
+
 /* [Context-relayout-fonts-dpi] */
 void MyApp::viewportEvent(ViewportEvent& event) {
     // ...
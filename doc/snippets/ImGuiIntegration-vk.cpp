@@ -0,0 +1,75 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <imgui.h>
+#include <Magnum/Vk/CommandBuffer.h>
+#include <Magnum/Vk/Device.h>
+#include <Magnum/Vk/Fence.h>
+#include <Magnum/Vk/Framebuffer.h>
+#include <Magnum/Vk/RenderPass.h>
+
+#include "Magnum/ImGuiIntegration/VulkanRenderer.h"
+
+using namespace Magnum;
+
+/* Make sure the name doesn't conflict with any other snippets to avoid linker
+   warnings, unlike with `int main()` there now has to be a declaration to
+   avoid -Wmisssing-prototypes */
+void mainImGuiIntegrationVk();
+void mainImGuiIntegrationVk() {
+{
+Vk::Device device{NoCreate};
+Vk::RenderPass renderPass{NoCreate};
+Vk::Framebuffer framebuffer{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+Vk::Fence frameFence{NoCreate};
+/* [VulkanRenderer] */
+ImGui::CreateContext();
+ImGuiIO& io = ImGui::GetIO();
+io.DisplaySize = ImVec2{800.0f, 600.0f};
+io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+#ifdef IMGUI_HAS_TEXTURES
+io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#endif
+
+ImGuiIntegration::VulkanRenderer renderer{device, renderPass};
+
+// each frame, after waiting until the GPU is done with the frame that used
+// the same buffers, feeding input to ImGuiIO and updating the display size
+frameFence.wait();
+ImGui::NewFrame();
+// build the UI ...
+ImGui::Render();
+
+cmd.begin();
+renderer.upload(cmd, *ImGui::GetDrawData());
+cmd.beginRenderPass(Vk::RenderPassBeginInfo{renderPass, framebuffer});
+renderer.draw(cmd, *ImGui::GetDrawData());
+cmd.endRenderPass()
+   .end();
+/* [VulkanRenderer] */
+}
+}
@@ -25,14 +25,28 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/Resource.h>
 #include <imgui.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Renderer.h>
+#include <Magnum/PixelFormat.h>
 #include <Magnum/Math/Color.h>
 
 #include "Magnum/ImGuiIntegration/Integration.h"
+#include "Magnum/ImGuiIntegration/Allocator.h"
+#include "Magnum/ImGuiIntegration/CommandList.h"
 #include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/DrawDataRecording.h"
+#include "Magnum/ImGuiIntegration/ImageAtlas.h"
+#include "Magnum/ImGuiIntegration/SoftwareRenderer.h"
+#include "Magnum/ImGuiIntegration/Widgets.h"
 
 using namespace Magnum;
 
@@ -86,6 +100,254 @@ ImGuiIntegration::Context imgui(*ImGui::GetCurrentContext(), {640, 480});
 /* [Context-custom-fonts] */
 }
 
+{
+/* [Allocator] */
+/* Has to be created before any ImGui context and outlive all of them */
+ImGuiIntegration::Allocator allocator;
+allocator.setLimit(64*1024*1024);
+
+ImGuiIntegration::Context imgui{{640, 480}};
+
+// ...
+
+const ImGuiIntegration::AllocatorStatistics& statistics = allocator.statistics();
+Debug{} << "ImGui uses" << statistics.liveBytes << "bytes, at most"
+    << statistics.peakBytes << "so far";
+/* [Allocator] */
+}
+
+{
+Containers::ArrayView<const ImageView2D> thumbnails;
+/* [ImageAtlas] */
+ImGuiIntegration::ImageAtlas atlas{{2048, 2048}};
+
+/* RGBA8 images of arbitrary sizes, for example loaded from files */
+Containers::Array<UnsignedInt> ids;
+for(const ImageView2D& thumbnail: thumbnails)
+    arrayAppend(ids, atlas.add(thumbnail));
+
+// ...
+
+/* Consecutive images from the same page are drawn with a single draw call */
+for(UnsignedInt id: ids) {
+    ImGuiIntegration::image(atlas.texture(id),
+        Vector2{atlas.rectangle(id).size()}, atlas.uvRange(id));
+    ImGui::SameLine();
+}
+/* [ImageAtlas] */
+}
+
+{
+Containers::ArrayView<const Containers::StringView> names;
+Containers::ArrayView<const Float> sizes;
+Containers::ArrayView<const Color4> colors;
+/* [table] */
+const ImGuiIntegration::TableColumn columns[]{
+    ImGuiIntegration::TableColumn{"Name", names},
+    ImGuiIntegration::TableColumn{"Size", sizes, "%.1f kB"},
+    ImGuiIntegration::TableColumn{"Color", colors}
+};
+ImGuiIntegration::table("files", columns);
+/* [table] */
+}
+
+{
+Containers::Array<Containers::StringView> messages;
+Containers::Array<Float> times;
+/* [TableIndex] */
+/* Persistent across frames */
+ImGuiIntegration::TableIndex index;
+char filter[64]{};
+
+// ...
+
+/* New messages get appended to the log, only those get filtered and sorted
+   by the next table() call */
+arrayAppend(messages, Containers::StringView{"Texture upload failed"});
+arrayAppend(times, 1.25f);
+
+if(ImGui::InputText("Filter", filter, sizeof(filter)))
+    index.setFilter(filter);
+
+const ImGuiIntegration::TableColumn columns[]{
+    ImGuiIntegration::TableColumn{"Message", Containers::stridedArrayView(messages)},
+    ImGuiIntegration::TableColumn{"Time", Containers::stridedArrayView(times), "%.2f s"}
+};
+ImGuiIntegration::table("log", columns, &index);
+/* [TableIndex] */
+}
+
+{
+Containers::ArrayView<const Float> samples;
+/* [plot] */
+ImGuiIntegration::plot("signal", samples, nullptr, {-1.0f, 1.0f});
+/* [plot] */
+}
+
+{
+Containers::Array<Float> times;
+Containers::Array<Float> frameTimes;
+/* [PlotCache] */
+/* Persistent across frames */
+ImGuiIntegration::PlotCache cache;
+
+// ...
+
+/* A new sample each frame, only those get processed by the next plot() */
+arrayAppend(times, Float(ImGui::GetTime()));
+arrayAppend(frameTimes, ImGui::GetIO().DeltaTime);
+
+ImGuiIntegration::plot("frame times",
+    Containers::stridedArrayView(times),
+    Containers::stridedArrayView(frameTimes), &cache);
+/* [PlotCache] */
+}
+
+{
+/* [SharedResources] */
+ImGuiIntegration::SharedResources resources;
+
+ImGuiIntegration::Context toolWindow{resources, {640, 480}};
+ImGuiIntegration::Context renderTarget{resources, {1024, 1024}};
+/* [SharedResources] */
+}
+
+{
+/* [SharedResources-async] */
+/* Returns immediately, the shader compiles in the background */
+ImGuiIntegration::SharedResources resources =
+    ImGuiIntegration::SharedResources::compile();
+ImGuiIntegration::Context imgui{resources, {640, 480}};
+
+// ... the first few drawFrame() calls draw nothing until the shader is ready
+if(!imgui.isReady()) {
+    // draw a non-ImGui loading screen instead, for example
+}
+/* [SharedResources-async] */
+}
+
+{
+Containers::StringView configurationDirectory;
+/* [SharedResources-font-atlas-cache] */
+ImGuiIntegration::SharedResources resources;
+resources.setFontAtlasCacheDirectory(
+    Utility::Path::join(configurationDirectory, "imgui-cache"));
+
+ImGuiIntegration::Context imgui{resources, {640, 480}};
+/* [SharedResources-font-atlas-cache] */
+}
+
+{
+ImGuiIntegration::Context imgui{NoCreate};
+/* [Context-snapshots] */
+/* On the UI thread */
+imgui.newFrame();
+// ImGui widget calls here ...
+ImGuiIntegration::DrawDataSnapshot& snapshot = imgui.render();
+// hand the snapshot over to the render thread and continue with the next
+// frame. The snapshot has to be drawn before the next-but-one render().
+
+/* On the render thread, with the GL context current */
+imgui.draw(snapshot);
+/* [Context-snapshots] */
+}
+
+{
+/* [CommandList] */
+ImGuiIntegration::CommandList list{
+    ImGuiIntegration::CommandList::Flag::CombinedBuffers};
+
+ImGui::Render();
+const ImDrawData& drawData = *ImGui::GetDrawData();
+list.build(drawData);
+
+#ifdef IMGUI_HAS_TEXTURES
+for(const ImGuiIntegration::CommandListTexture& texture: list.textures()) {
+    // create, upload list.textureRegions() or destroy texture.texture, then
+    // update its status and ID
+}
+#endif
+
+// upload buffer data filled by list.copyBufferData(drawData, ...)
+
+for(const ImGuiIntegration::CommandListBatch& batch: list.batches()) {
+    if(batch.callback) {
+        batch.callback->UserCallback(drawData.CmdLists[batch.drawList],
+            batch.callback);
+        continue;
+    }
+
+    // set batch.scissor, bind batch.texture and draw
+    // list.draws().sliceSize(batch.drawOffset, batch.drawCount)
+}
+/* [CommandList] */
+}
+
+{
+ImGuiIntegration::Context imgui{NoCreate};
+/* [DrawDataRecorder] */
+ImGuiIntegration::DrawDataRecorder recorder;
+imgui.setRecorder(&recorder);
+
+// draw the frames that should be recorded ...
+
+imgui.setRecorder(nullptr);
+recorder.save("ui.imdr");
+/* [DrawDataRecorder] */
+}
+
+{
+ImGuiIntegration::Context imgui{NoCreate};
+/* [DrawDataRecording] */
+Containers::Optional<ImGuiIntegration::DrawDataRecording> recording =
+    ImGuiIntegration::DrawDataRecording::load("ui.imdr");
+if(!recording) Fatal{} << "Can't load the recording";
+
+for(std::size_t i = 0; i != recording->frameCount(); ++i) {
+    GL::defaultFramebuffer.clear(GL::FramebufferClear::Color);
+    imgui.replay(*recording, i);
+    // swap buffers, measure ...
+}
+/* [DrawDataRecording] */
+}
+
+{
+/* [SoftwareRenderer] */
+ImGuiIntegration::SoftwareRenderer renderer;
+renderer.setThreadCount(4);
+
+ImGui::CreateContext();
+ImGuiIO& io = ImGui::GetIO();
+io.DisplaySize = ImVec2{800.0f, 600.0f};
+#ifdef IMGUI_HAS_TEXTURES
+io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#else
+unsigned char* pixels;
+int width, height;
+io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+io.Fonts->SetTexID(renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm,
+    {width, height}, {pixels, std::size_t(width*height*4)}}));
+#endif
+
+Image2D image{PixelFormat::RGBA8Unorm, {800, 600},
+    Containers::Array<char>{ValueInit, 800*600*4}};
+
+ImGui::NewFrame();
+// build the UI ...
+ImGui::Render();
+renderer.draw(*ImGui::GetDrawData(), image);
+/* [SoftwareRenderer] */
+}
+
+{
+ImGuiIntegration::Context imgui{NoCreate};
+/* [Context-statistics] */
+const ImGuiIntegration::FrameStatistics& statistics = imgui.frameStatistics();
+Debug{} << statistics.drawCallCount << "draws," << statistics.uploadedBytes
+    << "bytes uploaded in" << statistics.drawFrameDuration/1000 << "µs";
+/* [Context-statistics] */
+}
+
 {
 /* [Context-custom-fonts-resource] */
 Utility::Resource rs{"fonts"};
@@ -357,6 +357,19 @@ foreach(_component ${MagnumIntegration_FIND_COMPONENTS})
             find_package(ImGui)
             set_property(TARGET MagnumIntegration::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES ImGui::ImGui)
+            # The software renderer uses std::thread for tiled rendering
+            if(_MAGNUMINTEGRATION_${_COMPONENT}_BUILD_STATIC)
+                find_package(Threads REQUIRED)
+                set_property(TARGET MagnumIntegration::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+            # The library-specific configure file was read above already
+            list(FIND _magnumIntegrationConfigure "#define MAGNUM_IMGUIINTEGRATION_TARGET_VK" _magnum${_component}Integration_TARGET_VK)
+            if(NOT _magnum${_component}Integration_TARGET_VK EQUAL -1)
+                find_package(Magnum REQUIRED Vk)
+                set_property(TARGET MagnumIntegration::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Magnum::Vk)
+            endif()
 
         # GLM integration library
         elseif(_component STREQUAL Glm)
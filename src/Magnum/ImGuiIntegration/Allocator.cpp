@@ -0,0 +1,201 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Allocator.h"
+
+#include <cstdlib>
+#include <imgui.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+/* Allocations up to 4 kB are served from power-of-two size classes starting
+   at 16 bytes, carved out of 64 kB chunks. Larger allocations go directly to
+   the system allocator. */
+constexpr std::size_t SmallestClassSize = 16;
+constexpr std::size_t ClassCount = 9;
+constexpr std::size_t ChunkSize = 64*1024;
+constexpr std::size_t Unpooled = ~std::size_t{};
+
+/* Placed in front of every allocation. Two pointer-sized members keep the
+   data aligned to twice the pointer size, same as system allocators do. */
+struct Header {
+    std::size_t size;
+    std::size_t sizeClass;
+};
+
+Allocator* currentAllocator{};
+
+struct AllocatorState {
+    AllocatorStatistics statistics{};
+    std::size_t limit{};
+    bool overLimit{};
+    /* Free blocks of each size class, linked through the first pointer of
+       their data */
+    Header* freeBlocks[ClassCount]{};
+    Containers::Array<void*> chunks;
+    /* Restored on destruction */
+    ImGuiMemAllocFunc previousAllocate;
+    ImGuiMemFreeFunc previousFree;
+    void* previousUserData;
+};
+
+Header*& nextFreeBlock(Header* block) {
+    return *reinterpret_cast<Header**>(block + 1);
+}
+
+void* allocate(const std::size_t size, void* const userData) {
+    AllocatorState& state = *static_cast<AllocatorState*>(userData);
+
+    std::size_t sizeClass = 0;
+    while(sizeClass != ClassCount && (SmallestClassSize << sizeClass) < size)
+        ++sizeClass;
+
+    Header* block;
+    if(sizeClass != ClassCount) {
+        /* No free block of given size, carve a new chunk into them. The whole
+           chunk counts as reserved right away. */
+        if(!state.freeBlocks[sizeClass]) {
+            const std::size_t blockSize = sizeof(Header) + (SmallestClassSize << sizeClass);
+            char* const chunk = static_cast<char*>(std::malloc(ChunkSize));
+            if(!chunk) return nullptr;
+            arrayAppend(state.chunks, static_cast<void*>(chunk));
+            state.statistics.reservedBytes += ChunkSize;
+
+            for(std::size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize) {
+                Header* const free = reinterpret_cast<Header*>(chunk + offset);
+                nextFreeBlock(free) = state.freeBlocks[sizeClass];
+                state.freeBlocks[sizeClass] = free;
+            }
+        }
+
+        block = state.freeBlocks[sizeClass];
+        state.freeBlocks[sizeClass] = nextFreeBlock(block);
+    } else {
+        block = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+        if(!block) return nullptr;
+        sizeClass = Unpooled;
+        state.statistics.reservedBytes += sizeof(Header) + size;
+    }
+
+    block->size = size;
+    block->sizeClass = sizeClass;
+
+    AllocatorStatistics& statistics = state.statistics;
+    statistics.liveBytes += size;
+    ++statistics.liveAllocationCount;
+    ++statistics.allocationCount;
+    statistics.allocatedBytes += size;
+    if(statistics.liveBytes > statistics.peakBytes)
+        statistics.peakBytes = statistics.liveBytes;
+
+    if(state.limit && statistics.liveBytes > state.limit && !state.overLimit) {
+        state.overLimit = true;
+        Warning{} << "ImGuiIntegration::Allocator: ImGui is using" << statistics.liveBytes << "bytes, exceeding the limit of" << state.limit << "bytes";
+    }
+
+    return block + 1;
+}
+
+void deallocate(void* const pointer, void* const userData) {
+    if(!pointer) return;
+
+    AllocatorState& state = *static_cast<AllocatorState*>(userData);
+    Header* const block = static_cast<Header*>(pointer) - 1;
+
+    AllocatorStatistics& statistics = state.statistics;
+    statistics.liveBytes -= block->size;
+    --statistics.liveAllocationCount;
+    if(state.overLimit && statistics.liveBytes <= state.limit)
+        state.overLimit = false;
+
+    if(block->sizeClass != Unpooled) {
+        nextFreeBlock(block) = state.freeBlocks[block->sizeClass];
+        state.freeBlocks[block->sizeClass] = block;
+    } else {
+        statistics.reservedBytes -= sizeof(Header) + block->size;
+        std::free(block);
+    }
+}
+
+}
+
+struct Allocator::State: AllocatorState {};
+
+Allocator* Allocator::current() {
+    return currentAllocator;
+}
+
+Allocator::Allocator(): _state{InPlaceInit} {
+    CORRADE_ASSERT(!currentAllocator,
+        "ImGuiIntegration::Allocator: another instance already exists", );
+    CORRADE_ASSERT(!ImGui::GetCurrentContext(),
+        "ImGuiIntegration::Allocator: has to be created before any ImGui context", );
+
+    ImGui::GetAllocatorFunctions(&_state->previousAllocate, &_state->previousFree, &_state->previousUserData);
+    ImGui::SetAllocatorFunctions(allocate, deallocate, static_cast<AllocatorState*>(_state.get()));
+    currentAllocator = this;
+}
+
+Allocator::~Allocator() {
+    /* Not installed, which can happen only if an assertion in the
+       constructor failed */
+    if(currentAllocator != this) return;
+
+    CORRADE_ASSERT(!_state->statistics.liveAllocationCount,
+        "ImGuiIntegration::Allocator: destroyed while ImGui still has" << _state->statistics.liveAllocationCount << "allocations alive", );
+
+    ImGui::SetAllocatorFunctions(_state->previousAllocate, _state->previousFree, _state->previousUserData);
+    currentAllocator = nullptr;
+
+    for(void* chunk: _state->chunks)
+        std::free(chunk);
+}
+
+const AllocatorStatistics& Allocator::statistics() const {
+    return _state->statistics;
+}
+
+Allocator& Allocator::resetPeakBytes() {
+    _state->statistics.peakBytes = _state->statistics.liveBytes;
+    return *this;
+}
+
+std::size_t Allocator::limit() const {
+    return _state->limit;
+}
+
+Allocator& Allocator::setLimit(const std::size_t bytes) {
+    _state->limit = bytes;
+    _state->overLimit = bytes && _state->statistics.liveBytes > bytes;
+    return *this;
+}
+
+}}
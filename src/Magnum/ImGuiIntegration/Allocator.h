@@ -0,0 +1,201 @@
+#ifndef Magnum_ImGuiIntegration_Allocator_h
+#define Magnum_ImGuiIntegration_Allocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::Allocator, struct @ref Magnum::ImGuiIntegration::AllocatorStatistics
+ * @m_since_latest_{integration}
+ */
+
+#include <cstddef>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Magnum.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Allocator statistics
+@m_since_latest_{integration}
+
+@see @ref Allocator::statistics()
+*/
+struct AllocatorStatistics {
+    /**
+     * @brief Size of memory currently allocated by ImGui in bytes
+     *
+     * Sum of sizes ImGui asked for, not including any overhead of the
+     * allocator.
+     */
+    std::size_t liveBytes;
+
+    /**
+     * @brief Peak of @ref liveBytes
+     *
+     * Since the allocator was created or since the last
+     * @ref Allocator::resetPeakBytes() call.
+     */
+    std::size_t peakBytes;
+
+    /** @brief Count of allocations currently alive */
+    std::size_t liveAllocationCount;
+
+    /**
+     * @brief Size of memory reserved from the system in bytes
+     *
+     * Includes free blocks kept for reuse and the allocator overhead. Never
+     * smaller than @ref liveBytes.
+     */
+    std::size_t reservedBytes;
+
+    /** @brief Count of all allocations since the allocator was created */
+    UnsignedLong allocationCount;
+
+    /**
+     * @brief Size of all allocations since the allocator was created in bytes
+     */
+    UnsignedLong allocatedBytes;
+};
+
+/**
+@brief Allocator for ImGui memory
+@m_since_latest_{integration}
+
+By default, Dear ImGui allocates through @ref std::malloc() and every
+@ref Context ends up allocating and freeing small blocks of memory as draw
+lists, windows and other internal structures grow and shrink. When an
+@ref Allocator instance is created, it installs itself as the allocator for
+all ImGui memory using @cpp ImGui::SetAllocatorFunctions() @ce. Small
+allocations are then served from blocks of size classes carved out of larger
+chunks, and freed blocks are kept for reuse instead of being returned to the
+system. Besides reducing the amount of calls to the system allocator, the
+instance keeps track of how much memory is ImGui using:
+
+@snippet ImGuiIntegration.cpp Allocator
+
+While an allocator is installed, @ref FrameStatistics::allocationCount and
+@relativeref{FrameStatistics,allocatedBytes} additionally report allocations
+done by each frame of a @ref Context.
+
+@section ImGuiIntegration-Allocator-limit Memory limit
+
+To notice unbounded memory growth in long-running applications, use
+@ref setLimit(). If @ref AllocatorStatistics::liveBytes exceed the limit, a
+warning is printed. The allocation itself still succeeds, as ImGui isn't
+prepared to handle allocation failures. Another warning is printed only after
+the memory use drops below the limit and exceeds it again.
+
+@section ImGuiIntegration-Allocator-lifetime Lifetime and limitations
+
+The ImGui allocator functions are global, shared by all ImGui contexts, and
+memory has to be freed by the same allocator that allocated it. Because of
+that, only one @ref Allocator instance can exist at a time, it has to be
+created before any ImGui context, and destroyed only after all ImGui contexts
+are destroyed. The statistics thus cover all contexts and not just a single
+one. The allocator isn't thread-safe, ImGui contexts used from different
+threads at the same time can't use it.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT Allocator {
+    public:
+        /**
+         * @brief Currently installed allocator
+         *
+         * Returns @cpp nullptr @ce if no instance exists.
+         */
+        static Allocator* current();
+
+        /**
+         * @brief Constructor
+         *
+         * Installs the allocator using @cpp ImGui::SetAllocatorFunctions() @ce.
+         * Expects that no other instance exists and that no ImGui context is
+         * current.
+         */
+        explicit Allocator();
+
+        /** @brief Copying is not allowed */
+        Allocator(const Allocator&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * ImGui references the instance for all allocations.
+         */
+        Allocator(Allocator&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all memory allocated by ImGui was freed. Restores the
+         * allocator functions that were installed before and returns all
+         * reserved memory to the system.
+         */
+        ~Allocator();
+
+        /** @brief Copying is not allowed */
+        Allocator& operator=(const Allocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        Allocator& operator=(Allocator&&) = delete;
+
+        /** @brief Statistics */
+        const AllocatorStatistics& statistics() const;
+
+        /**
+         * @brief Reset the peak memory use
+         * @return Reference to self (for method chaining)
+         *
+         * Sets @ref AllocatorStatistics::peakBytes to
+         * @ref AllocatorStatistics::liveBytes.
+         */
+        Allocator& resetPeakBytes();
+
+        /**
+         * @brief Memory limit in bytes
+         *
+         * Zero by default, meaning there's no limit.
+         */
+        std::size_t limit() const;
+
+        /**
+         * @brief Set memory limit
+         * @return Reference to self (for method chaining)
+         *
+         * Pass @cpp 0 @ce to disable the limit. See
+         * @ref ImGuiIntegration-Allocator-limit for more information.
+         */
+        Allocator& setLimit(std::size_t bytes);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
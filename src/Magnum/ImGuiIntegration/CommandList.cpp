@@ -0,0 +1,333 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandList.h"
+
+#include <cstring>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Magnum/Math/Functions.h>
+
+#include "Magnum/ImGuiIntegration/Integration.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+#ifdef IMGUI_HAS_TEXTURES
+/* Every upload has a fixed cost of a call into the driver and setting up the
+   transfer on top of the actual copy, expressed here as a texel count. This
+   is what makes a single bounding rectangle cheaper than a lot of tiny
+   scattered ones. */
+constexpr Int UploadOverheadTexels = 64*64;
+
+/* The texture IDs may not be assigned yet, compare the references instead */
+inline bool isSameTexture(const ImTextureRef& a, const ImTextureRef& b) {
+    return a._TexData == b._TexData && a._TexID == b._TexID;
+}
+#else
+inline bool isSameTexture(const ImTextureID a, const ImTextureID b) {
+    return a == b;
+}
+#endif
+
+}
+
+Debug& operator<<(Debug& debug, const CommandList::Flag value) {
+    debug << "ImGuiIntegration::CommandList::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case CommandList::Flag::value: return debug << "::" #value;
+        _c(CombinedBuffers)
+        _c(ScissorYUp)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const CommandList::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "ImGuiIntegration::CommandList::Flags{}", {
+        CommandList::Flag::CombinedBuffers,
+        CommandList::Flag::ScissorYUp});
+}
+
+#ifdef IMGUI_HAS_TEXTURES
+Debug& operator<<(Debug& debug, const CommandListTextureOperation value) {
+    debug << "ImGuiIntegration::CommandListTextureOperation" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case CommandListTextureOperation::value: return debug << "::" #value;
+        _c(Create)
+        _c(Update)
+        _c(Destroy)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+#endif
+
+struct CommandList::State {
+    Flags flags;
+    Range2Di framebufferRect;
+    std::size_t vertexCount = 0;
+    std::size_t indexCount = 0;
+    Containers::Array<CommandListBatch> batches;
+    Containers::Array<CommandListDraw> draws;
+    #ifdef IMGUI_HAS_TEXTURES
+    Containers::Array<CommandListTexture> textures;
+    Containers::Array<Range2Di> textureRegions;
+    #endif
+};
+
+CommandList::CommandList(const Flags flags): _state{InPlaceInit} {
+    _state->flags = flags;
+}
+
+CommandList::CommandList(CommandList&&) noexcept = default;
+
+CommandList::~CommandList() = default;
+
+CommandList& CommandList::operator=(CommandList&&) noexcept = default;
+
+CommandList::Flags CommandList::flags() const {
+    return _state->flags;
+}
+
+CommandList& CommandList::setFlags(const Flags flags) {
+    _state->flags = flags;
+    return *this;
+}
+
+CommandList& CommandList::build(const ImDrawData& drawData) {
+    State& state = *_state;
+
+    /* Keeps the capacity for the next frame */
+    arrayRemoveSuffix(state.batches, state.batches.size());
+    arrayRemoveSuffix(state.draws, state.draws.size());
+    state.vertexCount = drawData.TotalVtxCount;
+    state.indexCount = drawData.TotalIdxCount;
+
+    #ifdef IMGUI_HAS_TEXTURES
+    arrayRemoveSuffix(state.textures, state.textures.size());
+    arrayRemoveSuffix(state.textureRegions, state.textureRegions.size());
+    if(drawData.Textures) for(ImTextureData* const texture: *drawData.Textures) {
+        const std::size_t regionOffset = state.textureRegions.size();
+        CommandListTextureOperation operation;
+        if(texture->Status == ImTextureStatus_WantCreate) {
+            operation = CommandListTextureOperation::Create;
+            arrayAppend(state.textureRegions, Range2Di::fromSize({}, {texture->Width, texture->Height}));
+
+        } else if(texture->Status == ImTextureStatus_WantUpdates) {
+            operation = CommandListTextureOperation::Update;
+
+            /* Upload each update rectangle separately only if it's cheaper
+               than uploading their bounds. The rectangles may overlap in
+               which case the overlapping texels are counted twice, same as
+               they would be uploaded twice. */
+            const ImTextureRect& updateRect = texture->UpdateRect;
+            const Range2Di bounds = Range2Di::fromSize({updateRect.x, updateRect.y}, {updateRect.w, updateRect.h});
+            std::size_t separateCost = 0;
+            for(const ImTextureRect& rect: texture->Updates)
+                separateCost += UploadOverheadTexels + rect.w*rect.h;
+            if(texture->Updates.Size > 1 && separateCost < std::size_t(UploadOverheadTexels + bounds.size().product())) {
+                for(const ImTextureRect& rect: texture->Updates)
+                    arrayAppend(state.textureRegions, Range2Di::fromSize({rect.x, rect.y}, {rect.w, rect.h}));
+            } else arrayAppend(state.textureRegions, bounds);
+
+        } else if(texture->Status == ImTextureStatus_WantDestroy) {
+            operation = CommandListTextureOperation::Destroy;
+
+        } else continue;
+
+        arrayAppend(state.textures, InPlaceInit, texture, operation, UnsignedInt(regionOffset), UnsignedInt(state.textureRegions.size() - regionOffset));
+    }
+    #endif
+
+    /* Not calling drawData->ScaleClipRects() because user callbacks might
+       expect to read the original rects. This matches what the other built-in
+       backends do. We scale them manually below. */
+    const Vector2 displaySize{drawData.DisplaySize};
+    const Vector2 fbScale{drawData.FramebufferScale};
+    state.framebufferRect = Range2Di{Range2D{{}, displaySize}.scaled(fbScale)};
+    const bool combinedBuffers = !!(state.flags & Flag::CombinedBuffers);
+    const bool scissorYUp = !!(state.flags & Flag::ScissorYUp);
+
+    /* Consecutive draw commands with the same texture and scissor rectangle
+       are collected into a batch, consecutive commands that continue where
+       the previous ended into a single draw. A batch can't continue across
+       a user callback and, without combined buffers, across draw lists as
+       the buffer contents get replaced between them. */
+    CommandListBatch* batch = nullptr;
+    UnsignedInt batchIndexEnd = 0;
+    UnsignedInt batchBaseVertex = 0;
+
+    /* Offset of the current draw list in the combined buffers, stays zero if
+       the buffers aren't combined */
+    UnsignedInt listVertexOffset = 0;
+    UnsignedInt listIndexOffset = 0;
+    for(std::int_fast32_t n = 0; n < drawData.CmdLists.Size; ++n) {
+        const ImDrawList* cmdList = drawData.CmdLists[n];
+
+        for(std::int_fast32_t c = 0; c < cmdList->CmdBuffer.Size; ++c) {
+            const ImDrawCmd* pcmd = &cmdList->CmdBuffer[c];
+
+            if(pcmd->UserCallback) {
+                CommandListBatch& callback = arrayAppend(state.batches, InPlaceInit);
+                callback.drawList = n;
+                callback.drawOffset = state.draws.size();
+                callback.callback = pcmd;
+                batch = nullptr;
+                continue;
+            }
+
+            /* Skip commands that wouldn't draw anything, i.e. have no
+               elements or their clip rect is empty or entirely outside of the
+               framebuffer */
+            const Range2D clipRect = scissorYUp ?
+                Range2D{{pcmd->ClipRect.x, displaySize.y() - pcmd->ClipRect.w},
+                        {pcmd->ClipRect.z, displaySize.y() - pcmd->ClipRect.y}} :
+                Range2D{{pcmd->ClipRect.x, pcmd->ClipRect.y},
+                        {pcmd->ClipRect.z, pcmd->ClipRect.w}};
+            const Range2Di scissor = Math::intersect(state.framebufferRect, Range2Di{clipRect.scaled(fbScale)});
+            if(!pcmd->ElemCount || !(scissor.size() > Vector2i{0}).all())
+                continue;
+
+            /* VtxOffset is only > 0 if ImGuiBackendFlags_RendererHasVtxOffset
+               is set, which is also the only case where the draw list offsets
+               are non-zero */
+            const UnsignedInt baseVertex = listVertexOffset + pcmd->VtxOffset;
+            const UnsignedInt indexOffset = listIndexOffset + pcmd->IdxOffset;
+
+            /* If the state is different from the current batch, start a new
+               one */
+            #ifdef IMGUI_HAS_TEXTURES
+            const ImTextureRef& texture = pcmd->TexRef;
+            #else
+            const ImTextureID texture = pcmd->GetTexID();
+            #endif
+            if(!batch || !isSameTexture(texture, batch->texture) || scissor != batch->scissor) {
+                batch = &arrayAppend(state.batches, InPlaceInit);
+                batch->scissor = scissor;
+                batch->texture = texture;
+                batch->drawList = n;
+                batch->drawOffset = state.draws.size();
+            }
+
+            /* Extend the last draw in the batch if this command continues
+               where it ended, otherwise add a new one */
+            if(batch->drawCount && baseVertex == batchBaseVertex && indexOffset == batchIndexEnd)
+                state.draws.back().indexCount += pcmd->ElemCount;
+            else {
+                arrayAppend(state.draws, InPlaceInit, indexOffset, pcmd->ElemCount, baseVertex);
+                ++batch->drawCount;
+            }
+            batchBaseVertex = baseVertex;
+            batchIndexEnd = indexOffset + pcmd->ElemCount;
+        }
+
+        if(combinedBuffers) {
+            listVertexOffset += cmdList->VtxBuffer.Size;
+            listIndexOffset += cmdList->IdxBuffer.Size;
+        } else batch = nullptr;
+    }
+
+    return *this;
+}
+
+Range2Di CommandList::framebufferRect() const {
+    return _state->framebufferRect;
+}
+
+std::size_t CommandList::vertexCount() const {
+    return _state->vertexCount;
+}
+
+std::size_t CommandList::indexCount() const {
+    return _state->indexCount;
+}
+
+std::size_t CommandList::indexDataOffset() const {
+    /* Index data are put right after the vertex data, offset has to be
+       aligned to the index type size in case they share the same buffer */
+    return (_state->vertexCount*sizeof(ImDrawVert) + sizeof(ImDrawIdx) - 1)/sizeof(ImDrawIdx)*sizeof(ImDrawIdx);
+}
+
+std::size_t CommandList::bufferDataSize() const {
+    return indexDataOffset() + _state->indexCount*sizeof(ImDrawIdx);
+}
+
+void CommandList::copyBufferData(const ImDrawData& drawData, const Containers::ArrayView<char> out) const {
+    const std::size_t indexDataOffset = this->indexDataOffset();
+    CORRADE_ASSERT(std::size_t(drawData.TotalVtxCount) == _state->vertexCount && std::size_t(drawData.TotalIdxCount) == _state->indexCount,
+        "ImGuiIntegration::CommandList::copyBufferData(): expected draw data with" << _state->vertexCount << "vertices and" << _state->indexCount << "indices but got" << drawData.TotalVtxCount << "and" << drawData.TotalIdxCount, );
+    CORRADE_ASSERT(out.size() >= bufferDataSize(),
+        "ImGuiIntegration::CommandList::copyBufferData(): expected at least" << bufferDataSize() << "bytes but got" << out.size(), );
+
+    std::size_t vertexOffset = 0;
+    std::size_t indexOffset = indexDataOffset;
+    for(std::int_fast32_t n = 0; n < drawData.CmdLists.Size; ++n) {
+        const ImDrawList* cmdList = drawData.CmdLists[n];
+        const std::size_t listVertexDataSize = cmdList->VtxBuffer.Size*sizeof(ImDrawVert);
+        const std::size_t listIndexDataSize = cmdList->IdxBuffer.Size*sizeof(ImDrawIdx);
+        /* Passing a null pointer to memcpy() is UB even if the size is zero,
+           and empty draw lists have a null data pointer */
+        if(listVertexDataSize)
+            std::memcpy(out.data() + vertexOffset, cmdList->VtxBuffer.Data, listVertexDataSize);
+        if(listIndexDataSize)
+            std::memcpy(out.data() + indexOffset, cmdList->IdxBuffer.Data, listIndexDataSize);
+        vertexOffset += listVertexDataSize;
+        indexOffset += listIndexDataSize;
+    }
+    CORRADE_INTERNAL_ASSERT(vertexOffset == _state->vertexCount*sizeof(ImDrawVert) && indexOffset == bufferDataSize());
+}
+
+Containers::ArrayView<const CommandListBatch> CommandList::batches() const {
+    return _state->batches;
+}
+
+Containers::ArrayView<const CommandListDraw> CommandList::draws() const {
+    return _state->draws;
+}
+
+#ifdef IMGUI_HAS_TEXTURES
+Containers::ArrayView<const CommandListTexture> CommandList::textures() const {
+    return _state->textures;
+}
+
+Containers::ArrayView<const Range2Di> CommandList::textureRegions() const {
+    return _state->textureRegions;
+}
+#endif
+
+}}
@@ -0,0 +1,382 @@
+#ifndef Magnum_ImGuiIntegration_CommandList_h
+#define Magnum_ImGuiIntegration_CommandList_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::CommandList, struct @ref Magnum::ImGuiIntegration::CommandListBatch, @ref Magnum::ImGuiIntegration::CommandListDraw, @ref Magnum::ImGuiIntegration::CommandListTexture, enum @ref Magnum::ImGuiIntegration::CommandListTextureOperation
+ * @m_since_latest_{integration}
+ */
+
+#include "Magnum/ImGuiIntegration/visibility.h" /* defines IMGUI_API */
+
+#include <imgui.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Math/Range.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Command list draw
+@m_since_latest_{integration}
+
+A contiguous range of indices drawn with a single base vertex. Multiple draws
+in a single @ref CommandListBatch can be submitted as a multi-draw.
+@see @ref CommandList::draws()
+*/
+struct CommandListDraw {
+    /**
+     * @brief Offset of the first index
+     *
+     * In indices, not bytes. Relative to the combined index data if
+     * @ref CommandList::Flag::CombinedBuffers is set, relative to index data
+     * of @ref CommandListBatch::drawList otherwise.
+     */
+    UnsignedInt indexOffset;
+
+    /** @brief Index count */
+    UnsignedInt indexCount;
+
+    /**
+     * @brief Base vertex
+     *
+     * Added to all indices. Relative to the same data as @ref indexOffset.
+     */
+    UnsignedInt baseVertex;
+};
+
+/**
+@brief Command list batch
+@m_since_latest_{integration}
+
+Either a range of @ref CommandListDraw items drawn with the same texture and
+scissor rectangle, or a user callback if @ref callback is not
+@cpp nullptr @ce.
+@see @ref CommandList::batches()
+*/
+struct CommandListBatch {
+    /**
+     * @brief Scissor rectangle
+     *
+     * In framebuffer pixels, clipped to the framebuffer area and never empty.
+     * Origin is at the top left by default, at the bottom left if
+     * @ref CommandList::Flag::ScissorYUp is set. Not set for user callbacks.
+     */
+    Range2Di scissor;
+
+    /**
+     * @brief Texture to draw with
+     *
+     * On ImGui 1.92 and newer it's a @cpp ImTextureRef @ce that has to be
+     * resolved with @cpp ImTextureRef::GetTexID() @ce only once textures in
+     * @ref CommandList::textures() are processed, as their creation assigns
+     * the IDs. Not set for user callbacks.
+     */
+    #if defined(IMGUI_HAS_TEXTURES) || defined(DOXYGEN_GENERATING_OUTPUT)
+    ImTextureRef texture;
+    #else
+    ImTextureID texture;
+    #endif
+
+    /**
+     * @brief Index of the draw list
+     *
+     * Index into @cpp ImDrawData::CmdLists @ce. If
+     * @ref CommandList::Flag::CombinedBuffers is set, a batch can include
+     * draws from subsequent draw lists as well, in which case it's the index
+     * of the first one.
+     */
+    UnsignedInt drawList;
+
+    /** @brief Offset of the first draw in @ref CommandList::draws() */
+    UnsignedInt drawOffset;
+
+    /** @brief Draw count, @cpp 0 @ce for user callbacks */
+    UnsignedInt drawCount;
+
+    /**
+     * @brief User callback command
+     *
+     * If not @cpp nullptr @ce, the batch has no draws and the callback should
+     * be called with the draw list at index @ref drawList.
+     */
+    const ImDrawCmd* callback;
+};
+
+#if defined(IMGUI_HAS_TEXTURES) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Command list texture operation
+@m_since_latest_{integration}
+
+Available only on ImGui 1.92 and newer.
+@see @ref CommandListTexture
+*/
+enum class CommandListTextureOperation: UnsignedByte {
+    /** Create the texture and upload the whole image */
+    Create,
+
+    /** Upload given regions of the texture */
+    Update,
+
+    /** Destroy the texture */
+    Destroy
+};
+
+/**
+@brief Command list texture
+@m_since_latest_{integration}
+
+Available only on ImGui 1.92 and newer.
+@see @ref CommandList::textures()
+*/
+struct CommandListTexture {
+    /** @brief Texture */
+    ImTextureData* texture;
+
+    /** @brief Operation */
+    CommandListTextureOperation operation;
+
+    /**
+     * @brief Offset of the first upload region
+     *
+     * In @ref CommandList::textureRegions().
+     */
+    UnsignedInt regionOffset;
+
+    /**
+     * @brief Upload region count
+     *
+     * A single region covering the whole image for
+     * @ref CommandListTextureOperation::Create, one or more regions for
+     * @ref CommandListTextureOperation::Update and @cpp 0 @ce for
+     * @ref CommandListTextureOperation::Destroy.
+     */
+    UnsignedInt regionCount;
+};
+#endif
+
+/**
+@brief Command list
+@m_since_latest_{integration}
+
+Turns @cpp ImDrawData @ce into a backend-independent list of texture
+operations and draw batches, which is what @ref Context::drawFrame() executes
+with OpenGL. Commands that wouldn't draw anything are dropped, consecutive
+commands with the same texture and scissor rectangle are merged into a single
+@ref CommandListBatch and commands continuing where the previous ended are
+merged into a single @ref CommandListDraw. Texture updates are turned into
+upload regions, uploading either each updated rectangle separately or just
+their bounds, whichever is cheaper.
+
+The list doesn't need any GPU API, so it can be used to implement other
+renderers, or to test and benchmark the batching on the CPU alone:
+
+@snippet ImGuiIntegration.cpp CommandList
+
+The @cpp ImDrawData @ce, its draw lists and textures have to stay alive as
+long as the list is used, as it references them. Internal memory is reused
+by subsequent @ref build() calls.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT CommandList {
+    public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref setFlags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Offsets in @ref draws() are relative to combined vertex and
+             * index data of all draw lists as produced by
+             * @ref copyBufferData(), and a batch can span multiple draw
+             * lists. If not set, offsets are relative to vertex and index
+             * data of each draw list and a batch never spans draw lists,
+             * which is useful if base vertex isn't supported and draw lists
+             * have to be uploaded one by one.
+             */
+            CombinedBuffers = 1 << 0,
+
+            /**
+             * Scissor rectangles in @ref CommandListBatch::scissor have the
+             * origin at the bottom left, as used by OpenGL, instead of the
+             * top left.
+             */
+            ScissorYUp = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref setFlags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         *
+         * The list is empty until @ref build() is called.
+         */
+        explicit CommandList(Flags flags = {});
+
+        /** @brief Copying is not allowed */
+        CommandList(const CommandList&) = delete;
+
+        /** @brief Move constructor */
+        CommandList(CommandList&&) noexcept;
+
+        ~CommandList();
+
+        /** @brief Copying is not allowed */
+        CommandList& operator=(const CommandList&) = delete;
+
+        /** @brief Move assignment */
+        CommandList& operator=(CommandList&&) noexcept;
+
+        /** @brief Flags */
+        Flags flags() const;
+
+        /**
+         * @brief Set flags
+         * @return Reference to self (for method chaining)
+         *
+         * Takes effect in the next @ref build() call.
+         */
+        CommandList& setFlags(Flags flags);
+
+        /**
+         * @brief Build the list from draw data
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces the previous contents. The draw data aren't modified, in
+         * particular texture statuses stay as they are and updating them is
+         * left to the code processing @ref textures().
+         */
+        CommandList& build(const ImDrawData& drawData);
+
+        /**
+         * @brief Framebuffer rectangle
+         *
+         * Display size scaled by the framebuffer scale. All scissor
+         * rectangles are contained in it.
+         */
+        Range2Di framebufferRect() const;
+
+        /** @brief Total vertex count of all draw lists */
+        std::size_t vertexCount() const;
+
+        /** @brief Total index count of all draw lists */
+        std::size_t indexCount() const;
+
+        /**
+         * @brief Offset of index data in the combined buffer data
+         *
+         * Vertex data come first, index data follow, aligned to the index
+         * type size.
+         * @see @ref bufferDataSize(), @ref copyBufferData()
+         */
+        std::size_t indexDataOffset() const;
+
+        /**
+         * @brief Size of the combined buffer data
+         *
+         * @see @ref indexDataOffset(), @ref copyBufferData()
+         */
+        std::size_t bufferDataSize() const;
+
+        /**
+         * @brief Copy combined vertex and index data
+         *
+         * Copies vertex data of all draw lists one after another to the
+         * beginning of @p out and index data of all draw lists to
+         * @ref indexDataOffset(). Expects that @p drawData is the same that
+         * was passed to @ref build() and that @p out is at least
+         * @ref bufferDataSize() bytes.
+         */
+        void copyBufferData(const ImDrawData& drawData, Containers::ArrayView<char> out) const;
+
+        /**
+         * @brief Draw batches
+         *
+         * In the order they should be drawn.
+         */
+        Containers::ArrayView<const CommandListBatch> batches() const;
+
+        /**
+         * @brief Draws
+         *
+         * Referenced from @ref batches().
+         */
+        Containers::ArrayView<const CommandListDraw> draws() const;
+
+        #if defined(IMGUI_HAS_TEXTURES) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Texture operations
+         *
+         * Should be processed before any of @ref batches() are drawn.
+         * Available only on ImGui 1.92 and newer.
+         */
+        Containers::ArrayView<const CommandListTexture> textures() const;
+
+        /**
+         * @brief Texture upload regions
+         *
+         * In texture pixels, with the origin at the top left. Referenced from
+         * @ref textures(). Available only on ImGui 1.92 and newer.
+         */
+        Containers::ArrayView<const Range2Di> textureRegions() const;
+        #endif
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(CommandList::Flags)
+
+/**
+@debugoperatorclassenum{CommandList,CommandList::Flag}
+@m_since_latest_{integration}
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, CommandList::Flag value);
+
+/**
+@debugoperatorclassenum{CommandList,CommandList::Flags}
+@m_since_latest_{integration}
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, CommandList::Flags value);
+
+#if defined(IMGUI_HAS_TEXTURES) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@debugoperatorenum{CommandListTextureOperation}
+@m_since_latest_{integration}
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, CommandListTextureOperation value);
+#endif
+
+}}
+
+#endif
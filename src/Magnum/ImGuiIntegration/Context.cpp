@@ -34,41 +34,356 @@
 
 #include "Context.h"
 
+#include <chrono>
 #include <cstring>
 #include <imgui.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Path.h>
 #include <Corrade/Utility/Resource.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/GL/BufferImage.h>
 #include <Magnum/GL/Context.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/MeshView.h>
+#include <Magnum/GL/OpenGL.h>
 #include <Magnum/GL/PixelFormat.h>
 #include <Magnum/GL/Renderer.h>
 #include <Magnum/GL/Shader.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/TextureFormat.h>
+#include <Magnum/GL/TimeQuery.h>
 #include <Magnum/GL/Version.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Matrix3.h>
 #include <Magnum/Math/Range.h>
 
+#include "Magnum/ImGuiIntegration/Allocator.h"
+#include "Magnum/ImGuiIntegration/CommandList.h"
+#include "Magnum/ImGuiIntegration/DrawDataRecording.h"
 #include "Magnum/ImGuiIntegration/Integration.h"
 #include "Magnum/ImGuiIntegration/Widgets.h"
 
 #ifdef IMGUI_HAS_TEXTURES
-#include <imgui_internal.h> /* GetPlatformIO(ImGuiContext*) */
+#include <imgui_internal.h> /* GetPlatformIO(ImGuiContext*), InputEventsQueue */
+#elif IMGUI_VERSION_NUM >= 19000
+#include <imgui_internal.h> /* ImFontAtlasBuild*() for the font atlas cache, InputEventsQueue */
 #endif
 
 namespace Magnum { namespace ImGuiIntegration {
 
+#ifndef MAGNUM_TARGET_GLES
+namespace Implementation {
+
+/* Pixel unpack buffer used for staging texture uploads, which allows the
+   driver to return from glTexSubImage2D() right after the data is copied to
+   the buffer and transfer it to the texture asynchronously. The buffer is
+   orphaned on every upload, so writing to it never waits until the GPU is
+   done reading the previous contents. */
+struct PixelUnpackBuffer {
+    GL::Buffer buffer;
+};
+
+}
+#endif
+
 namespace {
 
+void setupMesh(GL::Mesh& mesh, GL::Buffer& vertexBuffer) {
+    mesh.setPrimitive(GL::MeshPrimitive::Triangles);
+    mesh.addVertexBuffer(vertexBuffer, 0,
+        Shaders::FlatGL2D::Position{},
+        Shaders::FlatGL2D::TextureCoordinates{},
+        Shaders::FlatGL2D::Color4{
+            Shaders::FlatGL2D::Color4::DataType::UnsignedByte,
+            Shaders::FlatGL2D::Color4::DataOption::Normalized});
+}
+
+/* Hash of font data that's a part of the font atlas cache file name. The
+   data stay at the same address for as long as the font is in the atlas. */
+struct FontDataHash {
+    const void* data;
+    std::size_t size;
+    UnsignedLong hash;
+};
+
+#if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+/* Font atlas cache file. All values are in native endianness, the file is
+   only meant to be used on the machine that created it. */
+struct FontAtlasCacheHeader {
+    char magic[4];
+    UnsignedInt version;
+    UnsignedInt fontCount;
+    UnsignedInt customRectCount;
+    Int width, height;
+    /* 1 for single-channel pixels, 4 for RGBA */
+    UnsignedInt pixelSize;
+};
+
+struct FontAtlasCacheFont {
+    Float ascent, descent;
+    Int metricsTotalSurface;
+    UnsignedInt glyphCount;
+};
+
+struct FontAtlasCacheCustomRect {
+    UnsignedShort x, y;
+};
+
+constexpr char FontAtlasCacheMagic[4]{'M', 'I', 'F', 'A'};
+
+/* FNV-1a, good enough for picking a file name */
+struct FontAtlasCacheHasher {
+    void add(const void* data, std::size_t size) {
+        for(std::size_t i = 0; i != size; ++i) {
+            hash ^= static_cast<const unsigned char*>(data)[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    template<class T> void add(const T& value) { add(&value, sizeof(T)); }
+
+    UnsignedLong hash = 14695981039346656037ull;
+};
+
+/* Font data hashes from the previous call are reused, the data are hashed
+   only for fonts that weren't there before, as they can be several megabytes
+   large */
+Containers::String fontAtlasCacheFilename(const ImFontAtlas& atlas, const Vector2& supersamplingRatio, Containers::Array<FontDataHash>& fontDataHashes) {
+    FontAtlasCacheHasher hasher;
+    /* Layout of the cached structures depends on the ImGui version */
+    hasher.add(Int(IMGUI_VERSION_NUM));
+    hasher.add(sizeof(ImFontGlyph));
+    hasher.add(supersamplingRatio);
+    hasher.add(atlas.Flags);
+    hasher.add(atlas.TexDesiredWidth);
+    hasher.add(atlas.TexGlyphPadding);
+    hasher.add(atlas.FontBuilderFlags);
+    Containers::Array<FontDataHash> nextFontDataHashes;
+    for(const ImFontConfig& config: atlas.ConfigData) {
+        const std::size_t fontDataSize = config.FontDataSize;
+        const FontDataHash* fontDataHash = nullptr;
+        for(const FontDataHash& i: fontDataHashes) if(i.data == config.FontData && i.size == fontDataSize) {
+            fontDataHash = &i;
+            break;
+        }
+        if(fontDataHash) {
+            arrayAppend(nextFontDataHashes, *fontDataHash);
+        } else {
+            FontAtlasCacheHasher fontDataHasher;
+            fontDataHasher.add(config.FontData, fontDataSize);
+            arrayAppend(nextFontDataHashes, FontDataHash{config.FontData, fontDataSize, fontDataHasher.hash});
+        }
+
+        hasher.add(nextFontDataHashes.back().hash);
+        hasher.add(config.FontNo);
+        hasher.add(config.SizePixels);
+        hasher.add(config.OversampleH);
+        hasher.add(config.OversampleV);
+        hasher.add(config.PixelSnapH);
+        hasher.add(config.GlyphExtraSpacing);
+        hasher.add(config.GlyphOffset);
+        if(config.GlyphRanges) for(const ImWchar* range = config.GlyphRanges; *range; ++range)
+            hasher.add(*range);
+        hasher.add(config.GlyphMinAdvanceX);
+        hasher.add(config.GlyphMaxAdvanceX);
+        hasher.add(config.MergeMode);
+        hasher.add(config.FontBuilderFlags);
+        hasher.add(config.RasterizerMultiply);
+        hasher.add(config.RasterizerDensity);
+        hasher.add(config.EllipsisChar);
+    }
+
+    /* Hashes of fonts that are no longer in the atlas are dropped */
+    fontDataHashes = Utility::move(nextFontDataHashes);
+    return Utility::format("imgui-font-atlas-{:.16x}.bin", hasher.hash);
+}
+
+/* Passed through ImFontAtlas::UserData to restoreFontAtlas() */
+struct FontAtlasCacheState {
+    Containers::ArrayView<const char> data;
+    const ImFontBuilderIO* builder;
+    void* userData;
+    bool restored;
+};
+
+/* Used as ImFontBuilderIO::FontBuilder_Build(), doing everything the builtin
+   builders do except for packing and rasterizing the glyphs, which is taken
+   from the cache instead */
+bool restoreFontAtlas(ImFontAtlas* atlas) {
+    FontAtlasCacheState& state = *static_cast<FontAtlasCacheState*>(atlas->UserData);
+    atlas->UserData = state.userData;
+    atlas->FontBuilderIO = state.builder;
+
+    /* Registers the mouse cursor and line rectangles if not already */
+    ImFontAtlasBuildInit(atlas);
+
+    /* If the data don't match, use the original builder. Custom rectangles
+       with glyphs get added to the fonts in ImFontAtlasBuildFinish() and
+       would be there twice. */
+    const Containers::ArrayView<const char> data = state.data;
+    const auto& header = *reinterpret_cast<const FontAtlasCacheHeader*>(data.data());
+    std::size_t expectedSize = sizeof(FontAtlasCacheHeader) +
+        header.fontCount*sizeof(FontAtlasCacheFont) +
+        header.customRectCount*sizeof(FontAtlasCacheCustomRect) +
+        std::size_t(header.width)*header.height*header.pixelSize;
+    bool valid = (header.pixelSize == 1 || header.pixelSize == 4) &&
+        header.width > 0 && header.height > 0 &&
+        header.fontCount == UnsignedInt(atlas->Fonts.Size) &&
+        header.customRectCount == UnsignedInt(atlas->CustomRects.Size) &&
+        data.size() >= expectedSize;
+    for(const ImFontAtlasCustomRect& rect: atlas->CustomRects)
+        if(rect.Font) valid = false;
+    const auto fonts = Containers::arrayCast<const FontAtlasCacheFont>(valid ?
+        data.sliceSize(sizeof(FontAtlasCacheHeader), header.fontCount*sizeof(FontAtlasCacheFont)) : nullptr);
+    for(const FontAtlasCacheFont& font: fonts)
+        expectedSize += font.glyphCount*sizeof(ImFontGlyph);
+    if(!valid || data.size() != expectedSize)
+        return atlas->Build();
+
+    std::size_t offset = sizeof(FontAtlasCacheHeader) + fonts.size()*sizeof(FontAtlasCacheFont);
+    const auto customRects = Containers::arrayCast<const FontAtlasCacheCustomRect>(data.sliceSize(offset, header.customRectCount*sizeof(FontAtlasCacheCustomRect)));
+    offset += customRects.size()*sizeof(FontAtlasCacheCustomRect);
+
+    atlas->TexWidth = header.width;
+    atlas->TexHeight = header.height;
+    atlas->TexUvScale = ImVec2{1.0f/header.width, 1.0f/header.height};
+    for(std::size_t i = 0; i != customRects.size(); ++i) {
+        atlas->CustomRects[i].X = customRects[i].x;
+        atlas->CustomRects[i].Y = customRects[i].y;
+    }
+
+    /* Set up the fonts the same way as the builders do. Merged configs only
+       add glyphs to an existing font, which are in the cache already. */
+    for(ImFontConfig& config: atlas->ConfigData) {
+        if(config.MergeMode) continue;
+        Int fontIndex = 0;
+        while(atlas->Fonts[fontIndex] != config.DstFont) ++fontIndex;
+        ImFontAtlasBuildSetupFont(atlas, config.DstFont, &config, fonts[fontIndex].ascent, fonts[fontIndex].descent);
+    }
+    for(std::size_t i = 0; i != fonts.size(); ++i) {
+        ImFont& font = *atlas->Fonts[i];
+        font.Glyphs.resize(fonts[i].glyphCount);
+        if(fonts[i].glyphCount)
+            std::memcpy(font.Glyphs.Data, data.data() + offset, fonts[i].glyphCount*sizeof(ImFontGlyph));
+        font.MetricsTotalSurface = fonts[i].metricsTotalSurface;
+        font.DirtyLookupTables = true;
+        offset += fonts[i].glyphCount*sizeof(ImFontGlyph);
+    }
+
+    /* The pixels are either single-channel, as produced by the builtin
+       builder, or RGBA if the atlas had colored glyphs.
+       ImFontAtlasBuildFinish() renders the mouse cursor and lines into
+       whichever of them is present. */
+    const std::size_t pixelDataSize = std::size_t(header.width)*header.height*header.pixelSize;
+    void* const pixels = IM_ALLOC(pixelDataSize);
+    std::memcpy(pixels, data.data() + offset, pixelDataSize);
+    if(header.pixelSize == 1)
+        atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(pixels);
+    else
+        atlas->TexPixelsRGBA32 = static_cast<unsigned int*>(pixels);
+
+    /* Builds lookup tables, sets up ellipsis and marks the atlas as ready */
+    ImFontAtlasBuildFinish(atlas);
+
+    state.restored = true;
+    return true;
+}
+
+/* Builds the atlas from given cache data. Returns false if the data don't
+   match the atlas, in which case it's built the usual way. */
+bool buildFontAtlasFromCache(ImFontAtlas& atlas, const Containers::ArrayView<const char> data) {
+    if(data.size() < sizeof(FontAtlasCacheHeader))
+        return false;
+    const auto& header = *reinterpret_cast<const FontAtlasCacheHeader*>(data.data());
+    if(std::memcmp(header.magic, FontAtlasCacheMagic, sizeof(header.magic)) != 0 || header.version != 2)
+        return false;
+
+    FontAtlasCacheState state{data, atlas.FontBuilderIO, atlas.UserData, false};
+    static const ImFontBuilderIO builder{restoreFontAtlas};
+    atlas.FontBuilderIO = &builder;
+    atlas.UserData = &state;
+    atlas.Build();
+
+    /* Build() doesn't call the builder if there's nothing to build, put the
+       original values back in that case */
+    atlas.FontBuilderIO = state.builder;
+    atlas.UserData = state.userData;
+    return state.restored;
+}
+
+/* Expects that the atlas is built and the pixels are available. Saves the
+   single-channel pixels if present, RGBA otherwise. Returns an empty array if
+   the atlas can't be cached. */
+Containers::Array<char> serializeFontAtlas(const ImFontAtlas& atlas) {
+    for(const ImFontAtlasCustomRect& rect: atlas.CustomRects)
+        if(rect.Font) return {};
+
+    const UnsignedInt pixelSize = atlas.TexPixelsAlpha8 ? 1 : 4;
+    const void* const pixels = atlas.TexPixelsAlpha8 ?
+        static_cast<const void*>(atlas.TexPixelsAlpha8) :
+        static_cast<const void*>(atlas.TexPixelsRGBA32);
+    std::size_t size = sizeof(FontAtlasCacheHeader) +
+        atlas.Fonts.Size*sizeof(FontAtlasCacheFont) +
+        atlas.CustomRects.Size*sizeof(FontAtlasCacheCustomRect) +
+        std::size_t(atlas.TexWidth)*atlas.TexHeight*pixelSize;
+    for(const ImFont* font: atlas.Fonts)
+        size += font->Glyphs.Size*sizeof(ImFontGlyph);
+
+    Containers::Array<char> out{ValueInit, size};
+    FontAtlasCacheHeader& header = *reinterpret_cast<FontAtlasCacheHeader*>(out.data());
+    std::memcpy(header.magic, FontAtlasCacheMagic, sizeof(header.magic));
+    header.version = 2;
+    header.fontCount = atlas.Fonts.Size;
+    header.customRectCount = atlas.CustomRects.Size;
+    header.width = atlas.TexWidth;
+    header.height = atlas.TexHeight;
+    header.pixelSize = pixelSize;
+
+    std::size_t offset = sizeof(FontAtlasCacheHeader);
+    for(const ImFont* font: atlas.Fonts) {
+        FontAtlasCacheFont& cached = *reinterpret_cast<FontAtlasCacheFont*>(out.data() + offset);
+        cached.ascent = font->Ascent;
+        cached.descent = font->Descent;
+        cached.metricsTotalSurface = font->MetricsTotalSurface;
+        cached.glyphCount = font->Glyphs.Size;
+        offset += sizeof(FontAtlasCacheFont);
+    }
+    for(const ImFontAtlasCustomRect& rect: atlas.CustomRects) {
+        FontAtlasCacheCustomRect& cached = *reinterpret_cast<FontAtlasCacheCustomRect*>(out.data() + offset);
+        cached.x = rect.X;
+        cached.y = rect.Y;
+        offset += sizeof(FontAtlasCacheCustomRect);
+    }
+    for(const ImFont* font: atlas.Fonts) {
+        if(font->Glyphs.Size)
+            std::memcpy(out.data() + offset, font->Glyphs.Data, font->Glyphs.Size*sizeof(ImFontGlyph));
+        offset += font->Glyphs.Size*sizeof(ImFontGlyph);
+    }
+    std::memcpy(out.data() + offset, pixels, std::size_t(atlas.TexWidth)*atlas.TexHeight*pixelSize);
+
+    return out;
+}
+#endif
+
 #ifdef IMGUI_HAS_TEXTURES
-void createTexture(ImTextureData& texture);
-void updateTexture(ImTextureData& texture, const Range2Di& rect);
+/* The create and update functions return the count of uploaded bytes */
+std::size_t createTexture(ImTextureData& texture, Implementation::PixelUnpackBuffer* pixelUnpackBuffer);
+std::size_t updateTexture(ImTextureData& texture, Containers::ArrayView<const Range2Di> regions, Implementation::PixelUnpackBuffer* pixelUnpackBuffer);
 void destroyTexture(ImTextureData& texture);
+/* The pool is always nullptr on ES and WebGL */
+std::size_t uploadTextureRect(ImTextureData& texture, const Range2Di& rect, Implementation::PixelUnpackBuffer* pixelUnpackBuffer);
 
-void createTexture(ImTextureData& texture) {
+std::size_t createTexture(ImTextureData& texture, Implementation::PixelUnpackBuffer* const pixelUnpackBuffer) {
     CORRADE_INTERNAL_ASSERT(texture.Format == ImTextureFormat_Alpha8 || texture.Format == ImTextureFormat_RGBA32);
     /* We don't support single-channel textures on GLES2/WebGL:
        - need swizzling support to reuse shaders reading alpha for transparency
@@ -77,7 +392,7 @@ void createTexture(ImTextureData& texture) {
          WebGL2, so there we'd have no way to get around the missing swizzling. */
     #if defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
     CORRADE_ASSERT(texture.Format != ImTextureFormat_Alpha8,
-        "Single-channel textures not supported in OpenGL ES 2.0 or WebGL", );
+        "Single-channel textures not supported in OpenGL ES 2.0 or WebGL", {});
     #endif
     CORRADE_INTERNAL_ASSERT(texture.GetTexID() == ImTextureID_Invalid);
     const Vector2i size{texture.Width, texture.Height};
@@ -107,11 +422,40 @@ void createTexture(ImTextureData& texture) {
     const ImTextureID id = ImTextureID(glTexture.release());
     texture.SetTexID(id);
 
-    updateTexture(texture, Range2Di::fromSize({}, size));
+    const std::size_t uploadedBytes = uploadTextureRect(texture, Range2Di::fromSize({}, size), pixelUnpackBuffer);
     texture.SetStatus(ImTextureStatus_OK);
+    return uploadedBytes;
 }
 
-void updateTexture(ImTextureData& texture, const Range2Di& rect) {
+std::size_t updateTexture(ImTextureData& texture, const Containers::ArrayView<const Range2Di> regions, Implementation::PixelUnpackBuffer* const pixelUnpackBuffer) {
+    /* Uploading a subrectangle of the input needs EXT_unpack_subimage on ES2
+       and isn't possible at all on WebGL 1. Without it the whole image gets
+       uploaded in uploadTextureRect() anyway, so do that just once. */
+    #ifdef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::unpack_subimage>())
+    #endif
+    {
+        static_cast<void>(regions);
+        const std::size_t uploadedBytes = uploadTextureRect(texture, {}, pixelUnpackBuffer);
+        texture.SetStatus(ImTextureStatus_OK);
+        return uploadedBytes;
+    }
+    #endif
+
+    /* The regions are either the update rectangles or their bounds,
+       whichever is cheaper to upload, as decided by CommandList */
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    std::size_t uploadedBytes = 0;
+    for(const Range2Di& region: regions)
+        uploadedBytes += uploadTextureRect(texture, region, pixelUnpackBuffer);
+
+    texture.SetStatus(ImTextureStatus_OK);
+    return uploadedBytes;
+    #endif
+}
+
+std::size_t uploadTextureRect(ImTextureData& texture, const Range2Di& rect, Implementation::PixelUnpackBuffer* const pixelUnpackBuffer) {
     /* On ES2 without EXT_unpack_subimage and on WebGL 1 there's no possibility
        to upload just a slice of the input, upload the whole image instead */
     Vector2i offset{NoInit};
@@ -141,14 +485,51 @@ void updateTexture(ImTextureData& texture, const Range2Di& rect) {
     }
     #endif
 
-    const auto data = Containers::arrayView(texture.GetPixels(), texture.GetSizeInBytes());
     const PixelFormat pixelFormat = texture.Format == ImTextureFormat_RGBA32 ?
         PixelFormat::RGBA8Unorm : PixelFormat::R8Unorm;
-    const ImageView2D imageView{storage, pixelFormat, size, data};
-
     GL::Texture2D glTexture = GL::Texture2D::wrap(GLuint(texture.GetTexID()), GL::ObjectFlag::Created);
+
+    /* Copy the rectangle rows tightly packed into a pixel unpack buffer and
+       upload from there */
+    #ifndef MAGNUM_TARGET_GLES
+    if(pixelUnpackBuffer) {
+        const std::size_t rowSize = size.x()*texture.BytesPerPixel;
+        const std::size_t dataSize = rowSize*size.y();
+        GL::Buffer& buffer = pixelUnpackBuffer->buffer;
+        buffer.setData({nullptr, dataSize}, GL::BufferUsage::StreamDraw);
+        Containers::ArrayView<char> out = buffer.map(0, dataSize, GL::Buffer::MapFlag::Write);
+        CORRADE_INTERNAL_ASSERT(out);
+        for(Int y = 0; y != size.y(); ++y)
+            std::memcpy(out.data() + y*rowSize, texture.GetPixelsAt(offset.x(), offset.y() + y), rowSize);
+        buffer.unmap();
+
+        /* The image takes over the buffer for the upload, give it back after */
+        GL::BufferImage2D image{PixelStorage{}.setAlignment(1), pixelFormat, size, Utility::move(buffer), dataSize};
+        glTexture.setSubImage(0, offset, image);
+        buffer = image.release();
+        return dataSize;
+    }
+    #else
+    static_cast<void>(pixelUnpackBuffer);
+    #endif
+
+    const auto data = Containers::arrayView(texture.GetPixels(), texture.GetSizeInBytes());
+    const ImageView2D imageView{storage, pixelFormat, size, data};
     glTexture.setSubImage(0, offset, imageView);
-    texture.SetStatus(ImTextureStatus_OK);
+    return size.product()*texture.BytesPerPixel;
+}
+
+/* Size of data that will be uploaded in the next drawFrame() */
+std::size_t pendingTextureUploadSize(const ImTextureData& texture) {
+    if(texture.Status == ImTextureStatus_WantCreate)
+        return texture.GetSizeInBytes();
+    if(texture.Status != ImTextureStatus_WantUpdates)
+        return 0;
+
+    std::size_t size = 0;
+    for(const ImTextureRect& rect: texture.Updates)
+        size += rect.w*rect.h*texture.BytesPerPixel;
+    return size;
 }
 
 void destroyTexture(ImTextureData& texture) {
@@ -162,15 +543,302 @@ void destroyTexture(ImTextureData& texture) {
 
 }
 
+#ifndef MAGNUM_TARGET_GLES
+/* A persistently mapped buffer split into RegionCount regions, each used for
+   a single frame. Before a region gets written to again, a fence makes sure
+   the GPU is no longer drawing from it. The buffer contains vertex data
+   followed by index data, which is allowed on desktop GL. */
+struct Context::StreamingRing {
+    enum: std::size_t {
+        RegionCount = 3,
+        MinRegionSize = 64*1024
+    };
+
+    explicit StreamingRing() = default;
+
+    ~StreamingRing() {
+        for(GLsync fence: fences) if(fence) glDeleteSync(fence);
+    }
+
+    Containers::ArrayView<char> nextRegion(std::size_t size) {
+        currentRegion = (currentRegion + 1) % RegionCount;
+
+        /* If the region isn't large enough, allocate a larger buffer. The
+           previous one is kept alive by the driver until the GPU is done
+           with it, so the fences can be discarded. Region size is kept a
+           multiple of both vertex and index size so the region offset can be
+           expressed as a base vertex and an index offset. */
+        if(!regionSize || size > regionSize) {
+            for(GLsync& fence: fences) if(fence) {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+
+            constexpr std::size_t alignment = sizeof(ImDrawVert)*sizeof(ImDrawIdx);
+            regionSize = (Math::max(Math::max(size, 2*regionSize), std::size_t{MinRegionSize}) + alignment - 1)/alignment*alignment;
+
+            mesh = GL::Mesh{};
+            buffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+            buffer.setStorage({nullptr, RegionCount*regionSize},
+                GL::Buffer::StorageFlag::MapWrite|
+                GL::Buffer::StorageFlag::MapPersistent|
+                GL::Buffer::StorageFlag::MapCoherent);
+            data = buffer.map(0, RegionCount*regionSize,
+                GL::Buffer::MapFlag::Write|
+                GL::Buffer::MapFlag::Persistent|
+                GL::Buffer::MapFlag::Coherent);
+            CORRADE_INTERNAL_ASSERT(data);
+            setupMesh(mesh, buffer);
+
+        /* Otherwise wait until the GPU is done with the region */
+        } else if(GLsync& fence = fences[currentRegion]) {
+            while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        return data.slice(regionOffset(), regionOffset() + size);
+    }
+
+    std::size_t regionOffset() const {
+        return currentRegion*regionSize;
+    }
+
+    void fence() {
+        CORRADE_INTERNAL_ASSERT(!fences[currentRegion]);
+        fences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    GL::Buffer buffer{NoCreate};
+    GL::Mesh mesh{NoCreate};
+    Containers::ArrayView<char> data;
+    std::size_t regionSize = 0;
+    UnsignedInt currentRegion = RegionCount - 1;
+    GLsync fences[RegionCount]{};
+};
+#endif
+
+/* An offscreen texture the UI gets rendered to, together with a copy of the
+   draw data it was rendered from */
+struct Context::CachedLayer {
+    explicit CachedLayer() {
+        setupMesh(mesh, vertexBuffer);
+        mesh.setPrimitive(GL::MeshPrimitive::TriangleStrip)
+            .setCount(4);
+    }
+
+    /* Appends raw bytes to the draw data signature. Empty draw lists have a
+       null data pointer, skip those. */
+    void append(const void* data, std::size_t size) {
+        if(size) arrayAppend(nextSignature, Containers::arrayView(static_cast<const char*>(data), size));
+    }
+
+    GL::Texture2D texture{NoCreate};
+    GL::Framebuffer framebuffer{NoCreate};
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
+    GL::Mesh mesh;
+    Vector2i size;
+    /* Draw data the texture contents were rendered from, and a scratch
+       array the draw data of the current frame are gathered into */
+    Containers::Array<char> signature;
+    Containers::Array<char> nextSignature;
+    bool dirty = true;
+};
+
+/* Time elapsed queries used in a round-robin fashion, so the result of each
+   is read only after the others were used. That's enough for the result to be
+   available without stalling in most cases. */
+struct Context::GpuTiming {
+    enum: std::size_t {
+        QueryCount = 3
+    };
+
+    GL::TimeQuery queries[QueryCount]{
+        GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed},
+        GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed},
+        GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed}
+    };
+    bool used[QueryCount]{};
+    UnsignedInt currentQuery = 0;
+};
+
+/* Atlases for pixel densities that were used before, most recently used
+   first. Only the builtin font is handled, the atlases are restored from the
+   serialized state without rasterizing and the textures are reused. */
+struct Context::FontAtlasResidency {
+    struct Atlas {
+        Vector2 supersamplingRatio;
+        Containers::Array<char> data;
+        GL::Texture2D texture;
+    };
+
+    /* Serialized state of the atlas that's currently used, its texture is
+       in Context::_texture */
+    Vector2 currentSupersamplingRatio;
+    Containers::Array<char> currentData;
+    Containers::Array<Atlas> inactive;
+};
+
+/* State kept between relayout() calls for the font atlas cache */
+struct Context::FontAtlasCache {
+    Containers::Array<FontDataHash> fontDataHashes;
+};
+
+namespace {
+
+#ifdef IMGUI_HAS_TEXTURES
+/* An ImGui texture whose GPU texture is created by a snapshot. The ID is
+   written by draw() and read by render() only after the snapshot was drawn,
+   the record is kept until the last snapshot referencing it is drawn as
+   well. */
+struct SnapshotTexture {
+    ImTextureData* texture;
+    ImTextureID id;
+    UnsignedLong createFrame, lastFrame;
+    /* The ImGui texture got the ID, the record is kept only for the
+       snapshots that still reference it */
+    bool committed;
+    /* The ImGui texture was destroyed before it got the ID or the snapshot
+       didn't create it */
+    bool dropped;
+    /* Pixels rasterized while the texture was waiting for the ID have to be
+       uploaded again */
+    bool uploadAll;
+};
+
+/* Copy of an ImGui texture request, executed by draw() */
+struct SnapshotTextureRequest {
+    /* Used by render() to resolve draw command textures, not accessed
+       otherwise */
+    ImTextureData* source;
+    /* Non-null if the request creates the GPU texture or uploads to a
+       texture created by an earlier snapshot */
+    SnapshotTexture* record;
+    ImTextureData texture;
+};
+
+void copyTexturePixels(ImTextureData& destination, ImTextureData& source, const Range2Di& rect) {
+    /* Reuse the allocation from previous frames if possible */
+    if(!destination.Pixels || destination.Format != source.Format || destination.Width != source.Width || destination.Height != source.Height)
+        destination.Create(source.Format, source.Width, source.Height);
+
+    const std::size_t rowSize = rect.sizeX()*source.BytesPerPixel;
+    for(Int y = rect.min().y(); y != rect.max().y(); ++y)
+        std::memcpy(destination.GetPixelsAt(rect.min().x(), y), source.GetPixelsAt(rect.min().x(), y), rowSize);
+}
+#endif
+
+/* ImVector's copy assignment frees the memory first, this grows it only if
+   needed */
+template<class T> void copyVector(ImVector<T>& destination, const ImVector<T>& source) {
+    destination.resize(source.Size);
+    if(source.Size)
+        std::memcpy(destination.Data, source.Data, source.Size*sizeof(T));
+}
+
+/* Copies statistics gathered by submitting the draw data, which may happen on
+   a render thread, to the statistics of the main thread */
+void combineDrawStatistics(FrameStatistics& statistics, const FrameStatistics& drawStatistics) {
+    statistics.drawListCount = drawStatistics.drawListCount;
+    statistics.drawCommandCount = drawStatistics.drawCommandCount;
+    statistics.drawCallCount = drawStatistics.drawCallCount;
+    statistics.vertexCount = drawStatistics.vertexCount;
+    statistics.indexCount = drawStatistics.indexCount;
+    statistics.uploadedBytes = drawStatistics.uploadedBytes;
+    statistics.textureCreateCount = drawStatistics.textureCreateCount;
+    statistics.textureUpdateCount = drawStatistics.textureUpdateCount;
+    statistics.textureDestroyCount = drawStatistics.textureDestroyCount;
+    statistics.textureUploadedBytes = drawStatistics.textureUploadedBytes;
+    statistics.textureUploadDuration = drawStatistics.textureUploadDuration;
+    statistics.gpuDuration = drawStatistics.gpuDuration;
+}
+
+}
+
+struct DrawDataSnapshot::State {
+    UnsignedLong frame = 0;
+    ImDrawData drawData;
+    /* Only ever growing, the draw lists keep their memory between frames */
+    Containers::Array<Containers::Pointer<ImDrawList>> drawLists;
+    #ifdef IMGUI_HAS_TEXTURES
+    /* Only the first textureRequestCount are used, the rest is kept for
+       reuse. ImDrawData::Textures points to textureList. */
+    Containers::Array<Containers::Pointer<SnapshotTextureRequest>> textureRequests;
+    std::size_t textureRequestCount = 0;
+    ImVector<ImTextureData*> textureList;
+    #endif
+    /* Filled by draw(), combined into the context statistics by the render()
+       that reuses the snapshot */
+    FrameStatistics statistics{};
+};
+
+DrawDataSnapshot::DrawDataSnapshot(): _state{InPlaceInit} {}
+
+DrawDataSnapshot::~DrawDataSnapshot() = default;
+
+UnsignedLong DrawDataSnapshot::frame() const {
+    return _state->frame;
+}
+
+const ImDrawData& DrawDataSnapshot::drawData() const {
+    return _state->drawData;
+}
+
+/* Two snapshots used in an alternating fashion */
+struct Context::Snapshots {
+    Containers::Pointer<DrawDataSnapshot> snapshots[2];
+    /* Count of render() calls */
+    UnsignedLong frame = 0;
+    #ifdef IMGUI_HAS_TEXTURES
+    /* Behind a pointer so they can be referenced from the requests */
+    Containers::Array<Containers::Pointer<SnapshotTexture>> textures;
+    #endif
+};
+
+Debug& operator<<(Debug& debug, const Context::Flag value) {
+    debug << "ImGuiIntegration::Context::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Context::Flag::value: return debug << "::" #value;
+        _c(CachedLayer)
+        _c(GpuTiming)
+        _c(CoalesceEvents)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const Context::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "ImGuiIntegration::Context::Flags{}", {
+        Context::Flag::CachedLayer,
+        Context::Flag::GpuTiming,
+        Context::Flag::CoalesceEvents});
+}
+
 Context::Context(const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{*ImGui::CreateContext(), size, windowSize, framebufferSize} {}
 
 Context::Context(const Vector2i& size): Context{Vector2{size}, size, size} {}
 
-Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize):
-    _context{&context},
-    _shader{Shaders::FlatGL2D::Configuration{}
-        .setFlags(Shaders::FlatGL2D::Flag::Textured|Shaders::FlatGL2D::Flag::VertexColor)}
-{
+Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{nullptr, context, size, windowSize, framebufferSize} {}
+
+Context::Context(SharedResources& resources, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{&resources, *ImGui::CreateContext(), size, windowSize, framebufferSize} {}
+
+Context::Context(SharedResources& resources, const Vector2i& size): Context{resources, Vector2{size}, size, size} {}
+
+Context::Context(SharedResources& resources, ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{&resources, context, size, windowSize, framebufferSize} {}
+
+Context::Context(SharedResources& resources, ImGuiContext& context, const Vector2i& size): Context{resources, context, Vector2{size}, size, size} {}
+
+Context::Context(SharedResources* const resources, ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): _context{&context}, _resources{resources} {
+    /* Compile our own shader if there are no shared resources */
+    if(!_resources) {
+        _ownResources.emplace();
+        _resources = _ownResources.get();
+    }
+
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(&context);
 
@@ -201,6 +869,7 @@ Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& win
     #endif
     ) {
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        _baseVertexSupported = true;
     }
     #endif
 
@@ -228,26 +897,38 @@ Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& win
        cache */
     relayout(size, windowSize, framebufferSize);
 
-    _mesh.setPrimitive(GL::MeshPrimitive::Triangles);
-    _mesh.addVertexBuffer(_vertexBuffer, 0,
-        Shaders::FlatGL2D::Position{},
-        Shaders::FlatGL2D::TextureCoordinates{},
-        Shaders::FlatGL2D::Color4{
-            Shaders::FlatGL2D::Color4::DataType::UnsignedByte,
-            Shaders::FlatGL2D::Color4::DataOption::Normalized});
+    setupMesh(_mesh, _vertexBuffer);
+
+    /* Stream the draw data through a persistently mapped buffer if possible.
+       Base vertex is needed to address the ring buffer regions. */
+    #ifndef MAGNUM_TARGET_GLES
+    if(_baseVertexSupported &&
+       GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>())
+        _streamingRing.emplace();
+    #endif
+
+    /* Stage texture uploads through a pixel buffer object, which is core in
+       OpenGL 2.1 so always available on desktop */
+    #if defined(IMGUI_HAS_TEXTURES) && !defined(MAGNUM_TARGET_GLES)
+    _pixelUnpackBuffer.emplace();
+    #endif
 
     _timeline.start();
 }
 
 Context::Context(ImGuiContext& context, const Vector2i& size): Context{context, Vector2{size}, size, size} {}
 
-Context::Context(NoCreateT) noexcept: _context{nullptr}, _shader{NoCreate}, _vertexBuffer{NoCreate}, _indexBuffer{NoCreate}, _mesh{NoCreate}
+Context::Context(NoCreateT) noexcept: _context{nullptr}, _resources{}, _vertexBuffer{NoCreate}, _indexBuffer{NoCreate}, _mesh{NoCreate}
 #if !defined(IMGUI_HAS_TEXTURES) || defined(MAGNUM_BUILD_DEPRECATED)
 , _texture{NoCreate}
 #endif
 {}
 
-Context::Context(Context&& other) noexcept: _context{other._context}, _shader{Utility::move(other._shader)}, _vertexBuffer{Utility::move(other._vertexBuffer)}, _indexBuffer{Utility::move(other._indexBuffer)}, _timeline{Utility::move(other._timeline)}, _mesh{Utility::move(other._mesh)}, _supersamplingRatio{other._supersamplingRatio}, _eventScaling{other._eventScaling}
+Context::Context(Context&& other) noexcept: _context{other._context}, _flags{other._flags}, _baseVertexSupported{other._baseVertexSupported}, _resources{other._resources}, _ownResources{Utility::move(other._ownResources)}, _vertexBuffer{Utility::move(other._vertexBuffer)}, _indexBuffer{Utility::move(other._indexBuffer)}, _timeline{Utility::move(other._timeline)}, _mesh{Utility::move(other._mesh)}, _drawStorage{Utility::move(other._drawStorage)}, _drawViews{Utility::move(other._drawViews)}, _commandList{Utility::move(other._commandList)}
+#ifndef MAGNUM_TARGET_GLES
+, _streamingRing{Utility::move(other._streamingRing)}, _pixelUnpackBuffer{Utility::move(other._pixelUnpackBuffer)}
+#endif
+, _cachedLayer{Utility::move(other._cachedLayer)}, _gpuTiming{Utility::move(other._gpuTiming)}, _frameStatistics(other._frameStatistics), _drawStatistics(other._drawStatistics), _supersamplingRatio{other._supersamplingRatio}, _eventScaling{other._eventScaling}, _glyphPrewarm{Utility::move(other._glyphPrewarm)}, _glyphPrewarmBudget{other._glyphPrewarmBudget}, _fontAtlasResidency{Utility::move(other._fontAtlasResidency)}, _residentFontAtlasCount{other._residentFontAtlasCount}, _fontAtlasCache{Utility::move(other._fontAtlasCache)}, _snapshots{Utility::move(other._snapshots)}, _recorder{other._recorder}, _coalescedEvents(other._coalescedEvents), _redrawFrames{other._redrawFrames}, _lastEventTime{other._lastEventTime}, _lastNewFrameTime{other._lastNewFrameTime}, _frameAllocationCount{other._frameAllocationCount}, _frameAllocatedBytes{other._frameAllocatedBytes}
 #if !defined(IMGUI_HAS_TEXTURES) || defined(MAGNUM_BUILD_DEPRECATED)
 , _texture{Utility::move(other._texture)}
 #endif
@@ -263,6 +944,14 @@ Context::~Context() {
             if(tex->RefCount == 1 && tex->GetTexID() != ImTextureID_Invalid)
                 destroyTexture(*tex);
         }
+
+        /* Textures created by snapshots that ImGui didn't get the ID for
+           yet */
+        if(_snapshots) for(const Containers::Pointer<SnapshotTexture>& texture: _snapshots->textures) {
+            if(!texture->committed && !texture->dropped && texture->id != ImTextureID_Invalid)
+                GL::Texture2D::wrap(GLuint(texture->id),
+                    GL::ObjectFlag::Created|GL::ObjectFlag::DeleteOnDestruction);
+        }
         #endif
 
         /* Ensure we destroy the context we're linked to */
@@ -274,13 +963,40 @@ Context::~Context() {
 Context& Context::operator=(Context&& other) noexcept {
     using Utility::swap;
     swap(_context, other._context);
-    swap(_shader, other._shader);
+    swap(_flags, other._flags);
+    swap(_baseVertexSupported, other._baseVertexSupported);
+    swap(_resources, other._resources);
+    swap(_ownResources, other._ownResources);
     swap(_vertexBuffer, other._vertexBuffer);
     swap(_indexBuffer, other._indexBuffer);
     swap(_timeline, other._timeline);
     swap(_mesh, other._mesh);
+    swap(_drawStorage, other._drawStorage);
+    swap(_drawViews, other._drawViews);
+    swap(_commandList, other._commandList);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_streamingRing, other._streamingRing);
+    swap(_pixelUnpackBuffer, other._pixelUnpackBuffer);
+    #endif
+    swap(_cachedLayer, other._cachedLayer);
+    swap(_gpuTiming, other._gpuTiming);
+    swap(_frameStatistics, other._frameStatistics);
+    swap(_drawStatistics, other._drawStatistics);
     swap(_supersamplingRatio, other._supersamplingRatio);
     swap(_eventScaling, other._eventScaling);
+    swap(_glyphPrewarm, other._glyphPrewarm);
+    swap(_glyphPrewarmBudget, other._glyphPrewarmBudget);
+    swap(_fontAtlasResidency, other._fontAtlasResidency);
+    swap(_residentFontAtlasCount, other._residentFontAtlasCount);
+    swap(_fontAtlasCache, other._fontAtlasCache);
+    swap(_snapshots, other._snapshots);
+    swap(_recorder, other._recorder);
+    swap(_coalescedEvents, other._coalescedEvents);
+    swap(_redrawFrames, other._redrawFrames);
+    swap(_lastEventTime, other._lastEventTime);
+    swap(_lastNewFrameTime, other._lastNewFrameTime);
+    swap(_frameAllocationCount, other._frameAllocationCount);
+    swap(_frameAllocatedBytes, other._frameAllocatedBytes);
     #if !defined(IMGUI_HAS_TEXTURES) || defined(MAGNUM_BUILD_DEPRECATED)
     swap(_texture, other._texture);
     #endif
@@ -293,10 +1009,103 @@ ImGuiContext* Context::release() {
     return context;
 }
 
+Context& Context::setFlags(const Flags flags) {
+    #ifndef CORRADE_NO_ASSERT
+    if((flags & Flag::GpuTiming) && !(_flags & Flag::GpuTiming)) {
+        #ifndef MAGNUM_TARGET_GLES
+        CORRADE_ASSERT(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>(),
+            "ImGuiIntegration::Context::setFlags():" << GL::Extensions::ARB::timer_query::string() << "not supported", *this);
+        #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+        CORRADE_ASSERT(GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>(),
+            "ImGuiIntegration::Context::setFlags():" << GL::Extensions::EXT::disjoint_timer_query_webgl2::string() << "not supported", *this);
+        #else
+        CORRADE_ASSERT(GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>(),
+            "ImGuiIntegration::Context::setFlags():" << GL::Extensions::EXT::disjoint_timer_query::string() << "not supported", *this);
+        #endif
+    }
+    #endif
+
+    if(!(flags & Flag::CoalesceEvents) && (_coalescedEvents.hasPosition || _coalescedEvents.hasScroll)) {
+        ImGui::SetCurrentContext(_context);
+        flushCoalescedEvents();
+    }
+
+    _flags = flags;
+    if(!(flags & Flag::CachedLayer))
+        _cachedLayer = nullptr;
+    if(!(flags & Flag::GpuTiming)) {
+        _gpuTiming = nullptr;
+        _frameStatistics.gpuDuration = 0;
+        _drawStatistics.gpuDuration = 0;
+    }
+    return *this;
+}
+
+void Context::invalidateCachedLayer() {
+    if(_cachedLayer)
+        _cachedLayer->dirty = true;
+}
+
+Context& Context::setRecorder(DrawDataRecorder* const recorder) {
+    _recorder = recorder;
+    return *this;
+}
+
+void Context::coalescePointerMove(const Vector2& position, const Int source) {
+    /* Moving after a scroll would change where the scroll happens, and
+       ImGui needs to know about the source change at the right place */
+    if((_coalescedEvents.hasScroll && _coalescedEvents.position != position) ||
+       (_coalescedEvents.hasPosition && _coalescedEvents.source != source))
+        flushCoalescedEvents();
+
+    _coalescedEvents.position = position;
+    _coalescedEvents.source = source;
+    _coalescedEvents.hasPosition = true;
+}
+
+void Context::coalesceScroll(const Vector2& position, const Vector2& offset) {
+    if(_coalescedEvents.hasScroll && _coalescedEvents.position != position)
+        flushCoalescedEvents();
+
+    /* Scroll events don't specify a source, keep the one from a preceding
+       move if there's any */
+    if(!_coalescedEvents.hasPosition)
+        _coalescedEvents.source = -1;
+    _coalescedEvents.position = position;
+    _coalescedEvents.scroll += offset;
+    _coalescedEvents.hasPosition = true;
+    _coalescedEvents.hasScroll = true;
+}
+
+void Context::flushCoalescedEvents() {
+    if(!_coalescedEvents.hasPosition)
+        return;
+
+    ImGuiIO& io = ImGui::GetIO();
+    if(_coalescedEvents.source != -1)
+        io.AddMouseSourceEvent(ImGuiMouseSource(_coalescedEvents.source));
+    io.AddMousePosEvent(_coalescedEvents.position.x(), _coalescedEvents.position.y());
+    if(_coalescedEvents.hasScroll)
+        io.AddMouseWheelEvent(_coalescedEvents.scroll.x(), _coalescedEvents.scroll.y());
+
+    _coalescedEvents = {};
+}
+
+void Context::scheduleRedraw() {
+    /* The frame processing the event and two more, as ImGui often reacts
+       with a delay of one frame and the result is visible only in the one
+       after */
+    _redrawFrames = 3;
+    _lastEventTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void Context::relayout(const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* The whole UI has to be laid out and drawn again */
+    scheduleRedraw();
+
     /* If size of the UI is 1024x576 with a 16px font but it's rendered to a
        3840x2160 framebuffer, we need to supersample the font 3,75x to get
        crisp enough look. This is the same as in Magnum::Ui::UserInterface. */
@@ -341,7 +1150,8 @@ void Context::relayout(const Vector2& size, const Vector2i& windowSize, const Ve
            one we set earlier (has the [SCALED] suffix), wipe it and replace
            with a differently scaled version. Otherwise assume the fonts are
            user-supplied, do not touch them and just rebuild the cache. */
-        if(io.Fonts->Fonts.empty() || (io.Fonts->Fonts.size() == 1 && std::strcmp(io.Fonts->Fonts[0]->GetDebugName(), "ProggyClean.ttf, 13px [SCALED]") == 0)) {
+        const bool builtinFont = io.Fonts->Fonts.empty() || (io.Fonts->Fonts.size() == 1 && std::strcmp(io.Fonts->Fonts[0]->GetDebugName(), "ProggyClean.ttf, 13px [SCALED]") == 0);
+        if(builtinFont) {
             /* Clear all fonts. Can't just replace the default font,
                unfortunately */
             io.Fonts->Clear();
@@ -358,32 +1168,133 @@ void Context::relayout(const Vector2& size, const Vector2i& windowSize, const Ve
         /* Downscale back the upscaled font to achieve supersampling */
         io.FontGlobalScale = 1.0f/nonZeroSupersamplingRatio.x();
 
+        /* With the builtin font, put the current atlas aside for when the
+           ratio changes back, and reuse an atlas that was put aside before if
+           there's one for this ratio */
+        #if IMGUI_VERSION_NUM >= 19000
+        bool resident = false;
+        if(builtinFont && _residentFontAtlasCount > 1) {
+            if(!_fontAtlasResidency)
+                _fontAtlasResidency.emplace();
+            FontAtlasResidency& residency = *_fontAtlasResidency;
+            if(!residency.currentData.isEmpty())
+                arrayInsert(residency.inactive, 0, FontAtlasResidency::Atlas{residency.currentSupersamplingRatio, Utility::move(residency.currentData), Utility::move(_texture)});
+
+            for(std::size_t i = 0; i != residency.inactive.size(); ++i) {
+                FontAtlasResidency::Atlas& atlas = residency.inactive[i];
+                if(atlas.supersamplingRatio != nonZeroSupersamplingRatio)
+                    continue;
+                if(buildFontAtlasFromCache(*io.Fonts, atlas.data)) {
+                    _texture = Utility::move(atlas.texture);
+                    residency.currentData = Utility::move(atlas.data);
+                    resident = true;
+                }
+                arrayRemove(residency.inactive, i);
+                break;
+            }
+
+            if(residency.inactive.size() > _residentFontAtlasCount - 1)
+                arrayRemoveSuffix(residency.inactive, residency.inactive.size() - (_residentFontAtlasCount - 1));
+            residency.currentSupersamplingRatio = nonZeroSupersamplingRatio;
+        } else _fontAtlasResidency = nullptr;
+        #endif
+
+        /* If there's a cache directory, try to build the atlas from there */
+        #if IMGUI_VERSION_NUM >= 19000
+        Containers::String cacheFile;
+        bool cached = false;
+        if(!resident && !_resources->fontAtlasCacheDirectory().isEmpty()) {
+            if(!_fontAtlasCache)
+                _fontAtlasCache.emplace();
+            cacheFile = Utility::Path::join(_resources->fontAtlasCacheDirectory(), fontAtlasCacheFilename(*io.Fonts, nonZeroSupersamplingRatio, _fontAtlasCache->fontDataHashes));
+            if(Utility::Path::exists(cacheFile)) {
+                if(const Containers::Optional<Containers::Array<char>> data = Utility::Path::read(cacheFile))
+                    cached = buildFontAtlasFromCache(*io.Fonts, *data);
+            }
+        }
+        #endif
+
         unsigned char *pixels;
         int width, height;
         int pixelSize;
-        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, &pixelSize);
-        CORRADE_INTERNAL_ASSERT(width > 0 && height > 0 && pixelSize == 4);
+        /* Use a single-channel atlas if possible, swizzled to white with the
+           original value in alpha, which is what the RGBA atlas contains.
+           Not possible if the atlas has colored glyphs, in which case
+           GetTexDataAsAlpha8() returns no pixels. If the atlas already has
+           just the RGBA pixels, for example when restored from a cache, it'd
+           get needlessly rebuilt, so don't even try. */
+        pixels = nullptr;
+        #if !(defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL))
+        if(
+            #ifndef MAGNUM_TARGET_GLES
+            GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_rg>() &&
+            GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_swizzle>() &&
+            #endif
+            !(io.Fonts->TexPixelsRGBA32 && !io.Fonts->TexPixelsAlpha8))
+        {
+            io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height, &pixelSize);
+        }
+        #endif
+        if(!pixels)
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, &pixelSize);
+        CORRADE_INTERNAL_ASSERT(width > 0 && height > 0 && (pixelSize == 1 || pixelSize == 4));
+
+        /* Save the freshly built atlas to the cache. Failures are not fatal,
+           Utility::Path prints a message in that case. */
+        #if IMGUI_VERSION_NUM >= 19000
+        if(!cacheFile.isEmpty() && !cached) {
+            const Containers::Array<char> data = serializeFontAtlas(*io.Fonts);
+            if(!data.isEmpty() && Utility::Path::make(_resources->fontAtlasCacheDirectory()))
+                Utility::Path::write(cacheFile, Containers::arrayView(data));
+        }
 
-        ImageView2D image{GL::PixelFormat::RGBA,
-            GL::PixelType::UnsignedByte, {width, height},
-            {pixels, std::size_t(pixelSize*width*height)}};
+        /* Remember the state of a newly built atlas for when it gets put
+           aside, a resident atlas has it already */
+        if(_fontAtlasResidency && !resident)
+            _fontAtlasResidency->currentData = serializeFontAtlas(*io.Fonts);
 
-        _texture = GL::Texture2D{};
-        _texture.setMagnificationFilter(GL::SamplerFilter::Linear)
-            .setMinificationFilter(GL::SamplerFilter::Linear)
-            #ifndef MAGNUM_TARGET_GLES2
-            .setStorage(1, GL::TextureFormat::RGBA8, image.size())
-            .setSubImage(0, {}, image)
-            #else
-            .setImage(0, GL::TextureFormat::RGBA, image)
+        /* A resident atlas has the texture already uploaded */
+        if(!resident)
+        #endif
+        {
+            _texture = GL::Texture2D{};
+            _texture.setMagnificationFilter(GL::SamplerFilter::Linear)
+                .setMinificationFilter(GL::SamplerFilter::Linear);
+
+            #if !(defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL))
+            if(pixelSize == 1) {
+                ImageView2D image{PixelStorage{}.setAlignment(1),
+                    PixelFormat::R8Unorm, {width, height},
+                    {pixels, std::size_t(width*height)}};
+                _texture
+                    .setStorage(1, GL::TextureFormat::R8, image.size())
+                    .setSubImage(0, {}, image)
+                    .setSwizzle<'1', '1', '1', 'r'>();
+            } else
             #endif
-            ;
+            {
+                ImageView2D image{GL::PixelFormat::RGBA,
+                    GL::PixelType::UnsignedByte, {width, height},
+                    {pixels, std::size_t(pixelSize*width*height)}};
+                _texture
+                    #ifndef MAGNUM_TARGET_GLES2
+                    .setStorage(1, GL::TextureFormat::RGBA8, image.size())
+                    .setSubImage(0, {}, image)
+                    #else
+                    .setImage(0, GL::TextureFormat::RGBA, image)
+                    #endif
+                    ;
+            }
+        }
 
         /* Clear texture to save RAM, we have it on the GPU now */
         io.Fonts->ClearTexData();
 
         /* Make the texture available through the ImFontAtlas */
         io.Fonts->SetTexID(textureId(_texture));
+
+        /* The cached layer was drawn with the previous texture */
+        invalidateCachedLayer();
     }
     #endif
 
@@ -394,7 +1305,60 @@ void Context::relayout(const Vector2i& size) {
     relayout(Vector2{size}, size, size);
 }
 
+Context& Context::prewarmGlyphs(ImFont& font, const Float size, const Containers::ArrayView<const Containers::Pair<char32_t, char32_t>> ranges) {
+    #ifdef IMGUI_HAS_TEXTURES
+    /* The queue is processed from the back, add the ranges in reverse so they
+       get rasterized in the order they're specified */
+    for(std::size_t i = ranges.size(); i != 0; --i) {
+        const Containers::Pair<char32_t, char32_t>& range = ranges[i - 1];
+        CORRADE_ASSERT(range.first() <= range.second(),
+            "ImGuiIntegration::Context::prewarmGlyphs(): invalid range" << range.first() << Debug::nospace << "-" << Debug::nospace << range.second(), *this);
+
+        /* Codepoints that don't fit into ImWchar can't be rasterized */
+        if(range.first() > IM_UNICODE_CODEPOINT_MAX)
+            continue;
+        arrayAppend(_glyphPrewarm, GlyphPrewarm{&font, size, range.first(),
+            Math::min(range.second(), char32_t(IM_UNICODE_CODEPOINT_MAX))});
+    }
+    #else
+    static_cast<void>(font);
+    static_cast<void>(size);
+    static_cast<void>(ranges);
+    #endif
+
+    return *this;
+}
+
+Context& Context::prewarmGlyphs(ImFont& font, const Float size, const std::initializer_list<Containers::Pair<char32_t, char32_t>> ranges) {
+    return prewarmGlyphs(font, size, Containers::arrayView(ranges));
+}
+
+Context& Context::setGlyphPrewarmBudget(const std::size_t bytes) {
+    _glyphPrewarmBudget = bytes;
+    return *this;
+}
+
+Context& Context::setResidentFontAtlasCount(const std::size_t count) {
+    CORRADE_ASSERT(count,
+        "ImGuiIntegration::Context::setResidentFontAtlasCount(): expected a non-zero count", *this);
+    _residentFontAtlasCount = count;
+    return *this;
+}
+
 void Context::newFrame() {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    /* Reset the statistics except for the GPU duration, which is updated
+       only when a new measurement is available */
+    const UnsignedLong gpuDuration = _frameStatistics.gpuDuration;
+    _frameStatistics = {};
+    _frameStatistics.gpuDuration = gpuDuration;
+
+    if(const Allocator* const allocator = Allocator::current()) {
+        _frameAllocationCount = allocator->statistics().allocationCount;
+        _frameAllocatedBytes = allocator->statistics().allocatedBytes;
+    }
+
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
@@ -414,118 +1378,806 @@ void Context::newFrame() {
     if(ImGui::GetFrameCount() != 0)
         io.DeltaTime = Math::max(io.DeltaTime, std::numeric_limits<float>::epsilon());
 
+    flushCoalescedEvents();
+
+    if(_redrawFrames)
+        --_redrawFrames;
+    _lastNewFrameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+
     ImGui::NewFrame();
+
+    /* Rasterize glyphs queued by prewarmGlyphs() until the atlas data pending
+       upload reach the budget. Glyphs that are already present are skipped
+       without counting towards it, and at least one glyph gets rasterized
+       every frame so the queue always makes progress. Has to be done after
+       NewFrame() as ImGui locks the atlas outside of a frame. */
+    #ifdef IMGUI_HAS_TEXTURES
+    bool rasterized = false;
+    while(!_glyphPrewarm.isEmpty()) {
+        GlyphPrewarm& prewarm = _glyphPrewarm.back();
+        /* The atlas texture may get reallocated if it runs out of space, so
+           query it again every time */
+        if(rasterized && pendingTextureUploadSize(*prewarm.font->ContainerAtlas->TexData) >= _glyphPrewarmBudget)
+            break;
+
+        ImFontBaked* const baked = prewarm.font->GetFontBaked(prewarm.size);
+        const ImWchar codepoint = ImWchar(prewarm.next);
+        if(!baked->IsGlyphLoaded(codepoint)) {
+            baked->FindGlyph(codepoint);
+            rasterized = true;
+        }
+
+        if(prewarm.next++ == prewarm.last)
+            arrayRemoveSuffix(_glyphPrewarm, 1);
+    }
+    #endif
+
+    _frameStatistics.newFrameDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool Context::isReady() {
+    return _resources->isReady();
+}
+
+bool Context::wantsRedraw() {
+    return nextRedrawDeadline() == 0.0f;
+}
+
+Float Context::nextRedrawDeadline() {
+    if(_redrawFrames || !isReady())
+        return 0.0f;
+
+    /* Ensure we use the context we're linked to */
+    ImGui::SetCurrentContext(_context);
+
+    const ImGuiIO& io = ImGui::GetIO();
+
+    /* Events ImGui trickled to subsequent frames */
+    #if IMGUI_VERSION_NUM >= 19000
+    if(_context->InputEventsQueue.Size)
+        return 0.0f;
+    #endif
+
+    /* Held mouse buttons repeat button presses and auto-scroll when dragging.
+       Held keys repeat, but only if ImGui uses the keyboard, and modifiers
+       alone don't. Only keyboard keys are checked, gamepad, mouse and the
+       ImGuiKey_ReservedForMod* keys that mirror held modifiers come after
+       them. */
+    if(ImGui::IsAnyMouseDown())
+        return 0.0f;
+    if(io.WantCaptureKeyboard) for(Int key = ImGuiKey_NamedKey_BEGIN; key != ImGuiKey_GamepadStart; ++key) {
+        if(key >= ImGuiKey_LeftCtrl && key <= ImGuiKey_RightSuper)
+            continue;
+        if(ImGui::IsKeyDown(ImGuiKey(key)))
+            return 0.0f;
+    }
+
+    /* Glyphs to rasterize and textures to upload, which happens only during
+       a frame */
+    if(!_glyphPrewarm.isEmpty())
+        return 0.0f;
+    #ifdef IMGUI_HAS_TEXTURES
+    for(const ImTextureData* tex: ImGui::GetPlatformIO().Textures)
+        if(tex->Status != ImTextureStatus_OK && tex->Status != ImTextureStatus_Destroyed)
+            return 0.0f;
+    #endif
+
+    const UnsignedLong now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    /* Tooltips appear after the pointer stays still for a while and modal
+       window backgrounds fade in, all of which take less than a second */
+    if(_lastEventTime && now - _lastEventTime < 1000000000ull &&
+       (ImGui::IsAnyItemHovered() || ImGui::IsPopupOpen("", ImGuiPopupFlags_AnyPopupId|ImGuiPopupFlags_AnyPopupLevel)))
+        return 0.0f;
+
+    /* The text cursor blinks with a period of 1.2 seconds, being visible for
+       0.8 of it. Redrawing every 0.4 seconds catches both changes. */
+    if(io.WantTextInput && io.ConfigInputTextCursorBlink) {
+        const UnsignedLong deadline = _lastNewFrameTime + 400000000ull;
+        return deadline <= now ? 0.0f : Float(deadline - now)*1.0e-9f;
+    }
+
+    return Constants::inf();
 }
 
 void Context::drawFrame() {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    const std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
     ImGui::Render();
+    _frameStatistics.renderDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - renderStart).count();
 
     ImDrawData* drawData = ImGui::GetDrawData();
     CORRADE_INTERNAL_ASSERT(drawData); /* This is always valid after Render() */
 
-    const Vector2 displaySize{drawData->DisplaySize};
-    if(!displaySize.product())
-        return;
+    submitDrawData(*drawData);
+    combineDrawStatistics(_frameStatistics, _drawStatistics);
+
+    updateAllocationStatistics();
+
+    _frameStatistics.drawFrameDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+DrawDataSnapshot& Context::render() {
+    /* Ensure we use the context we're linked to */
+    ImGui::SetCurrentContext(_context);
+
+    if(!_snapshots) {
+        _snapshots.emplace();
+        for(Containers::Pointer<DrawDataSnapshot>& snapshot: _snapshots->snapshots)
+            snapshot = Containers::Pointer<DrawDataSnapshot>{new DrawDataSnapshot};
+    }
+    Snapshots& snapshots = *_snapshots;
+    DrawDataSnapshot& snapshot = *snapshots.snapshots[snapshots.frame % 2];
+    DrawDataSnapshot::State& state = *snapshot._state;
+
+    /* The snapshot that's going to be overwritten was drawn already, give the
+       textures it created to ImGui. If the texture doesn't exist anymore or
+       the snapshot wasn't drawn, destroy the GPU texture or let ImGui request
+       the creation again. Records that are no longer referenced by any
+       snapshot are removed. */
+    #ifdef IMGUI_HAS_TEXTURES
+    state.textureRequestCount = 0;
+    ImVector<ImTextureData*>& textures = ImGui::GetPlatformIO().Textures;
+    const auto addTextureRequest = [&state](ImTextureData* source, SnapshotTexture* record) -> ImTextureData& {
+        if(state.textureRequestCount == state.textureRequests.size())
+            arrayAppend(state.textureRequests, Containers::Pointer<SnapshotTextureRequest>{InPlaceInit});
+        SnapshotTextureRequest& request = *state.textureRequests[state.textureRequestCount++];
+        request.source = source;
+        request.record = record;
+        request.texture.SetTexID(ImTextureID_Invalid);
+        request.texture.Updates.resize(0);
+        return request.texture;
+    };
+    for(std::size_t i = 0; i != snapshots.textures.size(); ) {
+        SnapshotTexture& record = *snapshots.textures[i];
+        if(state.frame && record.createFrame == state.frame) {
+            bool alive = false;
+            for(ImTextureData* texture: textures) if(texture == record.texture) {
+                alive = true;
+                break;
+            }
+
+            if(alive && record.texture->Status == ImTextureStatus_WantCreate && record.id != ImTextureID_Invalid) {
+                record.texture->SetTexID(record.id);
+                record.texture->SetStatus(ImTextureStatus_OK);
+                record.committed = true;
+                record.uploadAll = true;
+            } else {
+                if(record.id != ImTextureID_Invalid) {
+                    ImTextureData& destroy = addTextureRequest(nullptr, nullptr);
+                    destroy.SetTexID(record.id);
+                    destroy.Status = ImTextureStatus_WantDestroy;
+                }
+                record.dropped = true;
+            }
+        }
+
+        if((record.committed || record.dropped) && record.lastFrame <= state.frame)
+            arrayRemove(snapshots.textures, i);
+        else ++i;
+    }
+    #endif
+
+    /* Statistics of the snapshot's draw() become available only now, as
+       draw() may run on another thread */
+    if(state.frame) {
+        combineDrawStatistics(_frameStatistics, state.statistics);
+        _frameStatistics.drawFrameDuration = state.statistics.drawFrameDuration;
+        state.statistics = {};
+    }
+
+    state.frame = ++snapshots.frame;
+
+    const std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
+    ImGui::Render();
+    _frameStatistics.renderDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - renderStart).count();
 
-    /* Not calling drawData->ScaleClipRects() because user callbacks might
-       expect to read the original rects. This matches what the other built-in
-       backends do. We scale them manually below. */
-    const Vector2 fbScale{drawData->FramebufferScale};
+    const ImDrawData* drawData = ImGui::GetDrawData();
+    CORRADE_INTERNAL_ASSERT(drawData); /* This is always valid after Render() */
 
+    /* Copy the texture requests. Draws with zero size don't process textures,
+       same as in drawFrame(). */
     #ifdef IMGUI_HAS_TEXTURES
-    if(drawData->Textures) {
-        for(ImTextureData* tex : *drawData->Textures) {
-            switch(tex->Status) {
-                case ImTextureStatus_WantCreate:
-                    createTexture(*tex);
+    if(drawData->Textures && Vector2{drawData->DisplaySize}.product()) {
+        for(ImTextureData* texture: *drawData->Textures) {
+            const Range2Di all{{}, {texture->Width, texture->Height}};
+            SnapshotTexture* record = nullptr;
+            for(Containers::Pointer<SnapshotTexture>& i: snapshots.textures) {
+                if(i->texture == texture && !i->dropped) {
+                    record = i.get();
                     break;
-                case ImTextureStatus_WantUpdates: {
-                    const ImTextureRect& rect = tex->UpdateRect;
-                    updateTexture(*tex, Range2Di::fromSize({rect.x, rect.y}, {rect.w, rect.h}));
+                }
+            }
+
+            /* Creation in a snapshot that's not drawn yet, upload everything
+               again to include glyphs rasterized since */
+            if(record && !record->committed) {
+                if(texture->Status != ImTextureStatus_WantCreate)
+                    continue;
+                ImTextureData& copy = addTextureRequest(texture, record);
+                copyTexturePixels(copy, *texture, all);
+                copy.Updates.push_back(ImTextureRect{0, 0, UnsignedShort(texture->Width), UnsignedShort(texture->Height)});
+                copy.UpdateRect = copy.Updates.back();
+                copy.Status = ImTextureStatus_WantUpdates;
+                record->lastFrame = state.frame;
+
+            /* The GPU texture gets created in draw(), the ImGui texture gets
+               the ID once this snapshot is overwritten */
+            } else if(texture->Status == ImTextureStatus_WantCreate) {
+                arrayAppend(snapshots.textures, Containers::Pointer<SnapshotTexture>{InPlaceInit, texture, ImTextureID_Invalid, state.frame, state.frame, false, false, false});
+                ImTextureData& copy = addTextureRequest(texture, snapshots.textures.back().get());
+                copyTexturePixels(copy, *texture, all);
+                copy.Status = ImTextureStatus_WantCreate;
+
+            /* The GPU texture exists, the ImGui texture is marked as
+               destroyed right away. Nothing references it from now on, so
+               the destruction can happen later. */
+            } else if(texture->Status == ImTextureStatus_WantDestroy) {
+                ImTextureData& copy = addTextureRequest(nullptr, nullptr);
+                copy.SetTexID(texture->GetTexID());
+                copy.Status = ImTextureStatus_WantDestroy;
+                texture->SetTexID(ImTextureID_Invalid);
+                texture->SetStatus(ImTextureStatus_Destroyed);
+
+            /* The GPU texture exists, copy just the updated area */
+            } else if(texture->Status == ImTextureStatus_WantUpdates || (record && record->uploadAll)) {
+                ImTextureData& copy = addTextureRequest(nullptr, nullptr);
+                copy.SetTexID(texture->GetTexID());
+                if(record && record->uploadAll) {
+                    copyTexturePixels(copy, *texture, all);
+                    copy.Updates.push_back(ImTextureRect{0, 0, UnsignedShort(texture->Width), UnsignedShort(texture->Height)});
+                    copy.UpdateRect = copy.Updates.back();
+                    record->uploadAll = false;
+                } else {
+                    const ImTextureRect& rect = texture->UpdateRect;
+                    copyTexturePixels(copy, *texture, Range2Di::fromSize({rect.x, rect.y}, {rect.w, rect.h}));
+                    copyVector(copy.Updates, texture->Updates);
+                    copy.UpdateRect = rect;
+                }
+                copy.Status = ImTextureStatus_WantUpdates;
+                texture->SetStatus(ImTextureStatus_OK);
+            }
+        }
+    }
+
+    state.textureList.resize(0);
+    for(std::size_t i = 0; i != state.textureRequestCount; ++i)
+        state.textureList.push_back(&state.textureRequests[i]->texture);
+    #endif
+
+    /* Copy the draw lists, reusing the memory from previous frames */
+    ImDrawData& out = state.drawData;
+    out.Clear();
+    out.Valid = drawData->Valid;
+    out.CmdListsCount = drawData->CmdListsCount;
+    out.TotalIdxCount = drawData->TotalIdxCount;
+    out.TotalVtxCount = drawData->TotalVtxCount;
+    out.DisplayPos = drawData->DisplayPos;
+    out.DisplaySize = drawData->DisplaySize;
+    out.FramebufferScale = drawData->FramebufferScale;
+    #ifdef IMGUI_HAS_TEXTURES
+    if(state.textureRequestCount)
+        out.Textures = &state.textureList;
+    #endif
+    for(std::int_fast32_t n = 0; n < drawData->CmdLists.Size; ++n) {
+        if(std::size_t(n) == state.drawLists.size())
+            arrayAppend(state.drawLists, Containers::Pointer<ImDrawList>{InPlaceInit, nullptr});
+        ImDrawList& list = *state.drawLists[n];
+        const ImDrawList& source = *drawData->CmdLists[n];
+        copyVector(list.CmdBuffer, source.CmdBuffer);
+        copyVector(list.IdxBuffer, source.IdxBuffer);
+        copyVector(list.VtxBuffer, source.VtxBuffer);
+        list.Flags = source.Flags;
+        out.CmdLists.push_back(&list);
+
+        /* Resolve textures referenced by the commands, as the ImGui textures
+           can't be accessed from draw(). Textures created by a snapshot that
+           isn't drawn yet are taken from the texture requests. */
+        #ifdef IMGUI_HAS_TEXTURES
+        for(ImDrawCmd& cmd: list.CmdBuffer) {
+            ImTextureData* const texture = cmd.TexRef._TexData;
+            if(!texture) continue;
+
+            ImTextureData* replacement = nullptr;
+            for(std::size_t i = 0; i != state.textureRequestCount; ++i) {
+                const SnapshotTextureRequest& request = *state.textureRequests[i];
+                if(request.source == texture) {
+                    replacement = &request.texture;
                     break;
                 }
-                case ImTextureStatus_WantDestroy:
-                    destroyTexture(*tex);
+            }
+            if(replacement) {
+                cmd.TexRef._TexData = replacement;
+            } else {
+                cmd.TexRef._TexID = texture->GetTexID();
+                cmd.TexRef._TexData = nullptr;
+            }
+        }
+        #endif
+    }
+
+    updateAllocationStatistics();
+
+    return snapshot;
+}
+
+void Context::updateAllocationStatistics() {
+    if(const Allocator* const allocator = Allocator::current()) {
+        _frameStatistics.allocationCount = UnsignedInt(allocator->statistics().allocationCount - _frameAllocationCount);
+        _frameStatistics.allocatedBytes = allocator->statistics().allocatedBytes - _frameAllocatedBytes;
+    }
+}
+
+void Context::draw(DrawDataSnapshot& snapshot) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    DrawDataSnapshot::State& state = *snapshot._state;
+
+    /* Uploads to textures created by an earlier snapshot need the ID that
+       draw() of the earlier snapshot produced. If it didn't, skip them. */
+    #ifdef IMGUI_HAS_TEXTURES
+    for(std::size_t i = 0; i != state.textureRequestCount; ++i) {
+        SnapshotTextureRequest& request = *state.textureRequests[i];
+        if(!request.record || request.texture.Status != ImTextureStatus_WantUpdates)
+            continue;
+        if(request.record->id != ImTextureID_Invalid)
+            request.texture.SetTexID(request.record->id);
+        else
+            request.texture.Status = ImTextureStatus_OK;
+    }
+    #endif
+
+    submitDrawData(state.drawData);
+
+    /* Remember IDs of created textures for render() and the next snapshot */
+    #ifdef IMGUI_HAS_TEXTURES
+    for(std::size_t i = 0; i != state.textureRequestCount; ++i) {
+        SnapshotTextureRequest& request = *state.textureRequests[i];
+        if(request.record && request.record->createFrame == state.frame)
+            request.record->id = request.texture.GetTexID();
+    }
+    #endif
+
+    /* Not touching _frameStatistics here, render() picks these up once it
+       reuses the snapshot */
+    state.statistics = _drawStatistics;
+    state.statistics.drawFrameDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Context::replay(DrawDataRecording& recording, const std::size_t frame) {
+    CORRADE_ASSERT(frame < recording.frameCount(),
+        "ImGuiIntegration::Context::replay(): frame" << frame << "out of range for" << recording.frameCount() << "frames", );
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    /* There's no newFrame() between replayed frames, reset the statistics
+       the same way it does */
+    const UnsignedLong gpuDuration = _frameStatistics.gpuDuration;
+    _frameStatistics = {};
+    _frameStatistics.gpuDuration = gpuDuration;
+
+    /* On ImGui before 1.92 all draws use the font atlas, on newer versions
+       the recording picks its own fallback */
+    #if !defined(IMGUI_HAS_TEXTURES)
+    const UnsignedLong fallbackTexture = _texture.id();
+    #else
+    const UnsignedLong fallbackTexture = 0;
+    #endif
+    submitDrawData(recording.prepareFrame(frame, fallbackTexture));
+    combineDrawStatistics(_frameStatistics, _drawStatistics);
+
+    _frameStatistics.drawFrameDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Context::submitDrawData(ImDrawData& drawData) {
+    /* The GPU duration is the most recent available, keep it */
+    const UnsignedLong gpuDuration = _drawStatistics.gpuDuration;
+    _drawStatistics = {};
+    _drawStatistics.gpuDuration = gpuDuration;
+
+    _drawStatistics.drawListCount = drawData.CmdLists.Size;
+    for(std::int_fast32_t n = 0; n < drawData.CmdLists.Size; ++n)
+        _drawStatistics.drawCommandCount += drawData.CmdLists[n]->CmdBuffer.Size;
+
+    if(Vector2{drawData.DisplaySize}.product()) {
+        /* Texture request statuses and IDs get changed by the submission, so
+           the recorder has to look at them before */
+        if(_recorder) _recorder->beginFrame(drawData);
+
+        if(!(_flags & Flag::GpuTiming)) {
+            renderDrawData(drawData);
+
+        /* Read the result of the query issued the longest time ago, if it's
+           available, and reuse it for this frame */
+        } else {
+            if(!_gpuTiming)
+                _gpuTiming.emplace();
+            GpuTiming& timing = *_gpuTiming;
+            GL::TimeQuery& query = timing.queries[timing.currentQuery];
+            if(timing.used[timing.currentQuery] && query.resultAvailable())
+                _drawStatistics.gpuDuration = query.result<UnsignedLong>();
+
+            query.begin();
+            renderDrawData(drawData);
+            query.end();
+
+            timing.used[timing.currentQuery] = true;
+            timing.currentQuery = (timing.currentQuery + 1) % GpuTiming::QueryCount;
+        }
+
+        if(_recorder) _recorder->endFrame(drawData);
+    }
+}
+
+void Context::renderDrawData(ImDrawData& drawData) {
+    const Vector2 displaySize{drawData.DisplaySize};
+
+    /* Turn the draw data into texture operations and draw batches. Without
+       base vertex support the draw lists get uploaded one by one, see
+       drawLists() for details. The support is remembered in the constructor
+       instead of checking ImGuiIO here, as draw() and replay() don't call any
+       ImGui APIs. */
+    if(!_commandList)
+        _commandList.emplace();
+    _commandList->setFlags(CommandList::Flag::ScissorYUp|
+        (_baseVertexSupported ?
+            CommandList::Flag::CombinedBuffers : CommandList::Flags{}));
+    _commandList->build(drawData);
+
+    /* Remembered for the cached layer, which has to be drawn again if any
+       texture changes */
+    bool texturesChanged = false;
+    #ifdef IMGUI_HAS_TEXTURES
+    if(drawData.Textures) {
+        const std::chrono::steady_clock::time_point textureStart = std::chrono::steady_clock::now();
+        #ifndef MAGNUM_TARGET_GLES
+        Implementation::PixelUnpackBuffer* const pixelUnpackBuffer = _pixelUnpackBuffer.get();
+        #else
+        Implementation::PixelUnpackBuffer* const pixelUnpackBuffer = nullptr;
+        #endif
+
+        for(const CommandListTexture& texture: _commandList->textures()) {
+            switch(texture.operation) {
+                case CommandListTextureOperation::Create:
+                    _drawStatistics.textureUploadedBytes += createTexture(*texture.texture, pixelUnpackBuffer);
+                    ++_drawStatistics.textureCreateCount;
                     break;
-                case ImTextureStatus_OK:
-                case ImTextureStatus_Destroyed:
-                    /* Nothing to do */
+                case CommandListTextureOperation::Update:
+                    _drawStatistics.textureUploadedBytes += updateTexture(*texture.texture, _commandList->textureRegions().sliceSize(texture.regionOffset, texture.regionCount), pixelUnpackBuffer);
+                    ++_drawStatistics.textureUpdateCount;
+                    break;
+                case CommandListTextureOperation::Destroy:
+                    destroyTexture(*texture.texture);
+                    ++_drawStatistics.textureDestroyCount;
                     break;
             }
+            texturesChanged = true;
         }
+        _drawStatistics.textureUploadDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - textureStart).count();
     }
     #endif
 
+    /* If the shader is still compiling, skip drawing. The textures are
+       processed above already so ImGui doesn't attempt to create them again
+       next frame. */
+    if(!_resources->isReady())
+        return;
+
+    /* Used by both drawLists() and compositing of the cached layer */
     const Matrix3 projection =
         Matrix3::translation({-1.0f, 1.0f})*
         Matrix3::scaling(2.0f/displaySize)*
         Matrix3::scaling({1.0f, -1.0f});
-    _shader.setTransformationProjectionMatrix(projection);
+    _resources->shader().setTransformationProjectionMatrix(projection);
 
-    for(std::int_fast32_t n = 0; n < drawData->CmdLists.Size; ++n) {
-        const ImDrawList* cmdList = drawData->CmdLists[n];
+    if(!(_flags & Flag::CachedLayer)) {
+        drawLists(drawData);
+        return;
+    }
 
-        _vertexBuffer.setData(
-            {cmdList->VtxBuffer.Data, std::size_t(cmdList->VtxBuffer.Size)},
-            GL::BufferUsage::StreamDraw);
-        _indexBuffer.setData(
-            {cmdList->IdxBuffer.Data, std::size_t(cmdList->IdxBuffer.Size)},
-            GL::BufferUsage::StreamDraw);
+    if(!_cachedLayer)
+        _cachedLayer.emplace();
+    CachedLayer& layer = *_cachedLayer;
+    if(texturesChanged)
+        layer.dirty = true;
+
+    /* Gather everything that affects the rendered output into a signature
+       that's compared with the one the layer was rendered from. Vertex and
+       index data are copied as a whole, from the commands only the fields
+       used by drawLists() are taken. */
+    const Vector2 fbScale{drawData.FramebufferScale};
+    arrayRemoveSuffix(layer.nextSignature, layer.nextSignature.size());
+    layer.append(&displaySize, sizeof(Vector2));
+    layer.append(&fbScale, sizeof(Vector2));
+    bool hasCallbacks = false;
+    for(std::int_fast32_t n = 0; n < drawData.CmdLists.Size && !hasCallbacks; ++n) {
+        const ImDrawList* cmdList = drawData.CmdLists[n];
+        const UnsignedInt counts[]{
+            UnsignedInt(cmdList->VtxBuffer.Size),
+            UnsignedInt(cmdList->IdxBuffer.Size),
+            UnsignedInt(cmdList->CmdBuffer.Size)};
+        layer.append(counts, sizeof(counts));
+        layer.append(cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Size*sizeof(ImDrawVert));
+        layer.append(cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Size*sizeof(ImDrawIdx));
 
         for(std::int_fast32_t c = 0; c < cmdList->CmdBuffer.Size; ++c) {
-            const ImDrawCmd* pcmd = &cmdList->CmdBuffer[c];
-
-            if(pcmd->UserCallback) {
-                /* User callback, registered via ImDrawList::AddCallback().
-                   ImDrawCallback_ResetRenderState is a special callback value
-                   in older versions used by the user to request the renderer
-                   to reset render state, which shouldn't actually be called.
-                   Newer versions allow setting callbacks in ImGuiPlatformIO,
-                   those are callable or null and don't need an extra check. */
-                #if IMGUI_VERSION_NUM < 19280
-                if(pcmd->UserCallback != ImDrawCallback_ResetRenderState)
-                #endif
-                    pcmd->UserCallback(cmdList, pcmd);
-                continue;
+            const ImDrawCmd& cmd = cmdList->CmdBuffer[c];
+            if(cmd.UserCallback) {
+                hasCallbacks = true;
+                break;
             }
 
-            GL::Renderer::setScissor(Range2Di{Range2D{
-                {pcmd->ClipRect.x, displaySize.y() - pcmd->ClipRect.w},
-                {pcmd->ClipRect.z, displaySize.y() - pcmd->ClipRect.y}}
-                    .scaled(fbScale)});
+            const ImTextureID texture = cmd.GetTexID();
+            const UnsignedInt offsets[]{cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount};
+            layer.append(&cmd.ClipRect, sizeof(ImVec4));
+            layer.append(&texture, sizeof(ImTextureID));
+            layer.append(offsets, sizeof(offsets));
+        }
+    }
+
+    /* User callbacks can draw arbitrary content, so such frames are drawn
+       directly. The layer then gets drawn again once there are no callbacks
+       anymore. */
+    if(hasCallbacks) {
+        layer.dirty = true;
+        drawLists(drawData);
+        return;
+    }
+
+    const Range2Di framebufferRect{Range2D{{}, displaySize}.scaled(fbScale)};
+    if(layer.size != framebufferRect.size()) {
+        layer.size = framebufferRect.size();
+        layer.texture = GL::Texture2D{};
+        layer.texture
+            .setMinificationFilter(GL::SamplerFilter::Nearest)
+            .setMagnificationFilter(GL::SamplerFilter::Nearest)
+            .setWrapping(GL::SamplerWrapping::ClampToEdge)
+            #ifndef MAGNUM_TARGET_GLES2
+            .setStorage(1, GL::TextureFormat::RGBA8, layer.size)
+            #else
+            .setImage(0, GL::TextureFormat::RGBA, ImageView2D{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte, layer.size})
+            #endif
+            ;
+        layer.framebuffer = GL::Framebuffer{{{}, layer.size}};
+        layer.framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, layer.texture, 0);
+        layer.dirty = true;
+    }
+
+    /* Render the layer again only if something changed */
+    if(layer.dirty || layer.signature.size() != layer.nextSignature.size() || std::memcmp(layer.signature.data(), layer.nextSignature.data(), layer.signature.size()) != 0) {
+        Utility::swap(layer.signature, layer.nextSignature);
+        layer.dirty = false;
+
+        /* Quad covering the whole UI, in the same coordinate system as the
+           ImGui vertices. The texture is rendered Y up. */
+        ImDrawVert vertices[4];
+        for(std::size_t i = 0; i != 4; ++i) {
+            const Vector2 corner{Float(i/2), Float(i%2)};
+            vertices[i].pos = ImVec2(corner*displaySize);
+            vertices[i].uv = ImVec2(Vector2{corner.x(), 1.0f - corner.y()});
+            vertices[i].col = IM_COL32_WHITE;
+        }
+        layer.vertexBuffer.setData(vertices, GL::BufferUsage::StaticDraw);
+
+        /* Remember the framebuffer and viewport to composite to */
+        GLint previousFramebuffer;
+        GLint previousViewport[4];
+        #ifndef MAGNUM_TARGET_GLES2
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        #else
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        #endif
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+        /* Clear the whole layer to transparent. On ES2 there's no way to
+           clear with a color other than the global one, restore it after. */
+        layer.framebuffer.bind();
+        GL::Renderer::setScissor(framebufferRect);
+        #ifndef MAGNUM_TARGET_GLES2
+        layer.framebuffer.clearColor(0, Color4{0.0f, 0.0f});
+        #else
+        GLfloat previousClearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+        GL::Renderer::setClearColor(Color4{0.0f, 0.0f});
+        layer.framebuffer.clear(GL::FramebufferClear::Color);
+        GL::Renderer::setClearColor(Color4::from(previousClearColor));
+        #endif
+
+        /* Blend the alpha channel so the layer ends up with premultiplied
+           alpha */
+        GL::Renderer::setBlendFunction(
+            GL::Renderer::BlendFunction::SourceAlpha,
+            GL::Renderer::BlendFunction::OneMinusSourceAlpha,
+            GL::Renderer::BlendFunction::One,
+            GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+        drawLists(drawData);
+
+        GL::Framebuffer::wrap(GLuint(previousFramebuffer), Range2Di::fromSize(
+            {previousViewport[0], previousViewport[1]},
+            {previousViewport[2], previousViewport[3]})).bind();
+    }
+
+    /* Composite the premultiplied layer and reset the blend function back to
+       what's recommended in the docs. The scissor rectangle is left at the
+       full framebuffer size, same as in drawLists(). */
+    GL::Renderer::setScissor(framebufferRect);
+    GL::Renderer::setBlendFunction(
+        GL::Renderer::BlendFunction::One,
+        GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+    _resources->shader().bindTexture(layer.texture)
+        .draw(layer.mesh);
+    ++_drawStatistics.drawCallCount;
+    GL::Renderer::setBlendFunction(
+        GL::Renderer::BlendFunction::SourceAlpha,
+        GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+}
+
+void Context::drawLists(const ImDrawData& drawData) {
+    const GL::MeshIndexType indexType = sizeof(ImDrawIdx) == 2 ?
+        GL::MeshIndexType::UnsignedShort : GL::MeshIndexType::UnsignedInt;
+
+    /* If base vertex is supported, the command list is built for all draw
+       lists copied into a single contiguous allocation, which is uploaded to
+       the GPU at once, instead of reallocating the buffer storage for every
+       draw list. Without base vertex support the indices would need to be
+       patched for every draw list after the first, so there the draw lists
+       get uploaded one by one. */
+    const bool uploadAtOnce = !!(_commandList->flags() & CommandList::Flag::CombinedBuffers);
+    /* Mesh to draw with and base vertex of the data uploaded for this frame.
+       The base vertex is non-zero only when streaming through the ring
+       buffer. */
+    GL::Mesh* mesh = &_mesh;
+    UnsignedInt frameBaseVertex = 0;
+    if(uploadAtOnce) {
+        const std::size_t vertexDataSize = _commandList->vertexCount()*sizeof(ImDrawVert);
+        const std::size_t indexDataOffset = _commandList->indexDataOffset();
+        const std::size_t dataSize = _commandList->bufferDataSize();
+
+        /* Copy either directly to the persistently mapped ring buffer region
+           for this frame or to the staging memory. The staging memory is
+           grown only if it's not large enough, it's reused in subsequent
+           frames. */
+        Containers::ArrayView<char> storage;
+        #ifndef MAGNUM_TARGET_GLES
+        if(_streamingRing)
+            storage = _streamingRing->nextRegion(dataSize);
+        else
+        #endif
+        {
+            if(_drawStorage.size() < dataSize)
+                _drawStorage = Containers::Array<char>{NoInit, dataSize};
+            storage = _drawStorage;
+        }
+        _commandList->copyBufferData(drawData, storage);
+
+        _drawStatistics.vertexCount += _commandList->vertexCount();
+        _drawStatistics.indexCount += _commandList->indexCount();
+        _drawStatistics.uploadedBytes += vertexDataSize + dataSize - indexDataOffset;
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(_streamingRing) {
+            /* The region offset is a multiple of both the vertex and index
+               size, so it can be expressed with a base vertex and an index
+               buffer offset */
+            const std::size_t regionOffset = _streamingRing->regionOffset();
+            frameBaseVertex = regionOffset/sizeof(ImDrawVert);
+            mesh = &_streamingRing->mesh;
+            mesh->setIndexBuffer(_streamingRing->buffer, regionOffset + indexDataOffset, indexType);
+        } else
+        #endif
+        {
+            _vertexBuffer.setData(_drawStorage.prefix(vertexDataSize),
+                GL::BufferUsage::StreamDraw);
+            _indexBuffer.setData(_drawStorage.slice(indexDataOffset, dataSize),
+                GL::BufferUsage::StreamDraw);
+            _mesh.setIndexBuffer(_indexBuffer, 0, indexType);
+        }
+    }
 
-            /* Only > 0 if ImGuiBackendFlags_RendererHasVtxOffset is set */
-            _mesh.setBaseVertex(pcmd->VtxOffset);
-            _mesh.setCount(pcmd->ElemCount);
-            _mesh.setIndexBuffer(_indexBuffer, pcmd->IdxOffset*sizeof(ImDrawIdx),
-                sizeof(ImDrawIdx) == 2
-                ? GL::MeshIndexType::UnsignedShort
-                : GL::MeshIndexType::UnsignedInt);
+    /* Each batch is submitted as a single draw, or as a multi-draw if it
+       consists of more than one index range. The texture and scissor
+       rectangle currently set in GL are remembered to avoid redundant state
+       changes, and are forgotten after every user callback as it can change
+       arbitrary state. */
+    ImTextureID currentTexture{};
+    Range2Di currentScissor;
+    bool currentStateValid = false;
+    /* Draw list currently in the buffers if they're uploaded one by one */
+    std::int_fast32_t uploadedDrawList = -1;
+    Shaders::FlatGL2D& shader = _resources->shader();
+    const Containers::ArrayView<const CommandListDraw> draws = _commandList->draws();
+    for(const CommandListBatch& batch: _commandList->batches()) {
+        const ImDrawList* cmdList = drawData.CmdLists[batch.drawList];
+
+        if(batch.callback) {
+            /* User callback, registered via ImDrawList::AddCallback().
+               ImDrawCallback_ResetRenderState is a special callback value in
+               older versions used by the user to request the renderer to
+               reset render state, which shouldn't actually be called. Newer
+               versions allow setting callbacks in ImGuiPlatformIO, those are
+               callable or null and don't need an extra check. */
+            #if IMGUI_VERSION_NUM < 19280
+            if(batch.callback->UserCallback != ImDrawCallback_ResetRenderState)
+            #endif
+                batch.callback->UserCallback(cmdList, batch.callback);
+            currentStateValid = false;
+            continue;
+        }
 
+        if(!uploadAtOnce && std::int_fast32_t(batch.drawList) != uploadedDrawList) {
+            _vertexBuffer.setData(
+                {cmdList->VtxBuffer.Data, std::size_t(cmdList->VtxBuffer.Size)},
+                GL::BufferUsage::StreamDraw);
+            _indexBuffer.setData(
+                {cmdList->IdxBuffer.Data, std::size_t(cmdList->IdxBuffer.Size)},
+                GL::BufferUsage::StreamDraw);
+            _mesh.setIndexBuffer(_indexBuffer, 0, indexType);
+            uploadedDrawList = batch.drawList;
+
+            _drawStatistics.vertexCount += cmdList->VtxBuffer.Size;
+            _drawStatistics.indexCount += cmdList->IdxBuffer.Size;
+            _drawStatistics.uploadedBytes += cmdList->VtxBuffer.Size*sizeof(ImDrawVert) + cmdList->IdxBuffer.Size*sizeof(ImDrawIdx);
+        }
+
+        if(!currentStateValid || currentScissor != batch.scissor) {
+            GL::Renderer::setScissor(batch.scissor);
+            currentScissor = batch.scissor;
+        }
+
+        /* The IDs are resolved only now as the textures are created after
+           the command list is built */
+        #ifdef IMGUI_HAS_TEXTURES
+        const ImTextureID texture = batch.texture.GetTexID();
+        #else
+        const ImTextureID texture = batch.texture;
+        #endif
+        if(!currentStateValid || currentTexture != texture) {
             /* We're storing just texture IDs, so make a non-owning instance
                around it, and assume it's already created */
-            GL::Texture2D texture = GL::Texture2D::wrap(
+            GL::Texture2D glTexture = GL::Texture2D::wrap(
                 #if IMGUI_VERSION_NUM >= 19131
-                pcmd->GetTexID(),
+                texture,
                 #else
-                reinterpret_cast<std::uintptr_t>(pcmd->GetTexID()),
+                reinterpret_cast<std::uintptr_t>(texture),
                 #endif
                 GL::ObjectFlag::Created);
-
-            _shader
-                .bindTexture(texture)
-                .draw(_mesh);
+            shader.bindTexture(glTexture);
+            currentTexture = texture;
         }
+
+        currentStateValid = true;
+
+        for(const CommandListDraw& draw: draws.sliceSize(batch.drawOffset, batch.drawCount))
+            arrayAppend(_drawViews, InPlaceInit, *mesh)
+                .setCount(draw.indexCount)
+                .setIndexOffset(draw.indexOffset)
+                .setBaseVertex(frameBaseVertex + draw.baseVertex);
+        if(_drawViews.size() == 1)
+            shader.draw(_drawViews.front());
+        else
+            shader.draw(Containers::arrayView(_drawViews));
+        ++_drawStatistics.drawCallCount;
+
+        /* Keeps the capacity for the next batch */
+        arrayRemoveSuffix(_drawViews, _drawViews.size());
     }
 
+    /* Mark the ring buffer region as used until the GPU is done drawing from
+       it */
+    #ifndef MAGNUM_TARGET_GLES
+    if(_streamingRing && uploadAtOnce)
+        _streamingRing->fence();
+    #endif
+
     /* Reset scissor rectangle back to the full framebuffer size. Instead the
        users would be required to disable the scissor right after as otherwise
        the framebuffer clear would only happen on whatever the last scissor
        was. (And I hope the floating-point precision is enough here.) */
-    GL::Renderer::setScissor(Range2Di{Range2D{{}, displaySize}.scaled(fbScale)});
+    GL::Renderer::setScissor(_commandList->framebufferRect());
 }
 
 }}
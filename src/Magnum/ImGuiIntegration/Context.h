@@ -33,18 +33,25 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::ImGuiIntegration::Context
+ * @brief Class @ref Magnum::ImGuiIntegration::Context, @ref Magnum::ImGuiIntegration::DrawDataSnapshot, struct @ref Magnum::ImGuiIntegration::FrameStatistics, enum set @ref Magnum::ImGuiIntegration::Context::Flags
  */
 
+#include <initializer_list>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/String.h>
 #include <Magnum/Timeline.h>
 #include <Magnum/GL/AbstractShaderProgram.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/MeshView.h>
 #include <Magnum/Shaders/FlatGL.h>
 
 #include "Magnum/ImGuiIntegration/visibility.h"
+#include "Magnum/ImGuiIntegration/SharedResources.h"
 
 /* On non-deprecated builds we need to check IMGUI_HAS_TEXTURES to know whether
    to remove atlasTexture() */
@@ -54,14 +61,189 @@
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 struct ImGuiContext;
+struct ImDrawData;
+struct ImFont;
 #endif
 
 namespace Magnum { namespace ImGuiIntegration {
 
 namespace Implementation {
     template<class Application, class = void> struct ApplicationClipboard;
+    struct PixelUnpackBuffer;
 }
 
+class Context;
+class CommandList;
+class DrawDataRecorder;
+class DrawDataRecording;
+
+/**
+@brief Frame statistics
+@m_since_latest_{integration}
+
+@see @ref Context::frameStatistics(),
+    @ref ImGuiIntegration-Context-statistics
+*/
+struct FrameStatistics {
+    /** @brief Count of ImGui draw lists */
+    UnsignedInt drawListCount;
+
+    /**
+     * @brief Count of ImGui draw commands
+     *
+     * Including user callbacks.
+     */
+    UnsignedInt drawCommandCount;
+
+    /**
+     * @brief Count of draw calls issued
+     *
+     * A multi-draw counts as a single draw call. If
+     * @ref Context::Flag::CachedLayer is enabled, includes the draw call
+     * compositing the layer.
+     */
+    UnsignedInt drawCallCount;
+
+    /** @brief Count of vertices uploaded to the GPU */
+    UnsignedInt vertexCount;
+
+    /** @brief Count of indices uploaded to the GPU */
+    UnsignedInt indexCount;
+
+    /** @brief Size of vertex and index data uploaded to the GPU in bytes */
+    UnsignedLong uploadedBytes;
+
+    /**
+     * @brief Count of created textures
+     *
+     * Only ImGui 1.92 and newer manages textures dynamically, on older
+     * versions the texture counts are always zero.
+     */
+    UnsignedInt textureCreateCount;
+
+    /** @brief Count of updated textures */
+    UnsignedInt textureUpdateCount;
+
+    /** @brief Count of destroyed textures */
+    UnsignedInt textureDestroyCount;
+
+    /** @brief Size of texture data uploaded to the GPU in bytes */
+    UnsignedLong textureUploadedBytes;
+
+    /**
+     * @brief CPU time spent creating, updating and destroying textures in nanoseconds
+     *
+     * Part of @ref drawFrameDuration. On desktop GL the texture data are
+     * staged through a pixel buffer object, so this is mostly just the time
+     * needed to copy the data, the actual transfer happens asynchronously.
+     */
+    UnsignedLong textureUploadDuration;
+
+    /** @brief CPU time spent in @ref Context::newFrame() in nanoseconds */
+    UnsignedLong newFrameDuration;
+
+    /**
+     * @brief CPU time spent in @ref Context::drawFrame() in nanoseconds
+     *
+     * Includes @ref renderDuration. If @ref Context::render() and
+     * @ref Context::draw() are used instead, it's the time spent in
+     * @ref Context::draw().
+     */
+    UnsignedLong drawFrameDuration;
+
+    /**
+     * @brief CPU time spent in @cpp ImGui::Render() @ce in nanoseconds
+     *
+     * Called from @ref Context::drawFrame() or @ref Context::render() to
+     * produce the draw data.
+     */
+    UnsignedLong renderDuration;
+
+    /**
+     * @brief GPU time spent in @ref Context::drawFrame() in nanoseconds
+     *
+     * The most recent available measurement, which is usually three frames
+     * old. Zero if @ref Context::Flag::GpuTiming isn't enabled or no result
+     * is available yet.
+     */
+    UnsignedLong gpuDuration;
+
+    /**
+     * @brief Count of ImGui allocations
+     *
+     * Done between the start of @ref Context::newFrame() and the end of
+     * @ref Context::drawFrame() or @ref Context::render(), including
+     * allocations done by other contexts in the meantime. Zero if no
+     * @ref Allocator is installed.
+     */
+    UnsignedInt allocationCount;
+
+    /**
+     * @brief Size of ImGui allocations in bytes
+     *
+     * Same as @ref allocationCount, zero if no @ref Allocator is installed.
+     */
+    UnsignedLong allocatedBytes;
+};
+
+/**
+@brief Draw data snapshot
+@m_since_latest_{integration}
+
+An owned copy of ImGui draw data produced by @ref Context::render() and drawn
+with @ref Context::draw(). The @ref Context has two of them that are used in
+an alternating fashion and keep their memory between frames, so after the
+first few frames the copy doesn't need to allocate anything. See
+@ref ImGuiIntegration-Context-snapshots for more information.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT DrawDataSnapshot {
+    public:
+        /** @brief Copying is not allowed */
+        DrawDataSnapshot(const DrawDataSnapshot&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * The snapshots are owned by @ref Context and referenced from it.
+         */
+        DrawDataSnapshot(DrawDataSnapshot&&) = delete;
+
+        ~DrawDataSnapshot();
+
+        /** @brief Copying is not allowed */
+        DrawDataSnapshot& operator=(const DrawDataSnapshot&) = delete;
+
+        /** @brief Moving is not allowed */
+        DrawDataSnapshot& operator=(DrawDataSnapshot&&) = delete;
+
+        /**
+         * @brief Frame index
+         *
+         * Count of @ref Context::render() calls up to and including the one
+         * that produced this snapshot.
+         */
+        UnsignedLong frame() const;
+
+        /**
+         * @brief Draw data
+         *
+         * Draw lists in the snapshot are copies of the original ones. On
+         * ImGui 1.92 and newer the texture references in draw commands are
+         * resolved to texture IDs or to textures owned by the snapshot, so
+         * they don't point to ImGui-owned @cpp ImTextureData @ce anymore.
+         */
+        const ImDrawData& drawData() const;
+
+    private:
+        friend Context;
+
+        struct State;
+
+        explicit DrawDataSnapshot();
+
+        Containers::Pointer<State> _state;
+};
+
 /**
 @brief Dear ImGui context
 
@@ -100,11 +282,13 @@ setting cursors.
 @m_class{m-note m-warning}
 
 @par
-    As shown above, because Dear ImGui has frame-based event handling, you're
-    * *required* to constantly @ref Platform::Sdl2Application::redraw() "redraw()",
-    instead of just waiting on input events. While that's not a problem for
-    games, for regular apps that unfortunately means your application will use
-    the CPU even when completely idle.
+    As shown above, because Dear ImGui has frame-based event handling, the
+    simplest way is to constantly
+    @ref Platform::Sdl2Application::redraw() "redraw()", instead of just
+    waiting on input events. While that's not a problem for games, for regular
+    apps that means your application will use the CPU even when completely
+    idle. See @ref ImGuiIntegration-Context-usage-on-demand below for how to
+    redraw only when needed.
 
 <b></b>
 
@@ -118,6 +302,21 @@ setting cursors.
 @par
     @snippet ImGuiIntegration.cpp Context-usage-state-imgui-only
 
+@subsection ImGuiIntegration-Context-usage-on-demand Redrawing on demand
+
+Instead of redrawing constantly, @ref wantsRedraw() tells whether ImGui needs
+another frame, for example because an input event arrived, a button is held or
+a tooltip is about to appear. A text input additionally needs to be redrawn
+periodically for the blinking cursor, with @ref nextRedrawDeadline() telling
+when. Checking in a @ref Platform::Sdl2Application::tickEvent() "tickEvent()"
+covers both the input events and the deadline, with @ref Platform::Sdl2Application::setMinimalLoopPeriod() "setMinimalLoopPeriod()"
+limiting how often the main loop checks when idle:
+
+@snippet ImGuiIntegration-sdl2.cpp Context-usage-on-demand
+
+If the application has animations of its own or draws anything else that
+changes over time, it has to schedule the redraws for these itself.
+
 @subsection ImGuiIntegration-Context-usage-events Event handling
 
 The templated @ref handleMousePressEvent(), @ref handleMouseReleaseEvent() etc.
@@ -139,6 +338,22 @@ thus it shouldn't be propagated further) and @cpp false @ce otherwise.
     order to optimize compile times, as the event handling implementation is
     rather large. See @ref compilation-speedup-hpp for more information.
 
+@subsection ImGuiIntegration-Context-usage-events-coalescing Coalescing pointer events
+
+High-frequency input devices such as gaming mice can produce a thousand or more
+pointer move events every second. ImGui processes its input queue in order and
+with @cpp ImGuiIO::ConfigInputTrickleEventQueue @ce enabled only part of it
+each frame, so many events can fill the queue and delay reaction to others.
+Enabling @ref Flag::CoalesceEvents through @ref setFlags() makes
+@ref handlePointerMoveEvent() and @ref handleScrollEvent() only remember the
+latest pointer position and sum the scroll offsets, which are then passed to
+ImGui in the next @ref newFrame(). Events that change the set of pressed
+pointer buttons, key and text input events pass the merged events to ImGui
+first, so their order relative to pointer movement is preserved. The merged
+events are also passed to ImGui first if the pointer moves while scroll
+offsets are merged, or if the pointer source changes, for example from a
+mouse to a pen.
+
 @subsection ImGuiIntegration-Context-usage-text-input Text input
 
 UTF-8 text input is handled via @ref handleTextInputEvent() but the application
@@ -235,6 +450,15 @@ with window size. When window size, framebuffer size or DPI scaling changes
 call @ref relayout() with the new values. If the pixel density is changed, this
 will result in the font caches being rebuilt.
 
+With Dear ImGui versions before 1.92 and the builtin font, the atlases built
+for previously used pixel densities are kept around, so for example moving a
+window between a regular and a HiDPI monitor doesn't rasterize and upload the
+font again on every crossing. By default up to three atlases including the
+currently used one are kept, use @ref setResidentFontAtlasCount() to change
+that. This is implemented for Dear ImGui 1.90 and 1.91 only, custom fonts are
+always rebuilt. With 1.92 and newer, glyphs for all used pixel densities are
+kept in a single dynamically updated atlas.
+
 @m_class{m-note m-warning}
 
 @par
@@ -306,6 +530,120 @@ change ImGui's index type to 32-bit by adding the following line to the
 This doubles the size of the index buffer, resulting in potentially reduced
 draw performance, but is guaranteed to work on all GL versions.
 
+Base vertex support additionally allows @ref drawFrame() to copy vertex and
+index data of all ImGui draw lists into a single staging allocation and upload
+it to the GPU at once, instead of reallocating the buffer storage for each
+draw list separately. Without base vertex support the draw lists are uploaded
+one by one.
+
+On desktop GL, if @gl_extension{ARB,buffer_storage} is supported as well, the
+draw data are instead copied directly into a persistently mapped buffer split
+into three regions that are used in a round-robin fashion. A fence sync
+ensures a region is written to only after the GPU finished drawing from it,
+which avoids buffer storage reallocation altogether. On OpenGL ES and WebGL,
+the above staging upload is used.
+
+@section ImGuiIntegration-Context-cached-layer Cached UI layer
+
+If the UI is drawn on top of content that's redrawn every frame, but the UI
+itself changes only rarely, rasterizing it again every frame is wasteful. By
+enabling @ref Flag::CachedLayer through @ref setFlags(), @ref drawFrame()
+renders the UI into an offscreen texture and composites it onto the currently
+bound framebuffer. The texture is rendered again only if the ImGui vertex,
+index or command data differ from the previous frame, if a texture was
+created, updated or destroyed, if the framebuffer size changed or if
+@ref invalidateCachedLayer() was called. On frames without any change, the
+draw data isn't uploaded to the GPU at all and the only cost is a single
+textured quad.
+
+Since the layer has no way to know when contents of
+@ref ImGuiIntegration-Context-custom-textures "custom textures" change, call
+@ref invalidateCachedLayer() whenever a texture drawn by the UI is updated.
+Frames that contain user callbacks added with @cpp ImDrawList::AddCallback() @ce
+are always drawn directly to the framebuffer, as the callbacks can draw
+arbitrary content.
+
+The layer is rendered with the blend function set to
+@ref GL::Renderer::BlendFunction::SourceAlpha and
+@ref GL::Renderer::BlendFunction::OneMinusSourceAlpha for color and
+@ref GL::Renderer::BlendFunction::One and
+@ref GL::Renderer::BlendFunction::OneMinusSourceAlpha for alpha, resulting in
+premultiplied alpha that's then composited using
+@ref GL::Renderer::BlendFunction::One and
+@ref GL::Renderer::BlendFunction::OneMinusSourceAlpha. Afterwards, the blend
+function is reset back to the one recommended in
+@ref ImGuiIntegration-Context-usage-rendering. Apart from that, the
+framebuffer binding and viewport are preserved.
+
+@section ImGuiIntegration-Context-snapshots Separating UI construction from drawing
+
+The @ref drawFrame() function calls @cpp ImGui::Render() @ce and submits the
+result to the GPU right away. Alternatively, @ref render() makes a
+@ref DrawDataSnapshot of the draw data, which can be passed to @ref draw()
+later, for example from a dedicated render thread, while the UI for the next
+frame is already being built:
+
+@snippet ImGuiIntegration.cpp Context-snapshots
+
+There are two snapshots that are used in an alternating fashion. A snapshot
+returned from @ref render() stays valid until @ref render() is called two more
+times, so @ref draw() for a snapshot has to finish before the next-but-one
+@ref render() call. Every snapshot has to be drawn, as it may carry texture
+updates needed by the snapshots after. The @ref draw() function doesn't call
+any ImGui APIs except for user callbacks added with
+@cpp ImDrawList::AddCallback() @ce, which then have to be safe to call from
+the render thread. It doesn't update @ref frameStatistics() either, the draw
+statistics of a snapshot are included in them by the @ref render() call that
+reuses the snapshot, i.e. two @ref render() calls later.
+
+On ImGui 1.92 and newer, texture requests are copied into the snapshot as
+well, including the affected pixel data, and are executed by @ref draw().
+As the GPU texture is created only when @ref draw() is called, the ImGui
+texture gets its ID two @ref render() calls later. Until then, the texture
+data are uploaded again with every snapshot in order to include glyphs that
+got rasterized in the meantime.
+
+@section ImGuiIntegration-Context-recording Recording and replaying draw data
+
+Performance issues often reproduce only with real UI layouts of a particular
+application. A @ref DrawDataRecorder set with @ref setRecorder() records the
+draw data of every drawn frame, which can be then saved to a file:
+
+@snippet ImGuiIntegration.cpp DrawDataRecorder
+
+The recording can be then loaded as a @ref DrawDataRecording and drawn with
+@ref replay() without the application, for example in a benchmark comparing
+different @ref Flags:
+
+@snippet ImGuiIntegration.cpp DrawDataRecording
+
+See the @ref DrawDataRecorder and @ref DrawDataRecording documentation for
+what can and can't be replayed.
+
+@section ImGuiIntegration-Context-statistics Frame statistics
+
+After each @ref drawFrame(), @ref frameStatistics() contains the amount of
+ImGui draw lists and draw commands, the number of draw calls that were issued
+after merging draw commands with the same state, and the amount of vertex,
+index and texture data uploaded to the GPU. Together with CPU time spent in
+@ref newFrame() and @ref drawFrame(), and the part of it spent on texture
+uploads, it can be used to track cost of the UI over time:
+
+@snippet ImGuiIntegration.cpp Context-statistics
+
+If @ref Flag::GpuTiming is enabled, the GPU time spent by @ref drawFrame() is
+measured as well. To avoid stalling the pipeline while waiting for the result,
+the measurements are read back with a latency of three frames, and
+@ref FrameStatistics::gpuDuration contains the most recent result that's
+available. Because time elapsed queries can't be nested, the flag can't be
+used while another time elapsed query, such as the one from
+@ref DebugTools::FrameProfilerGL, is active around @ref drawFrame().
+
+If an @ref Allocator is installed, @ref FrameStatistics::allocationCount and
+@relativeref{FrameStatistics,allocatedBytes} contain the count and size of
+ImGui allocations done during the frame, and the allocator itself provides the
+overall memory use.
+
 @section ImGuiIntegration-Context-custom-textures Drawing custom textures
 
 In order to draw a @ref GL::Texture2D instance, use the
@@ -314,6 +652,10 @@ In order to draw a @ref GL::Texture2D instance, use the
 ImGui APIs that accept a `ImTextureID`, use the @ref textureId() helper to
 create an ImGui texture ID from a @ref GL::Texture2D reference.
 
+Each texture used by the UI results in at least one draw call. To draw many
+small images, such as thumbnails, with just a few draw calls, pack them into
+an @ref ImageAtlas.
+
 @section ImGuiIntegration-Context-multiple-contexts Multiple contexts
 
 Each instance of @ref Context creates a new ImGui context. You can also pass an
@@ -325,6 +667,19 @@ destruction). Switching between various @cpp ImGui @ce contexts wrapped in
 functions. You can also query the instance-specific context with @ref context()
 and call @cpp ImGui::SetCurrentContext() @ce manually on that.
 
+Each instance also compiles its own shader by default. If you have many
+contexts, create a @ref SharedResources instance and pass it to the
+@ref Context(SharedResources&, const Vector2&, const Vector2i&, const Vector2i&)
+and related constructors to compile the shader just once.
+
+To avoid a stall on shader compilation at startup, for example when the
+application is already showing a loading screen, create the
+@ref SharedResources using @ref SharedResources::compile() and pass it to the
+context. The shader then compiles in the background if the driver supports it,
+@ref drawFrame() doesn't draw anything until @ref isReady() returns
+@cpp true @ce and all other APIs can be used as usual. See
+@ref ImGuiIntegration-SharedResources-async for more information.
+
 It's also possible to create a context-less instance using the
 @ref Context(NoCreateT) constructor and release context ownership using
 @ref release(). Such instances, together with moved-out instances are empty and
@@ -334,6 +689,51 @@ calling any API that interacts with ImGui is not allowed on these.
 */
 class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
     public:
+        /**
+         * @brief Flag
+         * @m_since_latest_{integration}
+         *
+         * @see @ref Flags, @ref setFlags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Render the UI into an offscreen texture and draw it again only
+             * if it changes. See @ref ImGuiIntegration-Context-cached-layer
+             * for more information.
+             */
+            CachedLayer = 1 << 0,
+
+            /**
+             * Measure GPU time spent in @ref drawFrame() and report it in
+             * @ref FrameStatistics::gpuDuration. See
+             * @ref ImGuiIntegration-Context-statistics for more information.
+             * @requires_gl33 Extension @gl_extension{ARB,timer_query}
+             * @requires_es_extension Extension
+             *      @gl_extension{EXT,disjoint_timer_query}
+             * @requires_webgl_extension Extension
+             *      @webgl_extension{EXT,disjoint_timer_query} on WebGL 1,
+             *      @webgl_extension{EXT,disjoint_timer_query_webgl2} on WebGL
+             *      2
+             */
+            GpuTiming = 1 << 1,
+
+            /**
+             * Merge consecutive pointer move and scroll events between
+             * @ref newFrame() calls instead of passing each of them to
+             * ImGui. See @ref ImGuiIntegration-Context-usage-events-coalescing
+             * for more information.
+             */
+            CoalesceEvents = 1 << 2
+        };
+
+        /**
+         * @brief Flags
+         * @m_since_latest_{integration}
+         *
+         * @see @ref setFlags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
         /**
          * @brief Constructor
          * @param size                  Size of the user interface to which all
@@ -412,6 +812,50 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         explicit Context(ImGuiContext& context, const Vector2i& size);
 
+        /**
+         * @brief Construct with shared resources
+         * @m_since_latest_{integration}
+         *
+         * Equivalent to @ref Context(const Vector2&, const Vector2i&, const Vector2i&),
+         * except that instead of compiling its own shader, the one from
+         * @p resources is used. The @p resources instance is only
+         * referenced, so it's expected to stay in scope for the whole
+         * lifetime of the context. See @ref SharedResources for more
+         * information.
+         */
+        explicit Context(SharedResources& resources, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize);
+
+        /**
+         * @brief Construct with shared resources without DPI awareness
+         * @m_since_latest_{integration}
+         *
+         * Equivalent to calling @ref Context(SharedResources&, const Vector2&, const Vector2i&, const Vector2i&)
+         * with @p size passed to the last three parameters.
+         */
+        explicit Context(SharedResources& resources, const Vector2i& size);
+
+        /**
+         * @brief Construct from an existing context with shared resources
+         * @m_since_latest_{integration}
+         *
+         * Equivalent to @ref Context(ImGuiContext&, const Vector2&, const Vector2i&, const Vector2i&),
+         * except that instead of compiling its own shader, the one from
+         * @p resources is used. The @p resources instance is only
+         * referenced, so it's expected to stay in scope for the whole
+         * lifetime of the context. See @ref SharedResources for more
+         * information.
+         */
+        explicit Context(SharedResources& resources, ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize);
+
+        /**
+         * @brief Construct from an existing context with shared resources without DPI awareness
+         * @m_since_latest_{integration}
+         *
+         * Equivalent to calling @ref Context(SharedResources&, ImGuiContext&, const Vector2&, const Vector2i&, const Vector2i&)
+         * with @p size passed to the last three parameters.
+         */
+        explicit Context(SharedResources& resources, ImGuiContext& context, const Vector2i& size);
+
         /**
          * @brief Construct using application sizes and features
          * @param size                  Size of the user interface to which all
@@ -442,6 +886,28 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         template<class Application> explicit Context(ImGuiContext& context, const Vector2& size, const Application& application);
 
+        /**
+         * @brief Construct with shared resources, using application sizes and features
+         * @m_since_latest_{integration}
+         *
+         * Compared to @ref Context(SharedResources&, const Vector2&, const Vector2i&, const Vector2i&)
+         * this takes window size and framebuffer size from the application
+         * instance and it enables additional features depending on the given
+         * Application capabilities.
+         */
+        template<class Application> explicit Context(SharedResources& resources, const Vector2& size, const Application& application);
+
+        /**
+         * @brief Construct from an existing context with shared resources, using application sizes and features
+         * @m_since_latest_{integration}
+         *
+         * Compared to @ref Context(SharedResources&, ImGuiContext&, const Vector2&, const Vector2i&, const Vector2i&)
+         * this takes window size and framebuffer size from the application
+         * instance and it enables additional features depending on the given
+         * Application capabilities.
+         */
+        template<class Application> explicit Context(SharedResources& resources, ImGuiContext& context, const Vector2& size, const Application& application);
+
         /**
          * @brief Construct without creating the underlying ImGui context
          *
@@ -503,6 +969,14 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          * versions 1.92 and up create and destroy textures dynamically, on
          * those versions this function returns an empty,
          * @ref Magnum::NoCreate "NoCreate"-d texture.
+         *
+         * On ImGui before 1.92 the texture is
+         * @ref GL::TextureFormat::R8 with a @cpp '1', '1', '1', 'r' @ce
+         * swizzle if the atlas has no colored glyphs and the platform
+         * supports single-channel textures with swizzling, which is everywhere
+         * except OpenGL ES 2.0, WebGL and desktop GL without
+         * @gl_extension{ARB,texture_rg} and @gl_extension{ARB,texture_swizzle}.
+         * Otherwise it's @ref GL::TextureFormat::RGBA8.
          */
         #if defined(IMGUI_HAS_TEXTURES)
         CORRADE_DEPRECATED("There is no global font atlas texture in ImGui 1.92 and up")
@@ -510,6 +984,60 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
         GL::Texture2D& atlasTexture() { return _texture; }
         #endif
 
+        /**
+         * @brief Flags
+         * @m_since_latest_{integration}
+         *
+         * By default no flags are set.
+         */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set flags
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Takes effect in the next @ref drawFrame() call. Disabling
+         * @ref Flag::CachedLayer frees the offscreen texture. Enabling
+         * @ref Flag::GpuTiming expects that the corresponding extension is
+         * supported. Disabling @ref Flag::CoalesceEvents passes the events
+         * merged so far to ImGui.
+         */
+        Context& setFlags(Flags flags);
+
+        /**
+         * @brief Invalidate the cached UI layer
+         * @m_since_latest_{integration}
+         *
+         * Makes the next @ref drawFrame() render the UI into the offscreen
+         * texture again even if the draw data didn't change. Useful if
+         * contents of a texture drawn by the UI changed. Has no effect if
+         * @ref Flag::CachedLayer isn't set. See
+         * @ref ImGuiIntegration-Context-cached-layer for more information.
+         */
+        void invalidateCachedLayer();
+
+        /**
+         * @brief Draw data recorder
+         * @m_since_latest_{integration}
+         *
+         * @cpp nullptr @ce by default.
+         */
+        DrawDataRecorder* recorder() const { return _recorder; }
+
+        /**
+         * @brief Set draw data recorder
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Every frame drawn with @ref drawFrame(), @ref draw() or
+         * @ref replay() is recorded into @p recorder until the recorder is
+         * reset back to @cpp nullptr @ce. The recorder is expected to stay
+         * alive for as long as it's set. See
+         * @ref ImGuiIntegration-Context-recording for more information.
+         */
+        Context& setRecorder(DrawDataRecorder* recorder);
+
         /**
          * @brief Relayout the context
          * @param size                  Size of the user interface to which all
@@ -542,6 +1070,91 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         void relayout(const Vector2i& size);
 
+        /**
+         * @brief Rasterize glyphs ahead of time
+         * @param font      Font to rasterize the glyphs from
+         * @param size      Font size, same as passed to
+         *      @cpp ImGui::PushFont() @ce
+         * @param ranges    Inclusive ranges of Unicode codepoints
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * With Dear ImGui 1.92 and newer, glyphs are rasterized and uploaded
+         * to the atlas texture the first time they're drawn, which can cause
+         * a visible hitch when a lot of them appear at once, such as when
+         * switching to a different language or font size. This function queues
+         * given glyphs for rasterization. Each @ref newFrame() then rasterizes
+         * the queued glyphs until the atlas data pending upload reach
+         * @ref glyphPrewarmBudget(), and the subsequent @ref drawFrame()
+         * uploads them along with everything else. The @p font is expected to
+         * stay alive until @ref isPrewarmingGlyphs() returns @cpp false @ce.
+         *
+         * Dear ImGui font atlases aren't thread-safe and glyphs can only be
+         * added to an atlas that's used by the context, so the rasterization
+         * happens on the main thread, spread over as many frames as needed.
+         * On Dear ImGui versions before 1.92 the whole atlas is rasterized
+         * upfront and this function does nothing.
+         */
+        Context& prewarmGlyphs(ImFont& font, Float size, Containers::ArrayView<const Containers::Pair<char32_t, char32_t>> ranges);
+
+        /**
+         * @overload
+         * @m_since_latest_{integration}
+         */
+        Context& prewarmGlyphs(ImFont& font, Float size, std::initializer_list<Containers::Pair<char32_t, char32_t>> ranges);
+
+        /**
+         * @brief Whether there are glyphs queued for rasterization
+         * @m_since_latest_{integration}
+         *
+         * @see @ref prewarmGlyphs()
+         */
+        bool isPrewarmingGlyphs() const { return !_glyphPrewarm.isEmpty(); }
+
+        /**
+         * @brief Per-frame glyph prewarm budget in bytes
+         * @m_since_latest_{integration}
+         *
+         * Default is @cpp 65536 @ce bytes, which is for example 256 glyphs
+         * of 16x16 pixels with an RGBA atlas.
+         * @see @ref prewarmGlyphs()
+         */
+        std::size_t glyphPrewarmBudget() const { return _glyphPrewarmBudget; }
+
+        /**
+         * @brief Set per-frame glyph prewarm budget in bytes
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Rasterization in given frame stops once the size of atlas data
+         * pending upload reaches @p bytes. At least one glyph is rasterized in
+         * each frame, so zero means one glyph per frame.
+         * @see @ref prewarmGlyphs()
+         */
+        Context& setGlyphPrewarmBudget(std::size_t bytes);
+
+        /**
+         * @brief Count of font atlases kept resident
+         * @m_since_latest_{integration}
+         *
+         * Default is @cpp 3 @ce. See @ref ImGuiIntegration-Context-dpi for
+         * more information.
+         */
+        std::size_t residentFontAtlasCount() const { return _residentFontAtlasCount; }
+
+        /**
+         * @brief Set count of font atlases kept resident
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Includes the currently used atlas, expects that @p count is at
+         * least @cpp 1 @ce. Setting it to @cpp 1 @ce makes @ref relayout()
+         * discard the atlas every time the pixel density changes. The new
+         * count is applied on the next change of pixel density. See
+         * @ref ImGuiIntegration-Context-dpi for more information.
+         */
+        Context& setResidentFontAtlasCount(std::size_t count);
+
         /**
          * @brief Start a new frame
          *
@@ -552,6 +1165,79 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         void newFrame();
 
+        /**
+         * @brief Statistics of the last frame
+         * @m_since_latest_{integration}
+         *
+         * Reset in every @ref newFrame() call and filled by it and the
+         * subsequent @ref drawFrame(). If @ref render() and @ref draw() are
+         * used instead, the draw statistics are of the snapshot that was
+         * drawn two frames before, see
+         * @ref ImGuiIntegration-Context-snapshots. See
+         * @ref ImGuiIntegration-Context-statistics for more information.
+         */
+        const FrameStatistics& frameStatistics() const { return _frameStatistics; }
+
+        /**
+         * @brief Whether the context is ready for drawing
+         * @m_since_latest_{integration}
+         *
+         * Returns @ref SharedResources::isReady() of the resources used by
+         * this context. Always @cpp true @ce unless the context was created
+         * with a @ref SharedResources instance that's still compiling. See
+         * @ref ImGuiIntegration-Context-multiple-contexts for more
+         * information.
+         */
+        bool isReady();
+
+        /**
+         * @brief Whether the UI needs to be redrawn
+         * @m_since_latest_{integration}
+         *
+         * Returns @cpp true @ce if @ref nextRedrawDeadline() is zero. Meant to
+         * be used by applications that redraw only when needed instead of
+         * continuously, see @ref ImGuiIntegration-Context-usage-on-demand for
+         * more information.
+         */
+        bool wantsRedraw();
+
+        /**
+         * @brief Time until the UI needs to be redrawn
+         * @m_since_latest_{integration}
+         *
+         * Returns time in seconds after which a redraw is needed even if no
+         * input events arrive. Returns @cpp 0.0f @ce if a redraw is needed
+         * right away, which is the case if:
+         *
+         * -    an event was passed to any of the @cpp handle*Event() @ce
+         *      functions or @ref relayout() was called, and the context didn't
+         *      draw the two frames after it yet, as ImGui often reacts to
+         *      input with a delay of one frame,
+         * -    ImGui has queued input events it didn't process yet, which can
+         *      happen with @cpp ImGuiIO::ConfigInputTrickleEventQueue @ce,
+         * -    a mouse button is held, for example for repeat buttons or when
+         *      dragging outside of a scrollable area, or a key other than a
+         *      modifier is held while ImGui captures the keyboard, for key
+         *      repeat,
+         * -    glyphs queued by @ref prewarmGlyphs() aren't all rasterized yet
+         *      or, on ImGui 1.92 and newer, a texture is waiting to be
+         *      created, updated or destroyed,
+         * -    @ref isReady() is @cpp false @ce,
+         * -    an item is hovered or a popup is open and the last event
+         *      arrived less than a second ago, to show delayed tooltips and
+         *      fade in modal window backgrounds.
+         *
+         * Otherwise, if ImGui wants text input and
+         * @cpp ImGuiIO::ConfigInputTextCursorBlink @ce is enabled, returns
+         * time until @cpp 0.4 @ce seconds pass since the last
+         * @ref newFrame(), so the text cursor blinks. If nothing needs a
+         * redraw, returns @ref Constants::inf(). The value is calculated
+         * from state after the last @ref newFrame() and events that arrived
+         * since.
+         * @see @ref wantsRedraw()
+         */
+        Float nextRedrawDeadline();
+
         /**
          * @brief Draw a frame
          *
@@ -560,12 +1246,73 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          * calls since last call to @ref newFrame() to currently bound
          * framebuffer.
          *
+         * Consecutive draw commands that use the same texture and clip
+         * rectangle are merged into a single draw, or into a multi-draw if
+         * their index ranges aren't contiguous. Commands with an empty clip
+         * rectangle or one that's entirely outside of the framebuffer are
+         * skipped, and the scissor rectangle and texture binding are changed
+         * only if they differ from the previous draw. The state is assumed to
+         * be modified by user callbacks however, and is always set again
+         * after those.
+         *
+         * If @ref Flag::CachedLayer is set, the frame is drawn through an
+         * offscreen texture, see @ref ImGuiIntegration-Context-cached-layer
+         * for details.
+         *
+         * If @ref isReady() is @cpp false @ce, the frame is processed and
+         * textures are uploaded, but nothing is drawn. This function never
+         * waits for the shader compilation to finish.
+         *
          * See @ref ImGuiIntegration-Context-usage-rendering for more
          * information on which rendering states to set before and after
          * calling this method.
          */
         void drawFrame();
 
+        /**
+         * @brief Render a draw data snapshot
+         * @m_since_latest_{integration}
+         *
+         * Calls @cpp ImGui::SetCurrentContext() @ce on @ref context() and
+         * @cpp ImGui::Render() @ce and copies the resulting draw data into a
+         * snapshot that can be passed to @ref draw(). Doesn't do any GL
+         * calls, so it can be called from a thread that doesn't have the GL
+         * context current. See @ref ImGuiIntegration-Context-snapshots for
+         * more information.
+         *
+         * The returned reference stays valid until @ref render() is called
+         * two more times. Calling @ref drawFrame() in between is not
+         * allowed.
+         */
+        DrawDataSnapshot& render();
+
+        /**
+         * @brief Draw a draw data snapshot
+         * @m_since_latest_{integration}
+         *
+         * Draws the @p snapshot returned from @ref render() to the currently
+         * bound framebuffer, executing texture requests contained in it
+         * first. Otherwise behaves the same as @ref drawFrame(), except that
+         * it doesn't call @cpp ImGui::SetCurrentContext() @ce. The snapshots
+         * are expected to be drawn in the order they were rendered. See
+         * @ref ImGuiIntegration-Context-snapshots for more information.
+         */
+        void draw(DrawDataSnapshot& snapshot);
+
+        /**
+         * @brief Replay a recorded frame
+         * @m_since_latest_{integration}
+         *
+         * Draws @p frame from @p recording to the currently bound
+         * framebuffer, going through the same code path as @ref drawFrame(),
+         * including texture uploads and @ref frameStatistics(), which are
+         * reset first the same way as in @ref newFrame(). Doesn't call any
+         * ImGui APIs. Expects that @p frame is less than
+         * @ref DrawDataRecording::frameCount(). See
+         * @ref ImGuiIntegration-Context-recording for more information.
+         */
+        void replay(DrawDataRecording& recording, std::size_t frame);
+
         /**
          * @brief Handle pointer press event
          * @m_since_latest_{integration}
@@ -763,14 +1510,110 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
     private:
         template<class Application, class> friend struct Implementation::ApplicationClipboard;
 
+        /* If resources is nullptr, creates its own */
+        explicit Context(SharedResources* resources, ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize);
+
+        /* Updates statistics and draws the draw data, optionally with GPU
+           timing */
+        void submitDrawData(ImDrawData& drawData);
+        /* Used by event handlers if Flag::CoalesceEvents is enabled. The
+           source is ImGuiMouseSource. */
+        void coalescePointerMove(const Vector2& position, Int source);
+        void coalesceScroll(const Vector2& position, const Vector2& offset);
+        /* Passes the merged events to ImGui, expects the context to be
+           current */
+        void flushCoalescedEvents();
+        /* Fills allocation counts in FrameStatistics if an Allocator is
+           installed */
+        void updateAllocationStatistics();
+        /* Called by all event handlers and relayout(), makes
+           nextRedrawDeadline() return zero for the next few frames */
+        void scheduleRedraw();
+        /* Processes texture updates and draws the draw data, either directly
+           or through the cached layer */
+        void renderDrawData(ImDrawData& drawData);
+        /* Uploads and draws the draw lists to the currently bound
+           framebuffer */
+        void drawLists(const ImDrawData& drawData);
+
         ImGuiContext* _context;
-        Shaders::FlatGL2D _shader;
+        Flags _flags;
+        /* Set in the constructor together with
+           ImGuiBackendFlags_RendererHasVtxOffset, so drawing doesn't need to
+           query ImGui for it */
+        bool _baseVertexSupported{};
+        /* Points either to _ownResources or to externally supplied
+           resources */
+        SharedResources* _resources;
+        Containers::Pointer<SharedResources> _ownResources;
         GL::Buffer _vertexBuffer{GL::Buffer::TargetHint::Array};
         GL::Buffer _indexBuffer{GL::Buffer::TargetHint::ElementArray};
         Timeline _timeline;
         GL::Mesh _mesh;
+        /* Staging memory for uploading all draw lists at once */
+        Containers::Array<char> _drawStorage;
+        /* Draws collected for a single batch with the same state */
+        Containers::Array<GL::MeshView> _drawViews;
+        /* Created on first use, batches drawn by drawLists() */
+        Containers::Pointer<CommandList> _commandList;
+        #ifndef MAGNUM_TARGET_GLES
+        /* Used instead of the above if ARB_buffer_storage is supported */
+        struct StreamingRing;
+        Containers::Pointer<StreamingRing> _streamingRing;
+        /* Used for texture uploads on ImGui 1.92 and newer */
+        Containers::Pointer<Implementation::PixelUnpackBuffer> _pixelUnpackBuffer;
+        #endif
+        /* Created on first use if Flag::CachedLayer is enabled */
+        struct CachedLayer;
+        Containers::Pointer<CachedLayer> _cachedLayer;
+        /* Created on first use if Flag::GpuTiming is enabled */
+        struct GpuTiming;
+        Containers::Pointer<GpuTiming> _gpuTiming;
+        FrameStatistics _frameStatistics{};
+        /* Filled by submitting the draw data, which may happen on another
+           thread in case of draw(), and combined into _frameStatistics on the
+           main thread */
+        FrameStatistics _drawStatistics{};
         Vector2 _supersamplingRatio,
             _eventScaling;
+        /* Glyphs queued by prewarmGlyphs(). Processed from the back, so the
+           most recently queued ones get rasterized first. */
+        struct GlyphPrewarm {
+            ImFont* font;
+            Float size;
+            char32_t next, last;
+        };
+        Containers::Array<GlyphPrewarm> _glyphPrewarm;
+        std::size_t _glyphPrewarmBudget = 65536;
+        /* Font atlases for other pixel densities, used by relayout() on
+           ImGui before 1.92 */
+        struct FontAtlasResidency;
+        Containers::Pointer<FontAtlasResidency> _fontAtlasResidency;
+        std::size_t _residentFontAtlasCount = 3;
+        /* Created by relayout() on first use of the font atlas cache on ImGui
+           before 1.92 */
+        struct FontAtlasCache;
+        Containers::Pointer<FontAtlasCache> _fontAtlasCache;
+        /* Created on first render() */
+        struct Snapshots;
+        Containers::Pointer<Snapshots> _snapshots;
+        DrawDataRecorder* _recorder{};
+        /* Pointer move and scroll merged since the last submission to ImGui
+           if Flag::CoalesceEvents is enabled */
+        struct CoalescedEvents {
+            Vector2 position;
+            Vector2 scroll;
+            /* ImGuiMouseSource, -1 if the events don't specify it */
+            Int source;
+            bool hasPosition;
+            bool hasScroll;
+        } _coalescedEvents{};
+        /* Used by nextRedrawDeadline(), frames left to draw after an event
+           and steady clock times in nanoseconds */
+        Int _redrawFrames{};
+        UnsignedLong _lastEventTime{}, _lastNewFrameTime{};
+        /* Allocator statistics at the start of newFrame() */
+        UnsignedLong _frameAllocationCount{}, _frameAllocatedBytes{};
         /* Optionally used by connectApplicationClipboard() */
         void* _application;
         Containers::String _lastClipboardText;
@@ -789,6 +1632,20 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
         #endif
 };
 
+CORRADE_ENUMSET_OPERATORS(Context::Flags)
+
+/**
+@debugoperatorclassenum{Context,Context::Flag}
+@m_since_latest_{integration}
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, Context::Flag value);
+
+/**
+@debugoperatorclassenum{Context,Context::Flags}
+@m_since_latest_{integration}
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, Context::Flags value);
+
 }}
 
 #endif
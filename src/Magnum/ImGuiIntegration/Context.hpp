@@ -63,9 +63,21 @@ template<class Application> Context::Context(ImGuiContext& context, const Vector
        ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_HasSetMousePos;
 }
 
+template<class Application> Context::Context(SharedResources& resources, const Vector2& size, const Application& application): Context{resources, *ImGui::CreateContext(), size, application} {}
+
+template<class Application> Context::Context(SharedResources& resources, ImGuiContext& context, const Vector2& size, const Application& application): Context{resources, context, size, application.windowSize(), application.framebufferSize()} {
+    /* We can honor io.WantSetMousePos requests if application type supports it */
+    if(Implementation::hasWarpCursor(application))
+       ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_HasSetMousePos;
+}
+
 template<class KeyEvent> bool Context::handleKeyEvent(KeyEvent& event, bool value) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
+
+    /* Submit merged pointer moves and scrolls first to preserve the order */
+    flushCoalescedEvents();
 
     typedef decltype(event.modifiers()) Modifiers;
     typedef typename Modifiers::Type Modifier;
@@ -243,6 +255,10 @@ template<class PointerEvent> bool Context::handlePointerEvent(PointerEvent& even
 
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
+
+    /* Submit merged pointer moves and scrolls first to preserve the order */
+    flushCoalescedEvents();
 
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = event.position()*_eventScaling;
@@ -288,6 +304,10 @@ CORRADE_IGNORE_DEPRECATED_PUSH
 template<class MouseEvent> bool Context::handleMouseEvent(MouseEvent& event, bool value) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
+
+    /* Submit merged pointer moves and scrolls first to preserve the order */
+    flushCoalescedEvents();
 
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = Vector2(event.position())*_eventScaling;
@@ -327,10 +347,16 @@ CORRADE_IGNORE_DEPRECATED_POP
 template<class ScrollEvent> bool Context::handleScrollEvent(ScrollEvent& event) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
 
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = event.position()*_eventScaling;
 
+    if(_flags & Flag::CoalesceEvents) {
+        coalesceScroll(position, event.offset());
+        return io.WantCaptureMouse;
+    }
+
     io.AddMousePosEvent(position.x(), position.y());
     io.AddMouseWheelEvent(event.offset().x(), event.offset().y());
 
@@ -342,10 +368,16 @@ CORRADE_IGNORE_DEPRECATED_PUSH
 template<class MouseScrollEvent> bool Context::handleMouseScrollEvent(MouseScrollEvent& event) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
 
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = Vector2(event.position())*_eventScaling;
 
+    if(_flags & Flag::CoalesceEvents) {
+        coalesceScroll(position, event.offset());
+        return io.WantCaptureMouse;
+    }
+
     io.AddMousePosEvent(position.x(), position.y());
     io.AddMouseWheelEvent(event.offset().x(), event.offset().y());
 
@@ -361,6 +393,7 @@ template<class PointerMoveEvent> bool Context::handlePointerMoveEvent(PointerMov
 
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
 
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = event.position()*_eventScaling;
@@ -381,13 +414,22 @@ template<class PointerMoveEvent> bool Context::handlePointerMoveEvent(PointerMov
             buttonId = ImGuiMouseButton_Middle;
     }
 
+    ImGuiMouseSource source;
     if(Implementation::isTouchPointerEventSource(event.source()))
-        io.AddMouseSourceEvent(ImGuiMouseSource_TouchScreen);
+        source = ImGuiMouseSource_TouchScreen;
     else if(Implementation::isPenPointerEventSource(event.source()))
-        io.AddMouseSourceEvent(ImGuiMouseSource_Pen);
+        source = ImGuiMouseSource_Pen;
     else
-        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+        source = ImGuiMouseSource_Mouse;
 
+    /* Moves that don't change the set of pressed buttons can be merged */
+    if(!buttonId && (_flags & Flag::CoalesceEvents)) {
+        coalescePointerMove(position, source);
+        return io.WantCaptureMouse;
+    }
+
+    flushCoalescedEvents();
+    io.AddMouseSourceEvent(source);
     io.AddMousePosEvent(position.x(), position.y());
     /* The button is pressed if it's contained in the set of currently
        pressed pointers. If event.pointer() is a NullOpt, this isn't
@@ -403,10 +445,16 @@ CORRADE_IGNORE_DEPRECATED_PUSH
 template<class MouseMoveEvent> bool Context::handleMouseMoveEvent(MouseMoveEvent& event) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
 
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = Vector2(event.position())*_eventScaling;
 
+    if(_flags & Flag::CoalesceEvents) {
+        coalescePointerMove(position, ImGuiMouseSource_Mouse);
+        return io.WantCaptureMouse;
+    }
+
     io.AddMousePosEvent(position.x(), position.y());
 
     return io.WantCaptureMouse;
@@ -425,6 +473,10 @@ template<class KeyEvent> bool Context::handleKeyReleaseEvent(KeyEvent& event) {
 template<class TextInputEvent> bool Context::handleTextInputEvent(TextInputEvent& event) {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
+    scheduleRedraw();
+
+    /* Submit merged pointer moves and scrolls first to preserve the order */
+    flushCoalescedEvents();
 
     ImGui::GetIO().AddInputCharactersUTF8(event.text().data());
     return false;
@@ -0,0 +1,673 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawDataRecording.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <imgui.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Math/Vector4.h>
+
+#include "Magnum/ImGuiIntegration/Integration.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+/* All structures are written and read with memcpy() one after another,
+   without any padding between them. A file is a FileHeader followed by
+   frames, each being a FrameHeader followed by textureCount TextureHeaders
+   with their data and drawListCount DrawListHeaders with their data. */
+struct FileHeader {
+    char magic[4];
+    UnsignedShort version;
+    UnsignedByte vertexSize;
+    UnsignedByte indexSize;
+};
+
+constexpr char Magic[]{'M', 'I', 'D', 'R'};
+constexpr UnsignedShort Version = 1;
+
+struct FrameHeader {
+    /* Including the header itself */
+    UnsignedInt size;
+    UnsignedInt textureCount;
+    UnsignedInt drawListCount;
+    Vector2 displayPos;
+    Vector2 displaySize;
+    Vector2 framebufferScale;
+};
+
+enum class TextureRequest: UnsignedByte {
+    /* Followed by width*height*bytesPerPixel bytes of pixel data */
+    Create,
+    /* Followed by updateCount ImTextureRect-compatible rectangles and then
+       tightly packed pixel data for each of them */
+    Update,
+    /* Followed by nothing */
+    Destroy
+};
+
+struct TextureHeader {
+    UnsignedLong id;
+    Int width;
+    Int height;
+    UnsignedShort updateCount;
+    TextureRequest request;
+    /* 4 for RGBA, 1 for single-channel */
+    UnsignedByte bytesPerPixel;
+    UnsignedInt reserved;
+};
+
+struct TextureRect {
+    UnsignedShort x, y, w, h;
+};
+
+/* Followed by vertexCount vertices, indexCount indices and commandCount
+   Commands */
+struct DrawListHeader {
+    UnsignedInt vertexCount;
+    UnsignedInt indexCount;
+    UnsignedInt commandCount;
+};
+
+struct Command {
+    Vector4 clipRect;
+    UnsignedLong texture;
+    UnsignedInt vertexOffset;
+    UnsignedInt indexOffset;
+    UnsignedInt elementCount;
+    UnsignedInt reserved;
+};
+
+inline UnsignedLong textureIdToInteger(const ImTextureID id) {
+    #if IMGUI_VERSION_NUM >= 19131
+    return UnsignedLong(id);
+    #else
+    return reinterpret_cast<std::uintptr_t>(id);
+    #endif
+}
+
+#ifndef IMGUI_HAS_TEXTURES
+inline ImTextureID textureIdFromInteger(const UnsignedLong id) {
+    #if IMGUI_VERSION_NUM >= 19131
+    return ImTextureID(id);
+    #else
+    return reinterpret_cast<ImTextureID>(std::uintptr_t(id));
+    #endif
+}
+#endif
+
+template<class T> void write(Containers::Array<char>& out, const T& value) {
+    arrayAppend(out, Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+void write(Containers::Array<char>& out, const void* const data, const std::size_t size) {
+    arrayAppend(out, Containers::arrayView(static_cast<const char*>(data), size));
+}
+
+void writeFileHeader(Containers::Array<char>& out) {
+    FileHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.vertexSize = sizeof(ImDrawVert);
+    header.indexSize = sizeof(ImDrawIdx);
+    write(out, header);
+}
+
+/* Reads with bounds checking, returning false if there's not enough data */
+struct Reader {
+    Containers::ArrayView<const char> data;
+    std::size_t offset;
+
+    template<class T> bool read(T& out) {
+        if(data.size() - offset < sizeof(T)) return false;
+        std::memcpy(&out, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool skip(const std::size_t size) {
+        if(data.size() - offset < size) return false;
+        offset += size;
+        return true;
+    }
+
+    const char* pointer() const { return data.data() + offset; }
+};
+
+bool validateFrame(Reader& reader) {
+    FrameHeader header;
+    if(!reader.read(header)) return false;
+
+    for(UnsignedInt i = 0; i != header.textureCount; ++i) {
+        /* ImTextureRect is 16-bit and ImTextureData has an int size in
+           bytes, larger textures can't be replayed */
+        TextureHeader texture;
+        if(!reader.read(texture) ||
+           texture.width < 0 || texture.height < 0 ||
+           texture.width > 65535 || texture.height > 65535 ||
+           (texture.bytesPerPixel != 1 && texture.bytesPerPixel != 4) ||
+           UnsignedLong(texture.width)*texture.height*texture.bytesPerPixel > UnsignedLong(std::numeric_limits<int>::max()))
+            return false;
+
+        if(texture.request == TextureRequest::Create) {
+            if(!reader.skip(std::size_t(texture.width)*texture.height*texture.bytesPerPixel))
+                return false;
+        } else if(texture.request == TextureRequest::Update) {
+            std::size_t dataSize = 0;
+            for(UnsignedShort j = 0; j != texture.updateCount; ++j) {
+                TextureRect rect;
+                if(!reader.read(rect) ||
+                   rect.x + rect.w > texture.width ||
+                   rect.y + rect.h > texture.height)
+                    return false;
+                dataSize += std::size_t(rect.w)*rect.h*texture.bytesPerPixel;
+            }
+            if(!reader.skip(dataSize))
+                return false;
+        } else if(texture.request != TextureRequest::Destroy)
+            return false;
+    }
+
+    for(UnsignedInt i = 0; i != header.drawListCount; ++i) {
+        DrawListHeader list;
+        if(!reader.read(list) ||
+           !reader.skip(std::size_t(list.vertexCount)*sizeof(ImDrawVert) + std::size_t(list.indexCount)*sizeof(ImDrawIdx)))
+            return false;
+        const char* const indices = reader.pointer() - std::size_t(list.indexCount)*sizeof(ImDrawIdx);
+
+        for(UnsignedInt j = 0; j != list.commandCount; ++j) {
+            Command command;
+            if(!reader.read(command) ||
+               std::size_t(command.indexOffset) + command.elementCount > list.indexCount ||
+               command.vertexOffset > list.vertexCount)
+                return false;
+
+            /* Every index the command draws has to point to a vertex of the
+               list. The indices aren't necessarily aligned in the data. */
+            for(UnsignedInt k = command.indexOffset; k != command.indexOffset + command.elementCount; ++k) {
+                ImDrawIdx index;
+                std::memcpy(&index, indices + std::size_t(k)*sizeof(ImDrawIdx), sizeof(ImDrawIdx));
+                if(std::size_t(index) + command.vertexOffset >= list.vertexCount)
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+struct DrawDataRecorder::State {
+    Containers::Array<char> data;
+    std::size_t frameCount = 0;
+    #ifdef IMGUI_HAS_TEXTURES
+    /* Texture requests of the frame being submitted, filled by
+       beginFrame() */
+    struct Request {
+        ImTextureData* texture;
+        /* ID before the submission */
+        UnsignedLong id;
+        TextureRequest request;
+    };
+    Containers::Array<Request> requests;
+    #endif
+};
+
+DrawDataRecorder::DrawDataRecorder(): _state{InPlaceInit} {
+    writeFileHeader(_state->data);
+}
+
+DrawDataRecorder::DrawDataRecorder(DrawDataRecorder&&) noexcept = default;
+
+DrawDataRecorder::~DrawDataRecorder() = default;
+
+DrawDataRecorder& DrawDataRecorder::operator=(DrawDataRecorder&&) noexcept = default;
+
+std::size_t DrawDataRecorder::frameCount() const {
+    return _state->frameCount;
+}
+
+Containers::ArrayView<const char> DrawDataRecorder::data() const {
+    return _state->data;
+}
+
+bool DrawDataRecorder::save(const Containers::StringView filename) const {
+    if(!Utility::Path::write(filename, _state->data)) {
+        Error{} << "ImGuiIntegration::DrawDataRecorder::save(): can't write" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+DrawDataRecorder& DrawDataRecorder::clear() {
+    arrayRemoveSuffix(_state->data, _state->data.size());
+    writeFileHeader(_state->data);
+    _state->frameCount = 0;
+    return *this;
+}
+
+void DrawDataRecorder::beginFrame(const ImDrawData& drawData) {
+    #ifdef IMGUI_HAS_TEXTURES
+    State& state = *_state;
+    arrayRemoveSuffix(state.requests, state.requests.size());
+    if(!drawData.Textures)
+        return;
+
+    for(ImTextureData* const texture: *drawData.Textures) {
+        TextureRequest request;
+        /* Textures that exist before the first recorded frame are recorded
+           as created in it, so the replay has them as well */
+        if(texture->Status == ImTextureStatus_WantCreate || (!state.frameCount && (texture->Status == ImTextureStatus_OK || texture->Status == ImTextureStatus_WantUpdates) && texture->GetTexID() != ImTextureID_Invalid && texture->Pixels))
+            request = TextureRequest::Create;
+        else if(texture->Status == ImTextureStatus_WantUpdates)
+            request = TextureRequest::Update;
+        else if(texture->Status == ImTextureStatus_WantDestroy)
+            request = TextureRequest::Destroy;
+        else continue;
+
+        arrayAppend(state.requests, InPlaceInit, texture, textureIdToInteger(texture->GetTexID()), request);
+    }
+    #else
+    static_cast<void>(drawData);
+    #endif
+}
+
+void DrawDataRecorder::endFrame(const ImDrawData& drawData) {
+    State& state = *_state;
+    Containers::Array<char>& out = state.data;
+    const std::size_t frameOffset = out.size();
+
+    FrameHeader header{};
+    header.drawListCount = drawData.CmdLists.Size;
+    header.displayPos = Vector2{drawData.DisplayPos};
+    header.displaySize = Vector2{drawData.DisplaySize};
+    header.framebufferScale = Vector2{drawData.FramebufferScale};
+    #ifdef IMGUI_HAS_TEXTURES
+    header.textureCount = state.requests.size();
+    #endif
+    write(out, header);
+
+    #ifdef IMGUI_HAS_TEXTURES
+    for(const State::Request& request: state.requests) {
+        const ImTextureData& texture = *request.texture;
+
+        TextureHeader textureHeader{};
+        /* Creation assigned the ID just now, destruction reset it */
+        textureHeader.id = request.request == TextureRequest::Create ?
+            textureIdToInteger(texture.GetTexID()) : request.id;
+        textureHeader.width = texture.Width;
+        textureHeader.height = texture.Height;
+        textureHeader.request = request.request;
+        textureHeader.bytesPerPixel = texture.BytesPerPixel;
+
+        if(request.request == TextureRequest::Create) {
+            write(out, textureHeader);
+            write(out, texture.GetPixels(), texture.GetSizeInBytes());
+
+        } else if(request.request == TextureRequest::Update) {
+            /* The update list can be empty if just the bounding rectangle
+               is filled */
+            const ImTextureRect* rects = texture.Updates.Data;
+            std::size_t rectCount = texture.Updates.Size;
+            if(!rectCount) {
+                rects = &texture.UpdateRect;
+                rectCount = 1;
+            }
+
+            textureHeader.updateCount = UnsignedShort(rectCount);
+            write(out, textureHeader);
+            for(std::size_t i = 0; i != rectCount; ++i)
+                write(out, TextureRect{rects[i].x, rects[i].y, rects[i].w, rects[i].h});
+            for(std::size_t i = 0; i != rectCount; ++i) {
+                const ImTextureRect& rect = rects[i];
+                for(Int y = 0; y != rect.h; ++y)
+                    write(out, const_cast<ImTextureData&>(texture).GetPixelsAt(rect.x, rect.y + y), std::size_t(rect.w)*texture.BytesPerPixel);
+            }
+
+        } else write(out, textureHeader);
+    }
+    #endif
+
+    /* User callbacks can't be recorded, they're omitted */
+    for(std::int_fast32_t n = 0; n < drawData.CmdLists.Size; ++n) {
+        const ImDrawList& list = *drawData.CmdLists[n];
+
+        DrawListHeader listHeader{};
+        listHeader.vertexCount = list.VtxBuffer.Size;
+        listHeader.indexCount = list.IdxBuffer.Size;
+        for(const ImDrawCmd& cmd: list.CmdBuffer)
+            if(!cmd.UserCallback) ++listHeader.commandCount;
+        write(out, listHeader);
+        write(out, list.VtxBuffer.Data, list.VtxBuffer.Size*sizeof(ImDrawVert));
+        write(out, list.IdxBuffer.Data, list.IdxBuffer.Size*sizeof(ImDrawIdx));
+
+        for(const ImDrawCmd& cmd: list.CmdBuffer) {
+            if(cmd.UserCallback) continue;
+
+            Command command{};
+            command.clipRect = Vector4{cmd.ClipRect};
+            command.texture = textureIdToInteger(cmd.GetTexID());
+            command.vertexOffset = cmd.VtxOffset;
+            command.indexOffset = cmd.IdxOffset;
+            command.elementCount = cmd.ElemCount;
+            write(out, command);
+        }
+    }
+
+    /* Fill in the frame size now that it's known */
+    const UnsignedInt frameSize = out.size() - frameOffset;
+    std::memcpy(out.data() + frameOffset, &frameSize, sizeof(UnsignedInt));
+    ++state.frameCount;
+}
+
+struct DrawDataRecording::State {
+    Containers::Array<char> data;
+    Containers::Array<std::size_t> frameOffsets;
+
+    /* Draw data of the last prepared frame. The draw lists are only ever
+       growing and keep their memory between frames. */
+    ImDrawData drawData;
+    Containers::Array<Containers::Pointer<ImDrawList>> drawLists;
+
+    #ifdef IMGUI_HAS_TEXTURES
+    /* Textures created by the replay, identified by the ID they had when
+       recorded */
+    struct Texture {
+        UnsignedLong recordedId;
+        Containers::Pointer<ImTextureData> texture;
+    };
+    Containers::Array<Texture> textures;
+    /* Destruction requests, only the first destroyRequestCount are used in
+       given frame, the rest is kept for reuse */
+    Containers::Array<Containers::Pointer<ImTextureData>> destroyRequests;
+    ImVector<ImTextureData*> textureList;
+    #endif
+};
+
+DrawDataRecording::DrawDataRecording(Containers::Pointer<State>&& state): _state{Utility::move(state)} {}
+
+DrawDataRecording::DrawDataRecording(DrawDataRecording&&) noexcept = default;
+
+DrawDataRecording::~DrawDataRecording() {
+    #ifdef IMGUI_HAS_TEXTURES
+    if(_state) for(const State::Texture& texture: _state->textures) {
+        if(texture.texture->GetTexID() != ImTextureID_Invalid)
+            GL::Texture2D::wrap(GLuint(texture.texture->GetTexID()),
+                GL::ObjectFlag::Created|GL::ObjectFlag::DeleteOnDestruction);
+    }
+    #endif
+}
+
+DrawDataRecording& DrawDataRecording::operator=(DrawDataRecording&& other) noexcept {
+    /* Swapping so the textures get deleted by the other instance */
+    using Utility::swap;
+    swap(_state, other._state);
+    return *this;
+}
+
+Containers::Optional<DrawDataRecording> DrawDataRecording::fromData(Containers::Array<char>&& data) {
+    FileHeader header;
+    if(data.size() < sizeof(FileHeader)) {
+        Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): expected at least" << sizeof(FileHeader) << "bytes but got" << data.size();
+        return {};
+    }
+    std::memcpy(&header, data.data(), sizeof(FileHeader));
+    if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): invalid signature";
+        return {};
+    }
+    if(header.version != Version) {
+        Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): unsupported version" << header.version;
+        return {};
+    }
+    if(header.vertexSize != sizeof(ImDrawVert) || header.indexSize != sizeof(ImDrawIdx)) {
+        Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): expected" << sizeof(ImDrawVert) << Debug::nospace << "-byte vertices and" << sizeof(ImDrawIdx) << Debug::nospace << "-byte indices but got" << header.vertexSize << Debug::nospace << "-byte and" << header.indexSize << Debug::nospace << "-byte";
+        return {};
+    }
+
+    Containers::Pointer<State> state{InPlaceInit};
+    for(std::size_t offset = sizeof(FileHeader); offset != data.size(); ) {
+        FrameHeader frame;
+        if(data.size() - offset < sizeof(FrameHeader)) {
+            Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): frame" << state->frameOffsets.size() << "is truncated";
+            return {};
+        }
+        std::memcpy(&frame, data.data() + offset, sizeof(FrameHeader));
+        if(frame.size < sizeof(FrameHeader) || frame.size > data.size() - offset) {
+            Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): frame" << state->frameOffsets.size() << "has an invalid size" << frame.size;
+            return {};
+        }
+
+        Reader reader{data.sliceSize(offset, frame.size), 0};
+        if(!validateFrame(reader) || reader.offset != frame.size) {
+            Error{} << "ImGuiIntegration::DrawDataRecording::fromData(): frame" << state->frameOffsets.size() << "is corrupted";
+            return {};
+        }
+
+        arrayAppend(state->frameOffsets, offset);
+        offset += frame.size;
+    }
+
+    state->data = Utility::move(data);
+    return DrawDataRecording{Utility::move(state)};
+}
+
+Containers::Optional<DrawDataRecording> DrawDataRecording::load(const Containers::StringView filename) {
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+    if(!data) {
+        Error{} << "ImGuiIntegration::DrawDataRecording::load(): can't read" << filename;
+        return {};
+    }
+
+    return fromData(*Utility::move(data));
+}
+
+std::size_t DrawDataRecording::frameCount() const {
+    return _state->frameOffsets.size();
+}
+
+Vector2 DrawDataRecording::displaySize(const std::size_t frame) const {
+    CORRADE_ASSERT(frame < _state->frameOffsets.size(),
+        "ImGuiIntegration::DrawDataRecording::displaySize(): frame" << frame << "out of range for" << _state->frameOffsets.size() << "frames", {});
+    FrameHeader header;
+    std::memcpy(&header, _state->data.data() + _state->frameOffsets[frame], sizeof(FrameHeader));
+    return header.displaySize;
+}
+
+ImDrawData& DrawDataRecording::prepareFrame(const std::size_t frame, const UnsignedLong fallbackTexture) {
+    State& state = *_state;
+
+    /* The data were validated in fromData() already, so the reads can't
+       fail */
+    Reader reader{state.data, state.frameOffsets[frame]};
+    FrameHeader header;
+    reader.read(header);
+
+    #ifdef IMGUI_HAS_TEXTURES
+    static_cast<void>(fallbackTexture);
+
+    state.textureList.resize(0);
+    std::size_t destroyRequestCount = 0;
+    const auto destroy = [&state, &destroyRequestCount](ImTextureData& texture) {
+        if(destroyRequestCount == state.destroyRequests.size())
+            arrayAppend(state.destroyRequests, Containers::Pointer<ImTextureData>{InPlaceInit});
+        ImTextureData& request = *state.destroyRequests[destroyRequestCount++];
+        request.SetTexID(texture.GetTexID());
+        request.Status = ImTextureStatus_WantDestroy;
+        state.textureList.push_back(&request);
+
+        /* Nothing references the texture from now on, so the destruction
+           can happen through a separate request */
+        texture.SetTexID(ImTextureID_Invalid);
+        texture.Status = ImTextureStatus_Destroyed;
+    };
+    const auto find = [&state](const UnsignedLong id) -> ImTextureData* {
+        for(State::Texture& texture: state.textures)
+            if(texture.recordedId == id) return texture.texture.get();
+        return nullptr;
+    };
+    const auto isAlive = [](const ImTextureData* const texture) {
+        return texture && (texture->Status == ImTextureStatus_WantCreate || texture->GetTexID() != ImTextureID_Invalid);
+    };
+
+    for(UnsignedInt i = 0; i != header.textureCount; ++i) {
+        TextureHeader textureHeader;
+        reader.read(textureHeader);
+        ImTextureData* texture = find(textureHeader.id);
+
+        if(textureHeader.request == TextureRequest::Create) {
+            if(!texture) {
+                arrayAppend(state.textures, InPlaceInit, textureHeader.id, Containers::Pointer<ImTextureData>{InPlaceInit});
+                texture = state.textures.back().texture.get();
+            }
+
+            /* Replaying the frame again, destroy the texture created by the
+               previous replay */
+            if(texture->GetTexID() != ImTextureID_Invalid)
+                destroy(*texture);
+
+            texture->Create(textureHeader.bytesPerPixel == 4 ? ImTextureFormat_RGBA32 : ImTextureFormat_Alpha8, textureHeader.width, textureHeader.height);
+            std::memcpy(texture->GetPixels(), reader.pointer(), texture->GetSizeInBytes());
+            reader.skip(texture->GetSizeInBytes());
+            texture->Status = ImTextureStatus_WantCreate;
+            state.textureList.push_back(texture);
+
+        } else if(textureHeader.request == TextureRequest::Update) {
+            /* Updates of textures that the replay didn't create are
+               skipped */
+            const bool apply = texture && texture->GetTexID() != ImTextureID_Invalid && texture->Width == textureHeader.width && texture->Height == textureHeader.height && texture->BytesPerPixel == textureHeader.bytesPerPixel;
+            if(apply) texture->Updates.resize(0);
+
+            const char* const rects = reader.pointer();
+            reader.skip(textureHeader.updateCount*sizeof(TextureRect));
+            Range2Di bounds;
+            for(UnsignedShort j = 0; j != textureHeader.updateCount; ++j) {
+                TextureRect rect;
+                std::memcpy(&rect, rects + j*sizeof(TextureRect), sizeof(TextureRect));
+                const std::size_t rowSize = std::size_t(rect.w)*textureHeader.bytesPerPixel;
+                if(apply) {
+                    for(Int y = 0; y != rect.h; ++y)
+                        std::memcpy(texture->GetPixelsAt(rect.x, rect.y + y), reader.pointer() + y*rowSize, rowSize);
+                    texture->Updates.push_back(ImTextureRect{rect.x, rect.y, rect.w, rect.h});
+                    const Range2Di rectRange = Range2Di::fromSize({rect.x, rect.y}, {rect.w, rect.h});
+                    bounds = j ? Math::join(bounds, rectRange) : rectRange;
+                }
+                reader.skip(rowSize*rect.h);
+            }
+
+            if(apply) {
+                texture->UpdateRect = ImTextureRect{
+                    UnsignedShort(bounds.min().x()), UnsignedShort(bounds.min().y()),
+                    UnsignedShort(bounds.sizeX()), UnsignedShort(bounds.sizeY())};
+                texture->Status = ImTextureStatus_WantUpdates;
+                state.textureList.push_back(texture);
+            }
+
+        } else if(isAlive(texture) && texture->Status != ImTextureStatus_WantCreate)
+            destroy(*texture);
+    }
+
+    /* Draws with textures not created by the recording use the first texture
+       that was, which is usually the font atlas */
+    ImTextureData* fallback = nullptr;
+    for(State::Texture& texture: state.textures) if(isAlive(texture.texture.get())) {
+        fallback = texture.texture.get();
+        break;
+    }
+    #endif
+
+    ImDrawData& out = state.drawData;
+    out.Clear();
+    out.Valid = true;
+    out.CmdListsCount = header.drawListCount;
+    out.DisplayPos = ImVec2(header.displayPos);
+    out.DisplaySize = ImVec2(header.displaySize);
+    out.FramebufferScale = ImVec2(header.framebufferScale);
+    #ifdef IMGUI_HAS_TEXTURES
+    if(!state.textureList.empty())
+        out.Textures = &state.textureList;
+    #endif
+
+    for(UnsignedInt n = 0; n != header.drawListCount; ++n) {
+        if(n == state.drawLists.size())
+            arrayAppend(state.drawLists, Containers::Pointer<ImDrawList>{InPlaceInit, nullptr});
+        ImDrawList& list = *state.drawLists[n];
+
+        DrawListHeader listHeader;
+        reader.read(listHeader);
+        list.VtxBuffer.resize(listHeader.vertexCount);
+        list.IdxBuffer.resize(listHeader.indexCount);
+        if(listHeader.vertexCount)
+            std::memcpy(list.VtxBuffer.Data, reader.pointer(), listHeader.vertexCount*sizeof(ImDrawVert));
+        reader.skip(listHeader.vertexCount*sizeof(ImDrawVert));
+        if(listHeader.indexCount)
+            std::memcpy(list.IdxBuffer.Data, reader.pointer(), listHeader.indexCount*sizeof(ImDrawIdx));
+        reader.skip(listHeader.indexCount*sizeof(ImDrawIdx));
+
+        list.CmdBuffer.resize(0);
+        for(UnsignedInt c = 0; c != listHeader.commandCount; ++c) {
+            Command command;
+            reader.read(command);
+
+            ImDrawCmd cmd;
+            cmd.ClipRect = ImVec4(command.clipRect);
+            cmd.VtxOffset = command.vertexOffset;
+            cmd.IdxOffset = command.indexOffset;
+            cmd.ElemCount = command.elementCount;
+            #ifdef IMGUI_HAS_TEXTURES
+            ImTextureData* texture = find(command.texture);
+            if(!isAlive(texture)) texture = fallback;
+            /* No texture to draw with at all, skip the command */
+            if(!texture) continue;
+            cmd.TexRef._TexData = texture;
+            cmd.TexRef._TexID = ImTextureID_Invalid;
+            #else
+            cmd.TextureId = textureIdFromInteger(fallbackTexture);
+            #endif
+            list.CmdBuffer.push_back(cmd);
+        }
+
+        out.CmdLists.push_back(&list);
+        out.TotalVtxCount += listHeader.vertexCount;
+        out.TotalIdxCount += listHeader.indexCount;
+    }
+
+    return out;
+}
+
+}}
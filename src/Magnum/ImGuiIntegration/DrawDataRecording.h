@@ -0,0 +1,225 @@
+#ifndef Magnum_ImGuiIntegration_DrawDataRecording_h
+#define Magnum_ImGuiIntegration_DrawDataRecording_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::DrawDataRecorder, @ref Magnum::ImGuiIntegration::DrawDataRecording
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Magnum.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+struct ImDrawData;
+
+namespace Magnum { namespace ImGuiIntegration {
+
+class Context;
+
+/**
+@brief Draw data recorder
+@m_since_latest_{integration}
+
+Records draw data submitted by a @ref Context into a compact binary form that
+can be saved to a file, loaded back as a @ref DrawDataRecording and replayed
+with @ref Context::replay() without running the application, for example to
+profile or compare renderer changes on real UI layouts:
+
+@snippet ImGuiIntegration.cpp DrawDataRecorder
+
+Every frame drawn with @ref Context::drawFrame() or @ref Context::draw() while
+the recorder is set with @ref Context::setRecorder() gets recorded, including
+vertex, index and command buffers, clip rectangles, texture IDs and, on ImGui
+1.92 and newer, texture creation, update and destruction requests together
+with the pixel data. Frames with a zero display size aren't drawn and thus
+aren't recorded either. User callbacks added with
+@cpp ImDrawList::AddCallback() @ce can't be recorded and are omitted.
+
+On ImGui 1.92 and newer, textures that already exist when the first frame is
+recorded are recorded as created in the first frame. This is however only
+possible with @ref Context::drawFrame(), with @ref Context::render() and
+@ref Context::draw() the recorder should be set before the first frame is
+rendered.
+
+The data are stored in native endianness and with the vertex and index layout
+of the ImGui build that recorded them, so they can be only replayed on a
+platform with the same endianness and with the same ImGui configuration.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT DrawDataRecorder {
+    public:
+        /** @brief Constructor */
+        explicit DrawDataRecorder();
+
+        /** @brief Copying is not allowed */
+        DrawDataRecorder(const DrawDataRecorder&) = delete;
+
+        /** @brief Move constructor */
+        DrawDataRecorder(DrawDataRecorder&&) noexcept;
+
+        ~DrawDataRecorder();
+
+        /** @brief Copying is not allowed */
+        DrawDataRecorder& operator=(const DrawDataRecorder&) = delete;
+
+        /** @brief Move assignment */
+        DrawDataRecorder& operator=(DrawDataRecorder&&) noexcept;
+
+        /** @brief Count of recorded frames */
+        std::size_t frameCount() const;
+
+        /**
+         * @brief Recorded data
+         *
+         * Can be passed to @ref DrawDataRecording::fromData().
+         */
+        Containers::ArrayView<const char> data() const;
+
+        /**
+         * @brief Save the recorded data to a file
+         *
+         * Returns @cpp false @ce and prints a message to
+         * @relativeref{Magnum,Error} if the file can't be written, @cpp true
+         * @ce otherwise. The file can be loaded with
+         * @ref DrawDataRecording::load().
+         */
+        bool save(Containers::StringView filename) const;
+
+        /**
+         * @brief Clear the recorded data
+         * @return Reference to self (for method chaining)
+         *
+         * The next recorded frame is treated as the first one again.
+         */
+        DrawDataRecorder& clear();
+
+    private:
+        friend Context;
+
+        /* Called by Context before and after draw data get submitted,
+           texture request statuses and IDs are changed by the submission */
+        void beginFrame(const ImDrawData& drawData);
+        void endFrame(const ImDrawData& drawData);
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Recorded draw data
+@m_since_latest_{integration}
+
+Frames recorded with a @ref DrawDataRecorder, replayed with
+@ref Context::replay(). The replay goes through the same code path as
+@ref Context::drawFrame(), including texture uploads, and updates
+@ref Context::frameStatistics() the same way.
+
+On ImGui 1.92 and newer, textures created by the recorded frames are created
+again by the replay. Textures that weren't created by the recorded frames,
+such as custom textures drawn with @ref image(), can't be replayed and are
+substituted with the first texture the recording created, which is usually
+the font atlas. On older versions, all draws use the font atlas of the
+replaying @ref Context.
+
+Frames that create textures have to be replayed before frames that use them,
+so the recording is meant to be replayed in order, optionally in a loop. A
+replayed texture creation destroys the texture created by the previous replay
+of the same frame.
+
+GL textures created by the replay are owned by the recording, so it has to be
+destroyed while the GL context is still alive.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT DrawDataRecording {
+    public:
+        /**
+         * @brief Create from recorded data
+         *
+         * The data are expected to be produced by
+         * @ref DrawDataRecorder::data() with the same ImGui configuration. On
+         * failure prints a message to @relativeref{Magnum,Error} and returns
+         * @relativeref{Corrade,Containers::NullOpt}.
+         */
+        static Containers::Optional<DrawDataRecording> fromData(Containers::Array<char>&& data);
+
+        /**
+         * @brief Load recorded data from a file
+         *
+         * Reads the file and passes it to @ref fromData(). On failure prints
+         * a message to @relativeref{Magnum,Error} and returns
+         * @relativeref{Corrade,Containers::NullOpt}.
+         */
+        static Containers::Optional<DrawDataRecording> load(Containers::StringView filename);
+
+        /** @brief Copying is not allowed */
+        DrawDataRecording(const DrawDataRecording&) = delete;
+
+        /** @brief Move constructor */
+        DrawDataRecording(DrawDataRecording&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes GL textures created by @ref Context::replay().
+         */
+        ~DrawDataRecording();
+
+        /** @brief Copying is not allowed */
+        DrawDataRecording& operator=(const DrawDataRecording&) = delete;
+
+        /** @brief Move assignment */
+        DrawDataRecording& operator=(DrawDataRecording&&) noexcept;
+
+        /** @brief Count of recorded frames */
+        std::size_t frameCount() const;
+
+        /**
+         * @brief Display size of a frame
+         *
+         * Expects that @p frame is less than @ref frameCount().
+         */
+        Vector2 displaySize(std::size_t frame) const;
+
+    private:
+        friend Context;
+
+        struct State;
+
+        explicit DrawDataRecording(Containers::Pointer<State>&& state);
+
+        /* Fills the draw data for given frame, including texture requests.
+           The fallback is used for draws that reference textures not created
+           by the recording. */
+        ImDrawData& prepareFrame(std::size_t frame, UnsignedLong fallbackTexture);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,320 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImageAtlas.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+struct Shelf {
+    Int y;
+    /* Including padding */
+    Int height;
+    /* End of the space used by images, slots freed before it are in
+       freeSlots */
+    Int end;
+    UnsignedInt imageCount;
+    /* Offsets and widths of slots freed by removed images, including
+       padding */
+    Containers::Array<Containers::Pair<Int, Int>> freeSlots;
+};
+
+struct Page {
+    GL::Texture2D texture;
+    Containers::Array<Shelf> shelves;
+    /* End of the space used by shelves */
+    Int end;
+};
+
+struct Image {
+    Range2Di rectangle;
+    UnsignedInt page;
+    UnsignedInt shelf;
+    bool used;
+};
+
+/* Offset at which an image of given width including padding fits into the
+   shelf, or -1 if it doesn't */
+Int findSlot(const Shelf& shelf, const Int width, const Int paddedWidth, const Int pageWidth) {
+    for(const Containers::Pair<Int, Int>& slot: shelf.freeSlots)
+        if(slot.second() >= paddedWidth)
+            return slot.first();
+    if(shelf.end + width <= pageWidth)
+        return shelf.end;
+    return -1;
+}
+
+}
+
+struct ImageAtlas::State {
+    Vector2i pageSize;
+    Int padding;
+    Containers::Array<Page> pages;
+    Containers::Array<Image> images;
+    Containers::Array<UnsignedInt> freeIds;
+    UnsignedInt imageCount{};
+    /* Returned from pageTexture() and texture() on a failed graceful
+       assert, as there may be no page to return instead */
+    GL::Texture2D invalidTexture{NoCreate};
+};
+
+ImageAtlas::ImageAtlas(const Vector2i& pageSize, const Int padding): _state{InPlaceInit} {
+    CORRADE_ASSERT(pageSize.product(),
+        "ImGuiIntegration::ImageAtlas: expected a non-zero page size but got" << pageSize, );
+    CORRADE_ASSERT(padding >= 0,
+        "ImGuiIntegration::ImageAtlas: expected a non-negative padding but got" << padding, );
+    _state->pageSize = pageSize;
+    _state->padding = padding;
+}
+
+ImageAtlas::ImageAtlas(NoCreateT) noexcept {}
+
+ImageAtlas::ImageAtlas(ImageAtlas&&) noexcept = default;
+
+ImageAtlas::~ImageAtlas() = default;
+
+ImageAtlas& ImageAtlas::operator=(ImageAtlas&&) noexcept = default;
+
+Vector2i ImageAtlas::pageSize() const {
+    return _state->pageSize;
+}
+
+Int ImageAtlas::padding() const {
+    return _state->padding;
+}
+
+UnsignedInt ImageAtlas::pageCount() const {
+    return UnsignedInt(_state->pages.size());
+}
+
+GL::Texture2D& ImageAtlas::pageTexture(const UnsignedInt page) {
+    CORRADE_ASSERT(page < _state->pages.size(),
+        "ImGuiIntegration::ImageAtlas::pageTexture(): index" << page << "out of range for" << _state->pages.size() << "pages", _state->invalidTexture);
+    return _state->pages[page].texture;
+}
+
+UnsignedInt ImageAtlas::imageCount() const {
+    return _state->imageCount;
+}
+
+UnsignedInt ImageAtlas::add(const ImageView2D& image) {
+    State& state = *_state;
+    CORRADE_ASSERT(image.format() == PixelFormat::RGBA8Unorm || image.format() == PixelFormat::RGBA8Srgb,
+        "ImGuiIntegration::ImageAtlas::add(): expected an RGBA8 image but got" << image.format(), {});
+    CORRADE_ASSERT((image.size() <= state.pageSize).all(),
+        "ImGuiIntegration::ImageAtlas::add(): image of size" << image.size() << "doesn't fit into a page of size" << state.pageSize, {});
+
+    const Vector2i size = image.size();
+    const Int paddedWidth = size.x() + state.padding;
+    const Int paddedHeight = size.y() + state.padding;
+
+    /* Pick a shelf with enough space that wastes the least height. Shelves
+       with images are used only for images of a similar height, empty
+       shelves for any that fits. */
+    UnsignedInt pageId = ~UnsignedInt{};
+    UnsignedInt shelfId = ~UnsignedInt{};
+    Int x = -1;
+    Int bestWaste = state.pageSize.y();
+    for(UnsignedInt p = 0; p != state.pages.size() && bestWaste; ++p) {
+        const Page& page = state.pages[p];
+        for(UnsignedInt s = 0; s != page.shelves.size(); ++s) {
+            const Shelf& shelf = page.shelves[s];
+            const Int waste = shelf.height - paddedHeight;
+            if(waste < 0 || waste >= bestWaste ||
+               (shelf.imageCount && waste > paddedHeight/2))
+                continue;
+            const Int slot = findSlot(shelf, size.x(), paddedWidth, state.pageSize.x());
+            if(slot == -1)
+                continue;
+
+            pageId = p;
+            shelfId = s;
+            x = slot;
+            bestWaste = waste;
+            if(!waste) break;
+        }
+    }
+
+    /* Otherwise open a new shelf at the end of the first page that has space
+       for it, or on a new page */
+    if(x == -1) {
+        for(pageId = 0; pageId != state.pages.size(); ++pageId)
+            if(state.pages[pageId].end + size.y() <= state.pageSize.y())
+                break;
+
+        if(pageId == state.pages.size()) {
+            Page& page = arrayAppend(state.pages, InPlaceInit);
+            page.end = 0;
+
+            /* Clear the contents so padding doesn't contain garbage that
+               would bleed into the images with linear filtering */
+            Containers::Array<char> zeros{ValueInit, std::size_t(state.pageSize.product()*4)};
+            const ImageView2D clear{PixelFormat::RGBA8Unorm, state.pageSize, zeros};
+            page.texture
+                .setMinificationFilter(SamplerFilter::Linear)
+                .setMagnificationFilter(SamplerFilter::Linear)
+                .setWrapping(GL::SamplerWrapping::ClampToEdge)
+                #ifndef MAGNUM_TARGET_GLES2
+                .setStorage(1, GL::TextureFormat::RGBA8, state.pageSize)
+                .setSubImage(0, {}, clear)
+                #else
+                .setImage(0, GL::TextureFormat::RGBA, clear)
+                #endif
+                ;
+        }
+
+        Page& page = state.pages[pageId];
+        shelfId = UnsignedInt(page.shelves.size());
+        arrayAppend(page.shelves, Shelf{page.end, paddedHeight, 0, 0, {}});
+        page.end += paddedHeight;
+        x = 0;
+    }
+
+    /* Take the slot */
+    Page& page = state.pages[pageId];
+    Shelf& shelf = page.shelves[shelfId];
+    if(x == shelf.end) {
+        shelf.end += paddedWidth;
+    } else for(std::size_t i = 0; i != shelf.freeSlots.size(); ++i) {
+        Containers::Pair<Int, Int>& slot = shelf.freeSlots[i];
+        if(slot.first() != x) continue;
+
+        slot.first() += paddedWidth;
+        slot.second() -= paddedWidth;
+        if(!slot.second())
+            arrayRemove(shelf.freeSlots, i);
+        break;
+    }
+    ++shelf.imageCount;
+
+    const Range2Di rectangle = Range2Di::fromSize({x, shelf.y}, size);
+    page.texture.setSubImage(0, rectangle.min(), image);
+
+    UnsignedInt id;
+    if(!state.freeIds.isEmpty()) {
+        id = state.freeIds.back();
+        arrayRemoveSuffix(state.freeIds, 1);
+    } else {
+        id = UnsignedInt(state.images.size());
+        arrayAppend(state.images, InPlaceInit);
+    }
+    state.images[id] = Image{rectangle, pageId, shelfId, true};
+    ++state.imageCount;
+
+    return id;
+}
+
+void ImageAtlas::remove(const UnsignedInt id) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.images.size() && state.images[id].used,
+        "ImGuiIntegration::ImageAtlas::remove(): image" << id << "not found", );
+
+    Image& image = state.images[id];
+    Page& page = state.pages[image.page];
+    Shelf& shelf = page.shelves[image.shelf];
+    const Int x = image.rectangle.left();
+    const Int paddedWidth = image.rectangle.sizeX() + state.padding;
+
+    /* Clear the image together with its padding, so the space is transparent
+       again for images that get placed there later. Otherwise the old
+       contents would end up in their padding or in the leftover shelf height
+       and bleed into them with linear filtering. */
+    const Range2Di padded = Math::intersect(Range2Di{{}, state.pageSize},
+        Range2Di::fromSize(image.rectangle.min(), image.rectangle.size() + Vector2i{state.padding}));
+    Containers::Array<char> zeros{ValueInit, std::size_t(padded.size().product()*4)};
+    page.texture.setSubImage(0, padded.min(), ImageView2D{PixelFormat::RGBA8Unorm, padded.size(), zeros});
+
+    /* An empty shelf is fully reusable, and if it's at the end of the page,
+       it gives the space back to the page together with any empty shelves
+       before it */
+    if(!--shelf.imageCount) {
+        shelf.end = 0;
+        arrayResize(shelf.freeSlots, 0);
+        while(!page.shelves.isEmpty() && !page.shelves.back().imageCount) {
+            page.end = page.shelves.back().y;
+            arrayRemoveSuffix(page.shelves, 1);
+        }
+
+    /* A slot at the end of the used space shrinks it, together with any free
+       slots that end up right before the end */
+    } else if(x + paddedWidth == shelf.end) {
+        shelf.end = x;
+        for(std::size_t i = 0; i != shelf.freeSlots.size(); ) {
+            const Containers::Pair<Int, Int>& slot = shelf.freeSlots[i];
+            if(slot.first() + slot.second() == shelf.end) {
+                shelf.end = slot.first();
+                arrayRemove(shelf.freeSlots, i);
+                i = 0;
+            } else ++i;
+        }
+
+    } else arrayAppend(shelf.freeSlots, InPlaceInit, x, paddedWidth);
+
+    image.used = false;
+    arrayAppend(state.freeIds, id);
+    --state.imageCount;
+}
+
+bool ImageAtlas::contains(const UnsignedInt id) const {
+    return id < _state->images.size() && _state->images[id].used;
+}
+
+UnsignedInt ImageAtlas::page(const UnsignedInt id) const {
+    CORRADE_ASSERT(contains(id),
+        "ImGuiIntegration::ImageAtlas::page(): image" << id << "not found", {});
+    return _state->images[id].page;
+}
+
+GL::Texture2D& ImageAtlas::texture(const UnsignedInt id) {
+    CORRADE_ASSERT(contains(id),
+        "ImGuiIntegration::ImageAtlas::texture(): image" << id << "not found", _state->invalidTexture);
+    return _state->pages[_state->images[id].page].texture;
+}
+
+Range2Di ImageAtlas::rectangle(const UnsignedInt id) const {
+    CORRADE_ASSERT(contains(id),
+        "ImGuiIntegration::ImageAtlas::rectangle(): image" << id << "not found", {});
+    return _state->images[id].rectangle;
+}
+
+Range2D ImageAtlas::uvRange(const UnsignedInt id) const {
+    CORRADE_ASSERT(contains(id),
+        "ImGuiIntegration::ImageAtlas::uvRange(): image" << id << "not found", {});
+    const Range2Di& rectangle = _state->images[id].rectangle;
+    const Vector2 pageSize{_state->pageSize};
+    return {Vector2{rectangle.min()}/pageSize, Vector2{rectangle.max()}/pageSize};
+}
+
+}}
@@ -0,0 +1,196 @@
+#ifndef Magnum_ImGuiIntegration_ImageAtlas_h
+#define Magnum_ImGuiIntegration_ImageAtlas_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::ImageAtlas
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Tags.h>
+#include <Magnum/GL/GL.h>
+#include <Magnum/Math/Range.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Atlas of images drawn with ImGui
+@m_since_latest_{integration}
+
+Every @ref image() or @ref imageButton() call referencing a different
+texture results in a separate draw call. For many small images, such as
+thumbnails in an asset browser, the @ref ImageAtlas packs them into a few
+large textures instead, so consecutive images from the same texture get
+merged into a single draw call:
+
+@snippet ImGuiIntegration.cpp ImageAtlas
+
+Each texture, or a page, has the same size, set in the constructor. The images
+are placed on shelves, which are rows of images that have similar height.
+Images that don't fit into any shelf open a new shelf at the bottom of a page,
+and if no page has enough space left, a new page is created. Images are
+separated by the padding passed to the constructor, which together with the
+initially transparent page contents prevents neighbor images from bleeding
+into each other with linear filtering.
+
+@section ImGuiIntegration-ImageAtlas-removal Removing images
+
+Images removed using @ref remove() leave an empty space in their shelf,
+which is then reused by images of a similar height. A shelf that becomes empty
+can be reused by images of any height that fits into it, and if it's the
+bottom one on its page, the space is returned to the page. The space of a
+removed image is cleared to transparent together with its padding, so images
+placed there later don't get the old contents bleeding in. Pages are never
+destroyed. IDs of removed images are reused by images added later.
+
+The UV ranges are in the same orientation as if each image was uploaded to a
+texture of its own. Only @ref PixelFormat::RGBA8Unorm and
+@relativeref{PixelFormat,RGBA8Srgb} images are supported, the pages are
+always @ref GL::TextureFormat::RGBA8.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT ImageAtlas {
+    public:
+        /**
+         * @brief Constructor
+         * @param pageSize  Size of a single atlas page
+         * @param padding   Empty space between images
+         *
+         * No pages are created until the first image is added. Expects that
+         * the size is non-zero and that the padding isn't negative.
+         */
+        explicit ImageAtlas(const Vector2i& pageSize = {1024, 1024}, Int padding = 1);
+
+        /**
+         * @brief Construct without creating the internal state
+         *
+         * The constructed instance is equivalent to moved-from state. Move
+         * another instance over it to make it useful.
+         */
+        explicit ImageAtlas(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ImageAtlas(const ImageAtlas&) = delete;
+
+        /** @brief Move constructor */
+        ImageAtlas(ImageAtlas&&) noexcept;
+
+        ~ImageAtlas();
+
+        /** @brief Copying is not allowed */
+        ImageAtlas& operator=(const ImageAtlas&) = delete;
+
+        /** @brief Move assignment */
+        ImageAtlas& operator=(ImageAtlas&&) noexcept;
+
+        /** @brief Page size */
+        Vector2i pageSize() const;
+
+        /** @brief Padding between images */
+        Int padding() const;
+
+        /** @brief Count of pages */
+        UnsignedInt pageCount() const;
+
+        /**
+         * @brief Page texture
+         *
+         * Expects that @p page is less than @ref pageCount().
+         */
+        GL::Texture2D& pageTexture(UnsignedInt page);
+
+        /** @brief Count of images in the atlas */
+        UnsignedInt imageCount() const;
+
+        /**
+         * @brief Add an image
+         * @return ID of the image
+         *
+         * Packs the image into an existing page or creates a new one, and
+         * uploads its contents. Expects that the image is
+         * @ref PixelFormat::RGBA8Unorm or @relativeref{PixelFormat,RGBA8Srgb}
+         * and that it's not larger than @ref pageSize().
+         */
+        UnsignedInt add(const ImageView2D& image);
+
+        /**
+         * @brief Remove an image
+         *
+         * Expects that @p id is an image that's in the atlas. See
+         * @ref ImGuiIntegration-ImageAtlas-removal for more information.
+         */
+        void remove(UnsignedInt id);
+
+        /**
+         * @brief Whether an image is in the atlas
+         *
+         * Returns @cpp false @ce if @p id wasn't returned from @ref add() or
+         * the image was removed.
+         */
+        bool contains(UnsignedInt id) const;
+
+        /**
+         * @brief Page an image is on
+         *
+         * Expects that @p id is an image that's in the atlas.
+         * @see @ref texture()
+         */
+        UnsignedInt page(UnsignedInt id) const;
+
+        /**
+         * @brief Texture an image is on
+         *
+         * Equivalent to calling @ref pageTexture() with @ref page().
+         */
+        GL::Texture2D& texture(UnsignedInt id);
+
+        /**
+         * @brief Rectangle an image occupies in its page in pixels
+         *
+         * Expects that @p id is an image that's in the atlas.
+         */
+        Range2Di rectangle(UnsignedInt id) const;
+
+        /**
+         * @brief UV range of an image
+         *
+         * The @ref rectangle() divided by @ref pageSize(), meant to be passed
+         * to @ref image() or @ref imageButton() together with @ref texture().
+         */
+        Range2D uvRange(UnsignedInt id) const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SharedResources.h"
+
+#include <Corrade/Utility/Move.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+Shaders::FlatGL2D::Configuration shaderConfiguration() {
+    return Shaders::FlatGL2D::Configuration{}
+        .setFlags(Shaders::FlatGL2D::Flag::Textured|Shaders::FlatGL2D::Flag::VertexColor);
+}
+
+}
+
+SharedResources::SharedResources(): _shader{shaderConfiguration()} {}
+
+SharedResources::SharedResources(NoCreateT) noexcept: _shader{NoCreate} {}
+
+SharedResources SharedResources::compile() {
+    SharedResources out{NoCreate};
+    out._compileState.emplace(Shaders::FlatGL2D::compile(shaderConfiguration()));
+    return out;
+}
+
+SharedResources::SharedResources(SharedResources&&) noexcept = default;
+
+SharedResources::~SharedResources() = default;
+
+SharedResources& SharedResources::operator=(SharedResources&&) noexcept = default;
+
+bool SharedResources::isReady() {
+    if(_compileState && !_compileState->isLinkFinished()) return false;
+
+    /* If the link is finished, this finalizes the shader without blocking */
+    return shader().id();
+}
+
+Shaders::FlatGL2D& SharedResources::shader() {
+    /* Blocks until the link is done, if it isn't yet */
+    if(_compileState) {
+        _shader = Shaders::FlatGL2D{Utility::move(*_compileState)};
+        _compileState = Containers::NullOpt;
+    }
+
+    return _shader;
+}
+
+SharedResources& SharedResources::setFontAtlasCacheDirectory(const Containers::StringView directory) {
+    _fontAtlasCacheDirectory = Containers::String::nullTerminatedGlobalView(directory);
+    return *this;
+}
+
+}}
@@ -0,0 +1,193 @@
+#ifndef Magnum_ImGuiIntegration_SharedResources_h
+#define Magnum_ImGuiIntegration_SharedResources_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::SharedResources
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Magnum/Shaders/FlatGL.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Resources shared by multiple contexts
+@m_since_latest_{integration}
+
+By default, each @ref Context instance compiles its own shader. If an
+application has many contexts, for example one for each tool window or render
+target, create a single @ref SharedResources instance and pass it to the
+@ref Context constructors instead. The shader is then compiled just once and
+the startup time and count of GL objects don't grow with the number of
+contexts:
+
+@snippet ImGuiIntegration.cpp SharedResources
+
+The contexts only reference the instance, so it has to stay in scope for as
+long as any context using it exists. Moving the instance to a different
+location while contexts reference it isn't allowed either. All contexts have
+to be used with the same OpenGL context the resources were created in, or
+with one that shares objects with it.
+
+@section ImGuiIntegration-SharedResources-async Asynchronous shader compilation
+
+The default constructor blocks until the shader is compiled and linked, which
+can cause a visible stall if an application is already showing something at
+the time. Create the instance with @ref compile() instead to only submit the
+shader for compilation and finish it later. If the driver supports
+@gl_extension{KHR,parallel_shader_compile}, the compilation happens on a
+background thread:
+
+@snippet ImGuiIntegration.cpp SharedResources-async
+
+Until @ref isReady() returns @cpp true @ce, @ref Context::drawFrame() skips
+drawing for contexts using the instance, but still processes the frame, so
+the UI state and font textures are all set up by the time the shader is ready.
+Calling @ref shader() waits for the compilation to finish, so the stall is only
+paid if something actually needs the shader before it's ready.
+
+@section ImGuiIntegration-SharedResources-font-atlas-cache Font atlas cache
+
+With Dear ImGui versions before 1.92, the whole font atlas is rasterized
+upfront when a @ref Context is created and every time the supersampling ratio
+changes, which can take a significant time with large fonts and glyph ranges.
+If a cache directory is set using @ref setFontAtlasCacheDirectory() before
+creating contexts, the rasterized atlas together with glyph metrics is saved
+there and loaded on the next run instead of rasterizing it again:
+
+@snippet ImGuiIntegration.cpp SharedResources-font-atlas-cache
+
+The cache file is picked based on contents of the font files, font sizes,
+glyph ranges and other font and atlas options together with the supersampling
+ratio and Dear ImGui version, so any change results in the atlas being
+rasterized and saved again. Stale files aren't deleted. Atlases containing
+custom glyphs added through @cpp ImFontAtlas::AddCustomRectFontGlyph() @ce
+aren't cached. The cache is only implemented for Dear ImGui 1.90 and 1.91,
+with 1.92 and newer the glyphs are rasterized on demand and can be
+rasterized ahead of time with @ref Context::prewarmGlyphs() instead.
+@see @ref ImGuiIntegration-Context-multiple-contexts
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT SharedResources {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Compiles the shader used for drawing. Expects that an OpenGL
+         * context is current.
+         */
+        explicit SharedResources();
+
+        /**
+         * @brief Construct without creating the internal OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * for deferring the initialization to a later point, for example if
+         * the OpenGL context is not yet created. Move another instance over it
+         * to make it useful.
+         */
+        explicit SharedResources(NoCreateT) noexcept;
+
+        /**
+         * @brief Compile asynchronously
+         *
+         * Submits the shader for compilation but doesn't wait for it to
+         * finish. Use @ref isReady() to check whether the shader can be used.
+         * Expects that an OpenGL context is current. See
+         * @ref ImGuiIntegration-SharedResources-async for more information.
+         */
+        static SharedResources compile();
+
+        /** @brief Copying is not allowed */
+        SharedResources(const SharedResources&) = delete;
+
+        /** @brief Move constructor */
+        SharedResources(SharedResources&&) noexcept;
+
+        ~SharedResources();
+
+        /** @brief Copying is not allowed */
+        SharedResources& operator=(const SharedResources&) = delete;
+
+        /** @brief Move assignment */
+        SharedResources& operator=(SharedResources&&) noexcept;
+
+        /**
+         * @brief Whether the shader is ready for use
+         *
+         * Returns @cpp true @ce if the shader is compiled and linked. Always
+         * @cpp true @ce for instances created with the default constructor,
+         * @cpp false @ce for instances created with the
+         * @ref SharedResources(NoCreateT) constructor. For instances created
+         * with @ref compile() returns @cpp false @ce until the driver finishes
+         * linking the shader, but never blocks.
+         */
+        bool isReady();
+
+        /**
+         * @brief Shader used for drawing
+         *
+         * A @ref Shaders::FlatGL2D with @ref Shaders::FlatGL2D::Flag::Textured
+         * and @relativeref{Shaders::FlatGL2D::Flag,VertexColor} enabled. If
+         * the instance was created with @ref compile() and the shader isn't
+         * ready yet, waits until the compilation finishes.
+         * @see @ref isReady()
+         */
+        Shaders::FlatGL2D& shader();
+
+        /**
+         * @brief Font atlas cache directory
+         *
+         * Empty by default, meaning no caching is done.
+         */
+        Containers::StringView fontAtlasCacheDirectory() const { return _fontAtlasCacheDirectory; }
+
+        /**
+         * @brief Set font atlas cache directory
+         * @return Reference to self (for method chaining)
+         *
+         * The directory is created if it doesn't exist. Affects contexts
+         * created and relayouted after this call. Pass an empty string to
+         * disable the cache. See
+         * @ref ImGuiIntegration-SharedResources-font-atlas-cache for more
+         * information.
+         */
+        SharedResources& setFontAtlasCacheDirectory(Containers::StringView directory);
+
+    private:
+        Shaders::FlatGL2D _shader;
+        Containers::Optional<Shaders::FlatGL2D::CompileState> _compileState;
+        Containers::String _fontAtlasCacheDirectory;
+};
+
+}}
+
+#endif
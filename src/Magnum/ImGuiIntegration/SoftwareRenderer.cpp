@@ -0,0 +1,661 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SoftwareRenderer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Packing.h>
+#include <Magnum/Math/Range.h>
+
+#ifdef CORRADE_TARGET_SSE2
+#include <Corrade/Utility/IntrinsicsSse2.h>
+#endif
+
+#include "Magnum/ImGuiIntegration/CommandList.h"
+#include "Magnum/ImGuiIntegration/Integration.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+/* Vertex positions are snapped to 1/16th of a pixel and edge functions are
+   evaluated with 64-bit integers, which makes the coverage test exact and
+   consistent between neighboring triangles */
+constexpr Int SubpixelBits = 4;
+constexpr Long SubpixelOne = 1 << SubpixelBits;
+
+/* ImGui can produce vertices far outside of the display, clamp them to a
+   range where products of two coordinates still fit into 64 bits */
+constexpr Float MaxCoordinate = Float(1 << 24);
+
+struct Texture {
+    Containers::Array<Color4ub> data;
+    Vector2i size;
+    SamplerFilter filter;
+};
+
+struct Vertex {
+    Long x, y;
+    Vector2 uv;
+    Color4 color;
+};
+
+struct Triangle {
+    /* Edge functions are a*x + b*y + c for each edge, positive inside */
+    Long a[3], b[3], c[3];
+    Float inverseArea;
+    UnsignedInt vertices[3];
+    Range2Di bounds;
+    const Texture* texture;
+    /* If all vertices have the same color and texture coordinates, the
+       triangle is filled with this color without interpolating anything */
+    bool constant;
+    Color4ub constantColor;
+};
+
+#if IMGUI_VERSION_NUM >= 19131
+inline ImTextureID textureIdForIndex(const std::size_t index) {
+    return ImTextureID(index + 1);
+}
+
+inline std::size_t textureIndexForId(const ImTextureID id) {
+    return std::size_t(id) - 1;
+}
+#else
+inline ImTextureID textureIdForIndex(const std::size_t index) {
+    return reinterpret_cast<ImTextureID>(std::uintptr_t(index + 1));
+}
+
+inline std::size_t textureIndexForId(const ImTextureID id) {
+    return std::size_t(reinterpret_cast<std::uintptr_t>(id)) - 1;
+}
+#endif
+
+inline Long floorDivide(const Long a, const Long b) {
+    return a >= 0 ? a/b : -((-a + b - 1)/b);
+}
+
+/* Exact rounded division by 255 for values up to 255*255 */
+inline UnsignedInt divide255(const UnsignedInt value) {
+    return (value + 128 + ((value + 128) >> 8)) >> 8;
+}
+
+/* Source alpha, one minus source alpha blending, the same for the alpha
+   channel as well */
+inline void blend(Color4ub& destination, const Color4ub source) {
+    const UnsignedInt alpha = source.a();
+    const UnsignedInt inverseAlpha = 255 - alpha;
+    destination.r() = divide255(source.r()*alpha + destination.r()*inverseAlpha);
+    destination.g() = divide255(source.g()*alpha + destination.g()*inverseAlpha);
+    destination.b() = divide255(source.b()*alpha + destination.b()*inverseAlpha);
+    destination.a() = divide255(alpha*alpha + destination.a()*inverseAlpha);
+}
+
+/* Blends a single color over a contiguous span of pixels, which is what the
+   vast majority of ImGui geometry, rectangles and text backgrounds, ends up
+   being */
+void fillSpan(Color4ub* const out, const std::size_t count, const Color4ub color) {
+    const UnsignedInt alpha = color.a();
+    if(!alpha) return;
+    if(alpha == 255) {
+        for(std::size_t i = 0; i != count; ++i) out[i] = color;
+        return;
+    }
+
+    const UnsignedInt inverseAlpha = 255 - alpha;
+    const UnsignedInt red = color.r()*alpha;
+    const UnsignedInt green = color.g()*alpha;
+    const UnsignedInt blue = color.b()*alpha;
+    const UnsignedInt alphaAlpha = alpha*alpha;
+    std::size_t i = 0;
+
+    #ifdef CORRADE_TARGET_SSE2
+    /* Four pixels at a time, with each channel widened to 16 bits. The sum
+       of the source and destination terms is at most 255*255, so together
+       with the rounding it still fits into an unsigned 16-bit value. */
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i source = _mm_set_epi16(
+        alphaAlpha, blue, green, red, alphaAlpha, blue, green, red);
+    const __m128i inverse = _mm_set1_epi16(inverseAlpha);
+    const __m128i half = _mm_set1_epi16(128);
+    for(; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(out + i));
+        __m128i low = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), inverse), source), half);
+        __m128i high = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), inverse), source), half);
+        low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        Color4ub& pixel = out[i];
+        pixel.r() = divide255(red + pixel.r()*inverseAlpha);
+        pixel.g() = divide255(green + pixel.g()*inverseAlpha);
+        pixel.b() = divide255(blue + pixel.b()*inverseAlpha);
+        pixel.a() = divide255(alphaAlpha + pixel.a()*inverseAlpha);
+    }
+}
+
+/* Clamp-to-edge sampling with texel centers at half-integer coordinates, as
+   in OpenGL */
+Color4 sample(const Texture& texture, const Vector2& uv) {
+    const Vector2i size = texture.size;
+    const Vector2 position = uv*Vector2{size};
+
+    if(texture.filter == SamplerFilter::Nearest) {
+        const Vector2i texel = Math::clamp(Vector2i{Math::floor(position)}, Vector2i{0}, size - Vector2i{1});
+        return Math::unpack<Color4>(texture.data[texel.y()*size.x() + texel.x()]);
+    }
+
+    const Vector2 shifted = position - Vector2{0.5f};
+    const Vector2 floored = Math::floor(shifted);
+    const Vector2 factor = shifted - floored;
+    const Vector2i min = Math::clamp(Vector2i{floored}, Vector2i{0}, size - Vector2i{1});
+    const Vector2i max = Math::clamp(Vector2i{floored} + Vector2i{1}, Vector2i{0}, size - Vector2i{1});
+    const Color4 a = Math::unpack<Color4>(texture.data[min.y()*size.x() + min.x()]);
+    const Color4 b = Math::unpack<Color4>(texture.data[min.y()*size.x() + max.x()]);
+    const Color4 c = Math::unpack<Color4>(texture.data[max.y()*size.x() + min.x()]);
+    const Color4 d = Math::unpack<Color4>(texture.data[max.y()*size.x() + max.x()]);
+    return Math::lerp(Math::lerp(a, b, factor.x()), Math::lerp(c, d, factor.x()), factor.y());
+}
+
+/* Rows of the output are expected to be top to bottom */
+void rasterize(const Triangle& triangle, const Range2Di& clip, const Containers::ArrayView<const Vertex> vertices, const Containers::StridedArrayView2D<Color4ub>& pixels) {
+    const Range2Di bounds = Math::intersect(triangle.bounds, clip);
+    if(!(bounds.size() > Vector2i{0}).all()) return;
+
+    const Vertex& v0 = vertices[triangle.vertices[0]];
+    const Vertex& v1 = vertices[triangle.vertices[1]];
+    const Vertex& v2 = vertices[triangle.vertices[2]];
+
+    for(Int y = bounds.min().y(); y != bounds.max().y(); ++y) {
+        const Long pixelY = y*SubpixelOne + SubpixelOne/2;
+        const Long pixelX = bounds.min().x()*SubpixelOne + SubpixelOne/2;
+        Long w[3];
+        Long step[3];
+        for(std::size_t i = 0; i != 3; ++i) {
+            w[i] = triangle.a[i]*pixelX + triangle.b[i]*pixelY + triangle.c[i];
+            step[i] = triangle.a[i]*SubpixelOne;
+        }
+
+        /* The triangle is convex, so the covered pixels in a row form a
+           single span. Find its start and end. */
+        Int x = bounds.min().x();
+        for(; x != bounds.max().x(); ++x) {
+            if((w[0] | w[1] | w[2]) >= 0) break;
+            w[0] += step[0];
+            w[1] += step[1];
+            w[2] += step[2];
+        }
+        const Int begin = x;
+        Long spanW[3]{w[0], w[1], w[2]};
+        for(; x != bounds.max().x(); ++x) {
+            if((spanW[0] | spanW[1] | spanW[2]) < 0) break;
+            spanW[0] += step[0];
+            spanW[1] += step[1];
+            spanW[2] += step[2];
+        }
+        const Int end = x;
+        if(begin == end) continue;
+
+        Color4ub* const row = &pixels[y][begin];
+        if(triangle.constant) {
+            fillSpan(row, end - begin, triangle.constantColor);
+            continue;
+        }
+
+        for(Int i = 0; i != end - begin; ++i) {
+            /* Edge i is opposite to vertex i */
+            const Float l0 = Float(w[0])*triangle.inverseArea;
+            const Float l1 = Float(w[1])*triangle.inverseArea;
+            const Float l2 = 1.0f - l0 - l1;
+            Color4 color = v0.color*l0 + v1.color*l1 + v2.color*l2;
+            if(triangle.texture)
+                color *= sample(*triangle.texture, v0.uv*l0 + v1.uv*l1 + v2.uv*l2);
+            blend(row[i], Math::pack<Color4ub>(Math::clamp(color, 0.0f, 1.0f)));
+            w[0] += step[0];
+            w[1] += step[1];
+        }
+    }
+}
+
+}
+
+struct SoftwareRenderer::State {
+    UnsignedInt threadCount = 1;
+    Vector2i tileSize{64};
+
+    /* Index is the texture ID minus one, removed textures have an empty
+       size */
+    Containers::Array<Texture> textures;
+    std::size_t textureCount = 0;
+
+    /* Reused across draw() calls */
+    CommandList commandList{};
+    Containers::Array<Vertex> vertices;
+    Containers::Array<UnsignedInt> drawListVertexOffsets;
+    Containers::Array<Triangle> triangles;
+    Containers::Array<Containers::Array<UnsignedInt>> tiles;
+
+    /* Worker threads, kept alive between draw() calls and woken up by
+       incrementing the generation. The calling thread then waits until
+       busyWorkers drops back to zero. */
+    Containers::Array<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workAvailable, workDone;
+    std::size_t generation = 0;
+    std::size_t busyWorkers = 0;
+    bool quit = false;
+
+    /* Work of the current generation, set up before waking the workers */
+    Containers::StridedArrayView2D<Color4ub> pixels;
+    Range2Di imageRect;
+    Vector2i tileCount;
+    std::atomic<std::size_t> nextTile{0};
+
+    ~State() { stopWorkers(); }
+
+    void startWorkers(std::size_t count);
+    void stopWorkers();
+    void workerLoop(std::size_t seenGeneration);
+    void drawTiles();
+};
+
+void SoftwareRenderer::State::startWorkers(const std::size_t count) {
+    /* Nothing is in flight at this point, so the generation can be read
+       without a lock */
+    workers = Containers::Array<std::thread>{ValueInit, count};
+    for(std::thread& worker: workers)
+        worker = std::thread{&State::workerLoop, this, generation};
+}
+
+void SoftwareRenderer::State::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        quit = true;
+    }
+    workAvailable.notify_all();
+    for(std::thread& worker: workers)
+        worker.join();
+    workers = {};
+    quit = false;
+}
+
+void SoftwareRenderer::State::workerLoop(std::size_t seenGeneration) {
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            workAvailable.wait(lock, [&]{
+                return quit || generation != seenGeneration;
+            });
+            if(quit) return;
+            seenGeneration = generation;
+        }
+
+        drawTiles();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            last = --busyWorkers == 0;
+        }
+        if(last) workDone.notify_one();
+    }
+}
+
+void SoftwareRenderer::State::drawTiles() {
+    for(;;) {
+        const std::size_t tile = nextTile++;
+        if(tile >= tiles.size()) return;
+
+        const Vector2i tilePosition{Int(tile % tileCount.x()), Int(tile/tileCount.x())};
+        const Range2Di tileRect = Math::intersect(imageRect,
+            Range2Di::fromSize(tilePosition*tileSize, tileSize));
+        for(const UnsignedInt triangle: tiles[tile])
+            rasterize(triangles[triangle], tileRect, vertices, pixels);
+    }
+}
+
+namespace {
+
+std::size_t addTextureSlot(Containers::Array<Texture>& textures) {
+    for(std::size_t i = 0; i != textures.size(); ++i)
+        if(textures[i].size.isZero()) return i;
+    arrayAppend(textures, InPlaceInit);
+    return textures.size() - 1;
+}
+
+#ifdef IMGUI_HAS_TEXTURES
+void copyTextureRegion(Texture& out, ImTextureData& texture, const Range2Di& region) {
+    for(Int y = region.min().y(); y != region.max().y(); ++y) {
+        const UnsignedByte* in = static_cast<const UnsignedByte*>(texture.GetPixelsAt(region.min().x(), y));
+        Color4ub* const row = out.data + y*out.size.x();
+        if(texture.Format == ImTextureFormat_RGBA32) {
+            for(Int x = region.min().x(); x != region.max().x(); ++x, in += 4)
+                row[x] = Color4ub{in[0], in[1], in[2], in[3]};
+        } else {
+            /* Matches the swizzle Context sets up for single-channel
+               textures */
+            for(Int x = region.min().x(); x != region.max().x(); ++x, ++in)
+                row[x] = Color4ub{255, 255, 255, *in};
+        }
+    }
+}
+#endif
+
+}
+
+SoftwareRenderer::SoftwareRenderer(): _state{InPlaceInit} {}
+
+SoftwareRenderer::SoftwareRenderer(SoftwareRenderer&&) noexcept = default;
+
+SoftwareRenderer::~SoftwareRenderer() = default;
+
+SoftwareRenderer& SoftwareRenderer::operator=(SoftwareRenderer&&) noexcept = default;
+
+UnsignedInt SoftwareRenderer::threadCount() const {
+    return _state->threadCount;
+}
+
+SoftwareRenderer& SoftwareRenderer::setThreadCount(const UnsignedInt count) {
+    CORRADE_ASSERT(count,
+        "ImGuiIntegration::SoftwareRenderer::setThreadCount(): expected a non-zero count", *this);
+    /* The workers get created again on the next draw() */
+    if(count != _state->threadCount)
+        _state->stopWorkers();
+    _state->threadCount = count;
+    return *this;
+}
+
+Vector2i SoftwareRenderer::tileSize() const {
+    return _state->tileSize;
+}
+
+SoftwareRenderer& SoftwareRenderer::setTileSize(const Vector2i& size) {
+    CORRADE_ASSERT((size > Vector2i{0}).all(),
+        "ImGuiIntegration::SoftwareRenderer::setTileSize(): expected a positive size, got" << Debug::packed << size, *this);
+    _state->tileSize = size;
+    return *this;
+}
+
+std::size_t SoftwareRenderer::textureCount() const {
+    return _state->textureCount;
+}
+
+ImTextureID SoftwareRenderer::addTexture(const ImageView2D& image, const SamplerFilter filter) {
+    const PixelFormat format = image.format();
+    const bool rgba = format == PixelFormat::RGBA8Unorm || format == PixelFormat::RGBA8Srgb;
+    CORRADE_ASSERT(rgba || format == PixelFormat::RGB8Unorm || format == PixelFormat::RGB8Srgb,
+        "ImGuiIntegration::SoftwareRenderer::addTexture(): expected an RGBA8 or RGB8 image, got" << format, {});
+    CORRADE_ASSERT(image.size().product(),
+        "ImGuiIntegration::SoftwareRenderer::addTexture(): expected a non-empty image", {});
+
+    State& state = *_state;
+    const std::size_t index = addTextureSlot(state.textures);
+    Texture& texture = state.textures[index];
+    texture.size = image.size();
+    texture.filter = filter;
+    texture.data = Containers::Array<Color4ub>{NoInit, std::size_t(image.size().product())};
+
+    const Containers::StridedArrayView2D<Color4ub> out{texture.data, {std::size_t(image.size().y()), std::size_t(image.size().x())}};
+    if(rgba) {
+        const Containers::StridedArrayView2D<const Color4ub> in = image.pixels<Color4ub>();
+        for(std::size_t y = 0; y != out.size()[0]; ++y)
+            for(std::size_t x = 0; x != out.size()[1]; ++x)
+                out[y][x] = in[y][x];
+    } else {
+        const Containers::StridedArrayView2D<const Color3ub> in = image.pixels<Color3ub>();
+        for(std::size_t y = 0; y != out.size()[0]; ++y)
+            for(std::size_t x = 0; x != out.size()[1]; ++x)
+                out[y][x] = Color4ub{in[y][x], 255};
+    }
+
+    ++state.textureCount;
+    return textureIdForIndex(index);
+}
+
+void SoftwareRenderer::removeTexture(const ImTextureID id) {
+    State& state = *_state;
+    const std::size_t index = textureIndexForId(id);
+    CORRADE_ASSERT(index < state.textures.size() && !state.textures[index].size.isZero(),
+        "ImGuiIntegration::SoftwareRenderer::removeTexture(): texture" << id << "not found", );
+    state.textures[index].data = nullptr;
+    state.textures[index].size = {};
+    --state.textureCount;
+}
+
+void SoftwareRenderer::draw(ImDrawData& drawData, const MutableImageView2D& image) {
+    CORRADE_ASSERT(image.format() == PixelFormat::RGBA8Unorm || image.format() == PixelFormat::RGBA8Srgb,
+        "ImGuiIntegration::SoftwareRenderer::draw(): expected an RGBA8 image, got" << image.format(), );
+
+    State& state = *_state;
+    const CommandList& commandList = state.commandList.build(drawData);
+
+    #ifdef IMGUI_HAS_TEXTURES
+    for(const CommandListTexture& request: commandList.textures()) {
+        ImTextureData& texture = *request.texture;
+
+        if(request.operation == CommandListTextureOperation::Destroy) {
+            const std::size_t index = textureIndexForId(texture.GetTexID());
+            CORRADE_INTERNAL_ASSERT(index < state.textures.size());
+            state.textures[index].data = nullptr;
+            state.textures[index].size = {};
+            --state.textureCount;
+            texture.SetTexID(ImTextureID_Invalid);
+            texture.SetStatus(ImTextureStatus_Destroyed);
+            continue;
+        }
+
+        CORRADE_INTERNAL_ASSERT(texture.Format == ImTextureFormat_Alpha8 || texture.Format == ImTextureFormat_RGBA32);
+        std::size_t index;
+        if(request.operation == CommandListTextureOperation::Create) {
+            index = addTextureSlot(state.textures);
+            Texture& out = state.textures[index];
+            out.size = {texture.Width, texture.Height};
+            out.filter = SamplerFilter::Linear;
+            out.data = Containers::Array<Color4ub>{NoInit, std::size_t(out.size.product())};
+            ++state.textureCount;
+            texture.SetTexID(textureIdForIndex(index));
+        } else index = textureIndexForId(texture.GetTexID());
+
+        CORRADE_INTERNAL_ASSERT(index < state.textures.size());
+        for(const Range2Di& region: commandList.textureRegions().sliceSize(request.regionOffset, request.regionCount))
+            copyTextureRegion(state.textures[index], texture, region);
+        texture.SetStatus(ImTextureStatus_OK);
+    }
+    #endif
+
+    /* Transform all vertices to the framebuffer space once, with the
+       positions in fixed point */
+    arrayRemoveSuffix(state.vertices, state.vertices.size());
+    arrayRemoveSuffix(state.drawListVertexOffsets, state.drawListVertexOffsets.size());
+    const Vector2 displayPosition{drawData.DisplayPos};
+    const Vector2 scale = Vector2{drawData.FramebufferScale}*Float(SubpixelOne);
+    for(std::int_fast32_t n = 0; n < drawData.CmdLists.Size; ++n) {
+        arrayAppend(state.drawListVertexOffsets, UnsignedInt(state.vertices.size()));
+        for(const ImDrawVert& vertex: drawData.CmdLists[n]->VtxBuffer) {
+            const Vector2 position = Math::clamp((Vector2{vertex.pos} - displayPosition)*scale, -MaxCoordinate, MaxCoordinate);
+            Vertex& out = arrayAppend(state.vertices, InPlaceInit);
+            out.x = Long(Math::round(position.x()));
+            out.y = Long(Math::round(position.y()));
+            out.uv = Vector2{vertex.uv};
+            out.color = Math::unpack<Color4>(Color4ub{
+                UnsignedByte(vertex.col >> IM_COL32_R_SHIFT),
+                UnsignedByte(vertex.col >> IM_COL32_G_SHIFT),
+                UnsignedByte(vertex.col >> IM_COL32_B_SHIFT),
+                UnsignedByte(vertex.col >> IM_COL32_A_SHIFT)});
+        }
+    }
+
+    /* Set up all triangles. The scissor rectangles are in framebuffer pixels
+       with the origin at the top left, the same as the rasterization. */
+    arrayRemoveSuffix(state.triangles, state.triangles.size());
+    const Range2Di imageRect{{}, image.size()};
+    for(const CommandListBatch& batch: commandList.batches()) {
+        if(batch.callback) continue;
+
+        #ifdef IMGUI_HAS_TEXTURES
+        const ImTextureID id = batch.texture.GetTexID();
+        #else
+        const ImTextureID id = batch.texture;
+        #endif
+        const std::size_t textureIndex = textureIndexForId(id);
+        CORRADE_ASSERT(textureIndex < state.textures.size() && !state.textures[textureIndex].size.isZero(),
+            "ImGuiIntegration::SoftwareRenderer::draw(): texture" << id << "not found", );
+        const Texture& texture = state.textures[textureIndex];
+
+        const Range2Di scissor = Math::intersect(batch.scissor, imageRect);
+        if(!(scissor.size() > Vector2i{0}).all()) continue;
+
+        const ImDrawList& drawList = *drawData.CmdLists[batch.drawList];
+        const UnsignedInt vertexOffset = state.drawListVertexOffsets[batch.drawList];
+        for(const CommandListDraw& draw: commandList.draws().sliceSize(batch.drawOffset, batch.drawCount)) {
+            for(UnsignedInt i = 0; i + 3 <= draw.indexCount; i += 3) {
+                UnsignedInt indices[3];
+                for(std::size_t j = 0; j != 3; ++j)
+                    indices[j] = vertexOffset + draw.baseVertex + drawList.IdxBuffer[draw.indexOffset + i + j];
+
+                /* Make the triangle counterclockwise in the Y-down space, i.e.
+                   with a positive area, so the edge functions are positive
+                   inside. Skip degenerate triangles. */
+                Long area = (state.vertices[indices[1]].x - state.vertices[indices[0]].x)*(state.vertices[indices[2]].y - state.vertices[indices[0]].y) - (state.vertices[indices[1]].y - state.vertices[indices[0]].y)*(state.vertices[indices[2]].x - state.vertices[indices[0]].x);
+                if(!area) continue;
+                if(area < 0) {
+                    std::swap(indices[1], indices[2]);
+                    area = -area;
+                }
+
+                const Vertex* v[3]{
+                    &state.vertices[indices[0]],
+                    &state.vertices[indices[1]],
+                    &state.vertices[indices[2]]
+                };
+
+                /* Pixel centers covered by the bounding box, clipped to the
+                   scissor rectangle */
+                const Long minX = Math::min({v[0]->x, v[1]->x, v[2]->x});
+                const Long minY = Math::min({v[0]->y, v[1]->y, v[2]->y});
+                const Long maxX = Math::max({v[0]->x, v[1]->x, v[2]->x});
+                const Long maxY = Math::max({v[0]->y, v[1]->y, v[2]->y});
+                const Range2Di bounds{
+                    {Int(Math::clamp<Long>(floorDivide(minX + SubpixelOne/2 - 1, SubpixelOne), scissor.min().x(), scissor.max().x())),
+                     Int(Math::clamp<Long>(floorDivide(minY + SubpixelOne/2 - 1, SubpixelOne), scissor.min().y(), scissor.max().y()))},
+                    {Int(Math::clamp<Long>(floorDivide(maxX - SubpixelOne/2, SubpixelOne) + 1, scissor.min().x(), scissor.max().x())),
+                     Int(Math::clamp<Long>(floorDivide(maxY - SubpixelOne/2, SubpixelOne) + 1, scissor.min().y(), scissor.max().y()))}};
+                if(!(bounds.size() > Vector2i{0}).all()) continue;
+
+                Triangle& triangle = arrayAppend(state.triangles, InPlaceInit);
+                for(std::size_t j = 0; j != 3; ++j) {
+                    /* Edge j goes from vertex j + 1 to vertex j + 2, i.e. is
+                       opposite to vertex j. Pixel centers exactly on an
+                       edge are included only for top and left edges, so
+                       pixels on edges shared by two triangles are drawn only
+                       once. */
+                    const Vertex& from = *v[(j + 1) % 3];
+                    const Vertex& to = *v[(j + 2) % 3];
+                    const Long dx = to.x - from.x;
+                    const Long dy = to.y - from.y;
+                    triangle.a[j] = -dy;
+                    triangle.b[j] = dx;
+                    triangle.c[j] = dy*from.x - dx*from.y - (dy > 0 || (dy == 0 && dx < 0) ? 0 : 1);
+                    triangle.vertices[j] = indices[j];
+                }
+                triangle.inverseArea = 1.0f/Float(area);
+                triangle.bounds = bounds;
+                triangle.texture = &texture;
+                triangle.constant =
+                    v[0]->color == v[1]->color && v[0]->color == v[2]->color &&
+                    v[0]->uv == v[1]->uv && v[0]->uv == v[2]->uv;
+                if(triangle.constant)
+                    triangle.constantColor = Math::pack<Color4ub>(Math::clamp(v[0]->color*sample(texture, v[0]->uv), 0.0f, 1.0f));
+            }
+        }
+    }
+
+    /* Rasterization works with the origin at the top left, while the first
+       row of the image is the bottom one */
+    const Containers::StridedArrayView2D<Color4ub> pixels = image.pixels<Color4ub>().flipped<0>();
+    const Containers::ArrayView<const Vertex> vertices = state.vertices;
+
+    if(state.threadCount == 1) {
+        for(const Triangle& triangle: state.triangles)
+            rasterize(triangle, imageRect, vertices, pixels);
+        return;
+    }
+
+    /* Sort triangles into tiles they overlap, in the original order. Empty
+       tiles don't need any work from the threads. */
+    const Vector2i tileCount = (image.size() + state.tileSize - Vector2i{1})/state.tileSize;
+    arrayResize(state.tiles, tileCount.product());
+    for(Containers::Array<UnsignedInt>& tile: state.tiles)
+        arrayRemoveSuffix(tile, tile.size());
+    for(std::size_t i = 0; i != state.triangles.size(); ++i) {
+        const Range2Di& bounds = state.triangles[i].bounds;
+        const Vector2i min = bounds.min()/state.tileSize;
+        const Vector2i max = (bounds.max() - Vector2i{1})/state.tileSize;
+        for(Int y = min.y(); y <= max.y(); ++y)
+            for(Int x = min.x(); x <= max.x(); ++x)
+                arrayAppend(state.tiles[y*tileCount.x() + x], UnsignedInt(i));
+    }
+
+    if(state.workers.size() != state.threadCount - 1) {
+        state.stopWorkers();
+        state.startWorkers(state.threadCount - 1);
+    }
+
+    state.pixels = pixels;
+    state.imageRect = imageRect;
+    state.tileCount = tileCount;
+    state.nextTile = 0;
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        state.busyWorkers = state.workers.size();
+        ++state.generation;
+    }
+    state.workAvailable.notify_all();
+
+    /* The calling thread is one of the workers as well */
+    state.drawTiles();
+
+    std::unique_lock<std::mutex> lock{state.mutex};
+    state.workDone.wait(lock, [&]{ return state.busyWorkers == 0; });
+}
+
+}}
@@ -0,0 +1,191 @@
+#ifndef Magnum_ImGuiIntegration_SoftwareRenderer_h
+#define Magnum_ImGuiIntegration_SoftwareRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::SoftwareRenderer
+ * @m_since_latest_{integration}
+ */
+
+#include "Magnum/ImGuiIntegration/visibility.h" /* defines IMGUI_API */
+
+#include <imgui.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Sampler.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Software renderer
+@m_since_latest_{integration}
+
+Rasterizes @cpp ImDrawData @ce into a CPU-side image, without needing any GPU
+API. Useful for rendering the UI in headless environments, in automated tests
+or on a server. Unlike @ref Context it doesn't handle input or manage the ImGui
+context, the application sets up the ImGui context and the frame itself:
+
+@snippet ImGuiIntegration.cpp SoftwareRenderer
+
+The output matches what @ref Context::drawFrame() renders with OpenGL and the
+blending set up as described in @ref ImGuiIntegration-Context-usage-rendering,
+up to rounding differences on triangle edges. Pixel centers are sampled with
+4 bits of subpixel precision and edges shared by two triangles are never
+rasterized twice. Vertex colors and texture coordinates are interpolated
+across the triangle and textures are sampled with clamp-to-edge wrapping.
+
+@section ImGuiIntegration-SoftwareRenderer-textures Textures
+
+On ImGui 1.92 and newer, the renderer processes texture requests in
+@cpp ImDrawData::Textures @ce on its own, keeping a CPU copy of each texture,
+and it should be advertised with @cpp ImGuiBackendFlags_RendererHasTextures @ce.
+On older versions, the font atlas has to be added with @ref addTexture() and
+its ID passed to @cpp ImFontAtlas::SetTexID() @ce. Any other images drawn with
+@cpp ImGui::Image() @ce and similar APIs are added with @ref addTexture() in
+both cases.
+
+@section ImGuiIntegration-SoftwareRenderer-threads Multithreaded rendering
+
+By default, everything is drawn on the calling thread. With
+@ref setThreadCount() greater than @cpp 1 @ce, the output is split into tiles
+of @ref tileSize(), triangles are sorted into tiles they overlap and the tiles
+are then drawn in parallel, with the calling thread being one of the workers.
+As each tile is drawn by just one thread with triangles in their original
+order, the output is the same regardless of the thread count. The worker
+threads are created on the first @ref draw() and then reused for subsequent
+calls until the thread count changes or the renderer is destroyed.
+
+@section ImGuiIntegration-SoftwareRenderer-limitations Limitations
+
+User callbacks set with @cpp ImDrawList::AddCallback() @ce are ignored,
+including @cpp ImDrawCallback_ResetRenderState @ce, as there's no render state
+to reset.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT SoftwareRenderer {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Draws on a single thread with tiles of 64x64 pixels by default.
+         */
+        explicit SoftwareRenderer();
+
+        /** @brief Copying is not allowed */
+        SoftwareRenderer(const SoftwareRenderer&) = delete;
+
+        /** @brief Move constructor */
+        SoftwareRenderer(SoftwareRenderer&&) noexcept;
+
+        ~SoftwareRenderer();
+
+        /** @brief Copying is not allowed */
+        SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+        /** @brief Move assignment */
+        SoftwareRenderer& operator=(SoftwareRenderer&&) noexcept;
+
+        /** @brief Thread count */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Set thread count
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p count is not zero. See
+         * @ref ImGuiIntegration-SoftwareRenderer-threads for more
+         * information.
+         */
+        SoftwareRenderer& setThreadCount(UnsignedInt count);
+
+        /** @brief Tile size */
+        Vector2i tileSize() const;
+
+        /**
+         * @brief Set tile size
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the size is positive. Used only if
+         * @ref threadCount() is greater than @cpp 1 @ce.
+         */
+        SoftwareRenderer& setTileSize(const Vector2i& size);
+
+        /**
+         * @brief Count of textures
+         *
+         * Includes textures added with @ref addTexture() as well as textures
+         * created by ImGui on version 1.92 and newer.
+         */
+        std::size_t textureCount() const;
+
+        /**
+         * @brief Add a texture
+         * @param image     Image to copy the texture data from
+         * @param filter    Filtering to use when sampling the texture
+         * @return ID to use in ImGui APIs
+         *
+         * Expects that @p image is @ref PixelFormat::RGBA8Unorm,
+         * @ref PixelFormat::RGBA8Srgb, @ref PixelFormat::RGB8Unorm or
+         * @ref PixelFormat::RGB8Srgb. The data are copied, the image doesn't
+         * need to stay alive afterwards. The first row of the image is the
+         * top row of the texture, the same as with an image uploaded to an
+         * OpenGL texture and drawn with @ref Context.
+         */
+        ImTextureID addTexture(const ImageView2D& image, SamplerFilter filter = SamplerFilter::Linear);
+
+        /**
+         * @brief Remove a texture
+         *
+         * Expects that @p id was returned from @ref addTexture() and wasn't
+         * removed yet. The ID may get reused by subsequently added textures.
+         */
+        void removeTexture(ImTextureID id);
+
+        /**
+         * @brief Draw
+         *
+         * Expects that @p image is @ref PixelFormat::RGBA8Unorm or
+         * @ref PixelFormat::RGBA8Srgb. Like all Magnum images, the first row
+         * of @p image is the bottom one, the same as what
+         * @ref GL::AbstractFramebuffer::read() produces. Contents of
+         * @p image are blended over, clear it beforehand if desired. The
+         * draw data are scaled with @cpp ImDrawData::FramebufferScale @ce
+         * and everything outside of @p image is clipped.
+         *
+         * On ImGui 1.92 and newer, texture requests in
+         * @cpp ImDrawData::Textures @ce are processed first and their status
+         * is updated. Expects that all other textures referenced by the draw
+         * data were added with @ref addTexture().
+         */
+        void draw(ImDrawData& drawData, const MutableImageView2D& image);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <imgui.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/ImGuiIntegration/Allocator.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct AllocatorTest: TestSuite::Tester {
+    explicit AllocatorTest();
+
+    void construct();
+    void constructAnotherInstance();
+    void constructContextExists();
+    void constructCopy();
+
+    void allocate();
+    void allocateReuse();
+    void allocateContext();
+
+    void resetPeakBytes();
+    void limit();
+};
+
+AllocatorTest::AllocatorTest() {
+    addTests({&AllocatorTest::construct,
+              &AllocatorTest::constructAnotherInstance,
+              &AllocatorTest::constructContextExists,
+              &AllocatorTest::constructCopy,
+
+              &AllocatorTest::allocate,
+              &AllocatorTest::allocateReuse,
+              &AllocatorTest::allocateContext,
+
+              &AllocatorTest::resetPeakBytes,
+              &AllocatorTest::limit});
+}
+
+void AllocatorTest::construct() {
+    CORRADE_VERIFY(!Allocator::current());
+
+    {
+        Allocator allocator;
+        CORRADE_COMPARE(Allocator::current(), &allocator);
+        CORRADE_COMPARE(allocator.limit(), 0);
+
+        const AllocatorStatistics& statistics = allocator.statistics();
+        CORRADE_COMPARE(statistics.liveBytes, 0);
+        CORRADE_COMPARE(statistics.peakBytes, 0);
+        CORRADE_COMPARE(statistics.liveAllocationCount, 0);
+        CORRADE_COMPARE(statistics.reservedBytes, 0);
+        CORRADE_COMPARE(statistics.allocationCount, 0);
+        CORRADE_COMPARE(statistics.allocatedBytes, 0);
+    }
+
+    CORRADE_VERIFY(!Allocator::current());
+}
+
+void AllocatorTest::constructAnotherInstance() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Allocator allocator;
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        Allocator another;
+    }
+    CORRADE_COMPARE(out, "ImGuiIntegration::Allocator: another instance already exists\n");
+
+    /* The original instance stays installed */
+    CORRADE_COMPARE(Allocator::current(), &allocator);
+}
+
+void AllocatorTest::constructContextExists() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ImGuiContext* const context = ImGui::CreateContext();
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        Allocator allocator;
+    }
+    CORRADE_COMPARE(out, "ImGuiIntegration::Allocator: has to be created before any ImGui context\n");
+    CORRADE_VERIFY(!Allocator::current());
+
+    ImGui::DestroyContext(context);
+}
+
+void AllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<Allocator>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<Allocator>{});
+    CORRADE_VERIFY(!std::is_move_constructible<Allocator>{});
+    CORRADE_VERIFY(!std::is_move_assignable<Allocator>{});
+}
+
+void AllocatorTest::allocate() {
+    Allocator allocator;
+    const AllocatorStatistics& statistics = allocator.statistics();
+
+    /* Small allocation reserves a whole chunk */
+    void* small = ImGui::MemAlloc(10);
+    CORRADE_VERIFY(small);
+    CORRADE_COMPARE(statistics.liveBytes, 10);
+    CORRADE_COMPARE(statistics.liveAllocationCount, 1);
+    CORRADE_COMPARE(statistics.reservedBytes, 64*1024);
+
+    /* Large allocation goes directly to the system, with the overhead */
+    void* large = ImGui::MemAlloc(10000);
+    CORRADE_VERIFY(large);
+    CORRADE_COMPARE(statistics.liveBytes, 10010);
+    CORRADE_COMPARE(statistics.liveAllocationCount, 2);
+    CORRADE_COMPARE(statistics.reservedBytes, 64*1024 + 10000 + 2*sizeof(std::size_t));
+
+    /* The memory is usable */
+    std::memset(small, 0x5a, 10);
+    std::memset(large, 0xa5, 10000);
+
+    ImGui::MemFree(large);
+    CORRADE_COMPARE(statistics.liveBytes, 10);
+    CORRADE_COMPARE(statistics.reservedBytes, 64*1024);
+
+    ImGui::MemFree(small);
+    CORRADE_COMPARE(statistics.liveBytes, 0);
+    CORRADE_COMPARE(statistics.peakBytes, 10010);
+    CORRADE_COMPARE(statistics.liveAllocationCount, 0);
+    CORRADE_COMPARE(statistics.allocationCount, 2);
+    CORRADE_COMPARE(statistics.allocatedBytes, 10010);
+    /* The chunk is kept for reuse */
+    CORRADE_COMPARE(statistics.reservedBytes, 64*1024);
+
+    /* Freeing a null pointer does nothing */
+    ImGui::MemFree(nullptr);
+    CORRADE_COMPARE(statistics.liveAllocationCount, 0);
+}
+
+void AllocatorTest::allocateReuse() {
+    Allocator allocator;
+
+    /* Allocations of the same size class reuse the freed block */
+    void* a = ImGui::MemAlloc(100);
+    ImGui::MemFree(a);
+    void* b = ImGui::MemAlloc(120);
+    CORRADE_COMPARE(b, a);
+
+    /* A different size class doesn't */
+    void* c = ImGui::MemAlloc(20);
+    CORRADE_VERIFY(c != a);
+    CORRADE_COMPARE(allocator.statistics().reservedBytes, 2*64*1024);
+
+    ImGui::MemFree(b);
+    ImGui::MemFree(c);
+}
+
+void AllocatorTest::allocateContext() {
+    Allocator allocator;
+
+    ImGuiContext* const context = ImGui::CreateContext();
+    CORRADE_COMPARE_AS(allocator.statistics().liveBytes, std::size_t{},
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(allocator.statistics().allocationCount, UnsignedLong{},
+        TestSuite::Compare::Greater);
+
+    ImGui::DestroyContext(context);
+    CORRADE_COMPARE(allocator.statistics().liveBytes, 0);
+    CORRADE_COMPARE(allocator.statistics().liveAllocationCount, 0);
+}
+
+void AllocatorTest::resetPeakBytes() {
+    Allocator allocator;
+
+    void* a = ImGui::MemAlloc(1000);
+    void* b = ImGui::MemAlloc(2000);
+    ImGui::MemFree(b);
+    CORRADE_COMPARE(allocator.statistics().peakBytes, 3000);
+
+    allocator.resetPeakBytes();
+    CORRADE_COMPARE(allocator.statistics().peakBytes, 1000);
+
+    ImGui::MemFree(a);
+    CORRADE_COMPARE(allocator.statistics().peakBytes, 1000);
+}
+
+void AllocatorTest::limit() {
+    Allocator allocator;
+    allocator.setLimit(1500);
+    CORRADE_COMPARE(allocator.limit(), 1500);
+
+    Containers::String out;
+    Warning redirectWarning{&out};
+
+    /* Exceeding the limit warns just once */
+    void* a = ImGui::MemAlloc(1000);
+    void* b = ImGui::MemAlloc(1000);
+    void* c = ImGui::MemAlloc(1000);
+    CORRADE_COMPARE(out, "ImGuiIntegration::Allocator: ImGui is using 2000 bytes, exceeding the limit of 1500 bytes\n");
+
+    /* Until the use drops below the limit */
+    ImGui::MemFree(c);
+    ImGui::MemFree(b);
+    b = ImGui::MemAlloc(1000);
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::Allocator: ImGui is using 2000 bytes, exceeding the limit of 1500 bytes\n"
+        "ImGuiIntegration::Allocator: ImGui is using 2000 bytes, exceeding the limit of 1500 bytes\n");
+
+    ImGui::MemFree(b);
+    ImGui::MemFree(a);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::AllocatorTest)
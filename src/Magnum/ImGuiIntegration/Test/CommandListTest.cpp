@@ -0,0 +1,570 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <initializer_list>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Format.h>
+
+#include "Magnum/ImGuiIntegration/CommandList.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct CommandListTest: TestSuite::Tester {
+    explicit CommandListTest();
+
+    void debugFlag();
+    void debugFlags();
+    #ifdef IMGUI_HAS_TEXTURES
+    void debugTextureOperation();
+    #endif
+
+    void construct();
+    void constructCopy();
+    void setFlags();
+
+    void buildEmpty();
+    void buildMerge();
+    void buildCallback();
+    void buildScissor();
+    void buildMultipleDrawLists();
+    #ifdef IMGUI_HAS_TEXTURES
+    void buildTextures();
+    #endif
+    void buildReuse();
+
+    void copyBufferData();
+    void copyBufferDataInvalid();
+
+    void benchmarkBuild();
+};
+
+CommandListTest::CommandListTest() {
+    addTests({&CommandListTest::debugFlag,
+              &CommandListTest::debugFlags,
+              #ifdef IMGUI_HAS_TEXTURES
+              &CommandListTest::debugTextureOperation,
+              #endif
+
+              &CommandListTest::construct,
+              &CommandListTest::constructCopy,
+              &CommandListTest::setFlags,
+
+              &CommandListTest::buildEmpty,
+              &CommandListTest::buildMerge,
+              &CommandListTest::buildCallback,
+              &CommandListTest::buildScissor,
+              &CommandListTest::buildMultipleDrawLists,
+              #ifdef IMGUI_HAS_TEXTURES
+              &CommandListTest::buildTextures,
+              #endif
+              &CommandListTest::buildReuse,
+
+              &CommandListTest::copyBufferData,
+              &CommandListTest::copyBufferDataInvalid});
+
+    addBenchmarks({&CommandListTest::benchmarkBuild}, 100);
+}
+
+/* Draw data with draw lists that aren't tied to any ImGui context */
+struct DrawData {
+    explicit DrawData(const Vector2& displaySize, const Vector2& framebufferScale = Vector2{1.0f}) {
+        drawData.Valid = true;
+        drawData.DisplaySize = ImVec2(displaySize.x(), displaySize.y());
+        drawData.FramebufferScale = ImVec2(framebufferScale.x(), framebufferScale.y());
+    }
+
+    ImDrawList& addDrawList(std::size_t vertexCount, std::size_t indexCount) {
+        arrayAppend(lists, Containers::Pointer<ImDrawList>{InPlaceInit, nullptr});
+        ImDrawList& list = *lists.back();
+        list.VtxBuffer.resize(vertexCount);
+        list.IdxBuffer.resize(indexCount);
+        for(std::size_t i = 0; i != vertexCount; ++i) {
+            list.VtxBuffer[i].pos = ImVec2(Float(i), 0.0f);
+            list.VtxBuffer[i].uv = ImVec2(0.0f, 0.0f);
+            list.VtxBuffer[i].col = lists.size()*1000 + i;
+        }
+        for(std::size_t i = 0; i != indexCount; ++i)
+            list.IdxBuffer[i] = ImDrawIdx(lists.size()*100 + i);
+        drawData.CmdLists.push_back(&list);
+        ++drawData.CmdListsCount;
+        drawData.TotalVtxCount += vertexCount;
+        drawData.TotalIdxCount += indexCount;
+        return list;
+    }
+
+    Containers::Array<Containers::Pointer<ImDrawList>> lists;
+    ImDrawData drawData;
+};
+
+void addCommand(ImDrawList& list, const Range2D& clipRect, UnsignedLong texture, UnsignedInt vertexOffset, UnsignedInt indexOffset, UnsignedInt elementCount) {
+    ImDrawCmd cmd;
+    cmd.ClipRect = ImVec4(clipRect.min().x(), clipRect.min().y(), clipRect.max().x(), clipRect.max().y());
+    #ifdef IMGUI_HAS_TEXTURES
+    cmd.TexRef = ImTextureRef{ImTextureID(texture)};
+    #elif IMGUI_VERSION_NUM >= 19131
+    cmd.TextureId = ImTextureID(texture);
+    #else
+    cmd.TextureId = reinterpret_cast<ImTextureID>(std::uintptr_t(texture));
+    #endif
+    cmd.VtxOffset = vertexOffset;
+    cmd.IdxOffset = indexOffset;
+    cmd.ElemCount = elementCount;
+    list.CmdBuffer.push_back(cmd);
+}
+
+UnsignedLong textureId(const CommandListBatch& batch) {
+    #ifdef IMGUI_HAS_TEXTURES
+    return batch.texture.GetTexID();
+    #elif IMGUI_VERSION_NUM >= 19131
+    return batch.texture;
+    #else
+    return reinterpret_cast<std::uintptr_t>(batch.texture);
+    #endif
+}
+
+void callback(const ImDrawList*, const ImDrawCmd*) {}
+
+void CommandListTest::debugFlag() {
+    Containers::String out;
+    Debug{&out} << CommandList::Flag::ScissorYUp << CommandList::Flag(0xde);
+    CORRADE_COMPARE(out, "ImGuiIntegration::CommandList::Flag::ScissorYUp ImGuiIntegration::CommandList::Flag(0xde)\n");
+}
+
+void CommandListTest::debugFlags() {
+    Containers::String out;
+    Debug{&out} << (CommandList::Flag::CombinedBuffers|CommandList::Flag::ScissorYUp|CommandList::Flag(0x80)) << CommandList::Flags{};
+    CORRADE_COMPARE(out, "ImGuiIntegration::CommandList::Flag::CombinedBuffers|ImGuiIntegration::CommandList::Flag::ScissorYUp|ImGuiIntegration::CommandList::Flag(0x80) ImGuiIntegration::CommandList::Flags{}\n");
+}
+
+#ifdef IMGUI_HAS_TEXTURES
+void CommandListTest::debugTextureOperation() {
+    Containers::String out;
+    Debug{&out} << CommandListTextureOperation::Update << CommandListTextureOperation(0xde);
+    CORRADE_COMPARE(out, "ImGuiIntegration::CommandListTextureOperation::Update ImGuiIntegration::CommandListTextureOperation(0xde)\n");
+}
+#endif
+
+void CommandListTest::construct() {
+    CommandList list{CommandList::Flag::CombinedBuffers};
+    CORRADE_COMPARE(list.flags(), CommandList::Flag::CombinedBuffers);
+    CORRADE_COMPARE(list.framebufferRect(), Range2Di{});
+    CORRADE_COMPARE(list.vertexCount(), 0);
+    CORRADE_COMPARE(list.indexCount(), 0);
+    CORRADE_COMPARE(list.bufferDataSize(), 0);
+    CORRADE_VERIFY(list.batches().isEmpty());
+    CORRADE_VERIFY(list.draws().isEmpty());
+    #ifdef IMGUI_HAS_TEXTURES
+    CORRADE_VERIFY(list.textures().isEmpty());
+    CORRADE_VERIFY(list.textureRegions().isEmpty());
+    #endif
+}
+
+void CommandListTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<CommandList>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<CommandList>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<CommandList>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<CommandList>::value);
+}
+
+void CommandListTest::setFlags() {
+    CommandList list;
+    CORRADE_COMPARE(list.flags(), CommandList::Flags{});
+
+    list.setFlags(CommandList::Flag::ScissorYUp);
+    CORRADE_COMPARE(list.flags(), CommandList::Flag::ScissorYUp);
+}
+
+void CommandListTest::buildEmpty() {
+    DrawData data{{200.0f, 100.0f}, {2.0f, 1.5f}};
+    data.addDrawList(0, 0);
+
+    CommandList list;
+    list.build(data.drawData);
+    CORRADE_COMPARE(list.framebufferRect(), (Range2Di{{}, {400, 150}}));
+    CORRADE_COMPARE(list.vertexCount(), 0);
+    CORRADE_COMPARE(list.indexCount(), 0);
+    CORRADE_VERIFY(list.batches().isEmpty());
+    CORRADE_VERIFY(list.draws().isEmpty());
+}
+
+void CommandListTest::buildMerge() {
+    DrawData data{{100.0f, 100.0f}};
+    ImDrawList& drawList = data.addDrawList(40, 60);
+    const Range2D all{{}, {100.0f, 100.0f}};
+    const Range2D half{{}, {50.0f, 100.0f}};
+    /* These two continue each other, so they're a single draw */
+    addCommand(drawList, all, 1, 0, 0, 6);
+    addCommand(drawList, all, 1, 0, 6, 6);
+    /* Not continuing, a second draw in the same batch */
+    addCommand(drawList, all, 1, 0, 18, 3);
+    /* Different base vertex, a third draw */
+    addCommand(drawList, all, 1, 4, 21, 3);
+    /* Different texture, a new batch */
+    addCommand(drawList, all, 2, 4, 24, 6);
+    /* No elements and a clip rect outside of the framebuffer, dropped
+       without affecting the batch */
+    addCommand(drawList, all, 3, 4, 30, 0);
+    addCommand(drawList, Range2D{{100.0f, 0.0f}, {150.0f, 100.0f}}, 3, 4, 30, 6);
+    addCommand(drawList, all, 2, 4, 30, 6);
+    /* Different scissor, a new batch */
+    addCommand(drawList, half, 2, 4, 36, 6);
+
+    CommandList list;
+    list.build(data.drawData);
+    CORRADE_COMPARE(list.vertexCount(), 40);
+    CORRADE_COMPARE(list.indexCount(), 60);
+
+    Containers::ArrayView<const CommandListBatch> batches = list.batches();
+    CORRADE_COMPARE(batches.size(), 3);
+
+    CORRADE_COMPARE(batches[0].scissor, (Range2Di{{}, {100, 100}}));
+    CORRADE_COMPARE(textureId(batches[0]), 1);
+    CORRADE_COMPARE(batches[0].drawList, 0);
+    CORRADE_COMPARE(batches[0].drawOffset, 0);
+    CORRADE_COMPARE(batches[0].drawCount, 3);
+    CORRADE_COMPARE(batches[0].callback, nullptr);
+
+    CORRADE_COMPARE(batches[1].scissor, (Range2Di{{}, {100, 100}}));
+    CORRADE_COMPARE(textureId(batches[1]), 2);
+    CORRADE_COMPARE(batches[1].drawOffset, 3);
+    CORRADE_COMPARE(batches[1].drawCount, 1);
+
+    CORRADE_COMPARE(batches[2].scissor, (Range2Di{{}, {50, 100}}));
+    CORRADE_COMPARE(textureId(batches[2]), 2);
+    CORRADE_COMPARE(batches[2].drawOffset, 4);
+    CORRADE_COMPARE(batches[2].drawCount, 1);
+
+    Containers::ArrayView<const CommandListDraw> draws = list.draws();
+    CORRADE_COMPARE(draws.size(), 5);
+    CORRADE_COMPARE(draws[0].indexOffset, 0);
+    CORRADE_COMPARE(draws[0].indexCount, 12);
+    CORRADE_COMPARE(draws[0].baseVertex, 0);
+    CORRADE_COMPARE(draws[1].indexOffset, 18);
+    CORRADE_COMPARE(draws[1].indexCount, 3);
+    CORRADE_COMPARE(draws[1].baseVertex, 0);
+    CORRADE_COMPARE(draws[2].indexOffset, 21);
+    CORRADE_COMPARE(draws[2].indexCount, 3);
+    CORRADE_COMPARE(draws[2].baseVertex, 4);
+    /* The dropped commands didn't break the contiguous range */
+    CORRADE_COMPARE(draws[3].indexOffset, 24);
+    CORRADE_COMPARE(draws[3].indexCount, 12);
+    CORRADE_COMPARE(draws[3].baseVertex, 4);
+    CORRADE_COMPARE(draws[4].indexOffset, 36);
+    CORRADE_COMPARE(draws[4].indexCount, 6);
+    CORRADE_COMPARE(draws[4].baseVertex, 4);
+}
+
+void CommandListTest::buildCallback() {
+    DrawData data{{100.0f, 100.0f}};
+    ImDrawList& drawList = data.addDrawList(4, 18);
+    const Range2D all{{}, {100.0f, 100.0f}};
+    addCommand(drawList, all, 1, 0, 0, 6);
+    drawList.CmdBuffer.push_back(ImDrawCmd{});
+    drawList.CmdBuffer.back().UserCallback = callback;
+    /* Same state as before, but it can't be merged across the callback */
+    addCommand(drawList, all, 1, 0, 6, 6);
+    addCommand(drawList, all, 1, 0, 12, 6);
+
+    CommandList list;
+    list.build(data.drawData);
+
+    Containers::ArrayView<const CommandListBatch> batches = list.batches();
+    CORRADE_COMPARE(batches.size(), 3);
+    CORRADE_COMPARE(batches[0].drawCount, 1);
+    CORRADE_COMPARE(batches[0].callback, nullptr);
+    CORRADE_COMPARE(batches[1].drawList, 0);
+    CORRADE_COMPARE(batches[1].drawCount, 0);
+    CORRADE_COMPARE(batches[1].callback, &drawList.CmdBuffer[1]);
+    CORRADE_COMPARE(batches[2].drawOffset, 1);
+    CORRADE_COMPARE(batches[2].drawCount, 1);
+    CORRADE_COMPARE(batches[2].callback, nullptr);
+
+    Containers::ArrayView<const CommandListDraw> draws = list.draws();
+    CORRADE_COMPARE(draws.size(), 2);
+    CORRADE_COMPARE(draws[1].indexOffset, 6);
+    CORRADE_COMPARE(draws[1].indexCount, 12);
+}
+
+void CommandListTest::buildScissor() {
+    DrawData data{{100.0f, 50.0f}, {2.0f, 2.0f}};
+    ImDrawList& drawList = data.addDrawList(4, 6);
+    /* Partially outside of the display on the right */
+    addCommand(drawList, Range2D{{10.0f, 5.0f}, {120.0f, 20.0f}}, 1, 0, 0, 6);
+
+    CommandList list;
+    list.build(data.drawData);
+    CORRADE_COMPARE(list.framebufferRect(), (Range2Di{{}, {200, 100}}));
+    CORRADE_COMPARE(list.batches().size(), 1);
+    CORRADE_COMPARE(list.batches()[0].scissor, (Range2Di{{20, 10}, {200, 40}}));
+
+    /* Flipped for GL */
+    list.setFlags(CommandList::Flag::ScissorYUp)
+        .build(data.drawData);
+    CORRADE_COMPARE(list.batches().size(), 1);
+    CORRADE_COMPARE(list.batches()[0].scissor, (Range2Di{{20, 60}, {200, 90}}));
+}
+
+void CommandListTest::buildMultipleDrawLists() {
+    DrawData data{{100.0f, 100.0f}};
+    const Range2D all{{}, {100.0f, 100.0f}};
+    ImDrawList& first = data.addDrawList(4, 6);
+    addCommand(first, all, 1, 0, 0, 6);
+    ImDrawList& second = data.addDrawList(8, 12);
+    addCommand(second, all, 1, 0, 0, 6);
+    addCommand(second, all, 1, 4, 6, 6);
+
+    /* With combined buffers the offsets are global and the batch continues
+       across the draw lists. The first command of the second list continues
+       where the first list ended in the index buffer but has a different
+       base vertex, so it's a new draw. */
+    {
+        CommandList list{CommandList::Flag::CombinedBuffers};
+        list.build(data.drawData);
+        CORRADE_COMPARE(list.vertexCount(), 12);
+        CORRADE_COMPARE(list.indexCount(), 18);
+
+        Containers::ArrayView<const CommandListBatch> batches = list.batches();
+        CORRADE_COMPARE(batches.size(), 1);
+        CORRADE_COMPARE(batches[0].drawList, 0);
+        CORRADE_COMPARE(batches[0].drawCount, 3);
+
+        Containers::ArrayView<const CommandListDraw> draws = list.draws();
+        CORRADE_COMPARE(draws.size(), 3);
+        CORRADE_COMPARE(draws[0].indexOffset, 0);
+        CORRADE_COMPARE(draws[0].baseVertex, 0);
+        CORRADE_COMPARE(draws[1].indexOffset, 6);
+        CORRADE_COMPARE(draws[1].baseVertex, 4);
+        CORRADE_COMPARE(draws[2].indexOffset, 12);
+        CORRADE_COMPARE(draws[2].baseVertex, 8);
+
+    /* Otherwise the offsets are relative to each list and batches don't span
+       lists */
+    } {
+        CommandList list;
+        list.build(data.drawData);
+
+        Containers::ArrayView<const CommandListBatch> batches = list.batches();
+        CORRADE_COMPARE(batches.size(), 2);
+        CORRADE_COMPARE(batches[0].drawList, 0);
+        CORRADE_COMPARE(batches[0].drawCount, 1);
+        CORRADE_COMPARE(batches[1].drawList, 1);
+        CORRADE_COMPARE(batches[1].drawOffset, 1);
+        CORRADE_COMPARE(batches[1].drawCount, 2);
+
+        Containers::ArrayView<const CommandListDraw> draws = list.draws();
+        CORRADE_COMPARE(draws.size(), 3);
+        CORRADE_COMPARE(draws[1].indexOffset, 0);
+        CORRADE_COMPARE(draws[1].baseVertex, 0);
+        CORRADE_COMPARE(draws[2].indexOffset, 6);
+        CORRADE_COMPARE(draws[2].baseVertex, 4);
+    }
+}
+
+#ifdef IMGUI_HAS_TEXTURES
+void CommandListTest::buildTextures() {
+    ImTextureData create;
+    create.Create(ImTextureFormat_RGBA32, 32, 16);
+    create.Status = ImTextureStatus_WantCreate;
+
+    /* Two tiny rectangles far apart, cheaper to upload separately */
+    ImTextureData updateSeparate;
+    updateSeparate.Create(ImTextureFormat_Alpha8, 1024, 1024);
+    updateSeparate.Status = ImTextureStatus_WantUpdates;
+    updateSeparate.Updates.push_back(ImTextureRect{0, 0, 4, 4});
+    updateSeparate.Updates.push_back(ImTextureRect{1000, 1000, 8, 8});
+    updateSeparate.UpdateRect = ImTextureRect{0, 0, 1008, 1008};
+
+    /* Two rectangles next to each other, cheaper to upload the bounds */
+    ImTextureData updateBounds;
+    updateBounds.Create(ImTextureFormat_Alpha8, 64, 64);
+    updateBounds.Status = ImTextureStatus_WantUpdates;
+    updateBounds.Updates.push_back(ImTextureRect{0, 0, 16, 8});
+    updateBounds.Updates.push_back(ImTextureRect{16, 0, 16, 8});
+    updateBounds.UpdateRect = ImTextureRect{0, 0, 32, 8};
+
+    ImTextureData destroy;
+    destroy.SetTexID(ImTextureID(3));
+    destroy.Status = ImTextureStatus_WantDestroy;
+
+    /* Nothing to do for these */
+    ImTextureData ok;
+    ok.Status = ImTextureStatus_OK;
+    ImTextureData destroyed;
+
+    ImVector<ImTextureData*> textures;
+    for(ImTextureData* texture: {&create, &ok, &updateSeparate, &updateBounds, &destroyed, &destroy})
+        textures.push_back(texture);
+
+    DrawData data{{100.0f, 100.0f}};
+    data.drawData.Textures = &textures;
+
+    /* A command referencing a texture that's only being created gets the
+       reference and not the (invalid) ID */
+    ImDrawList& drawList = data.addDrawList(4, 6);
+    addCommand(drawList, Range2D{{}, {100.0f, 100.0f}}, 0, 0, 0, 6);
+    drawList.CmdBuffer.back().TexRef = ImTextureRef{};
+    drawList.CmdBuffer.back().TexRef._TexData = &create;
+
+    CommandList list;
+    list.build(data.drawData);
+
+    Containers::ArrayView<const CommandListTexture> operations = list.textures();
+    CORRADE_COMPARE(operations.size(), 4);
+    CORRADE_COMPARE(operations[0].texture, &create);
+    CORRADE_COMPARE(operations[0].operation, CommandListTextureOperation::Create);
+    CORRADE_COMPARE(operations[0].regionOffset, 0);
+    CORRADE_COMPARE(operations[0].regionCount, 1);
+    CORRADE_COMPARE(operations[1].texture, &updateSeparate);
+    CORRADE_COMPARE(operations[1].operation, CommandListTextureOperation::Update);
+    CORRADE_COMPARE(operations[1].regionOffset, 1);
+    CORRADE_COMPARE(operations[1].regionCount, 2);
+    CORRADE_COMPARE(operations[2].texture, &updateBounds);
+    CORRADE_COMPARE(operations[2].operation, CommandListTextureOperation::Update);
+    CORRADE_COMPARE(operations[2].regionOffset, 3);
+    CORRADE_COMPARE(operations[2].regionCount, 1);
+    CORRADE_COMPARE(operations[3].texture, &destroy);
+    CORRADE_COMPARE(operations[3].operation, CommandListTextureOperation::Destroy);
+    CORRADE_COMPARE(operations[3].regionOffset, 4);
+    CORRADE_COMPARE(operations[3].regionCount, 0);
+
+    Containers::ArrayView<const Range2Di> regions = list.textureRegions();
+    CORRADE_COMPARE(regions.size(), 4);
+    CORRADE_COMPARE(regions[0], (Range2Di{{}, {32, 16}}));
+    CORRADE_COMPARE(regions[1], (Range2Di{{}, {4, 4}}));
+    CORRADE_COMPARE(regions[2], (Range2Di{{1000, 1000}, {1008, 1008}}));
+    CORRADE_COMPARE(regions[3], (Range2Di{{}, {32, 8}}));
+
+    /* The statuses are left for the code processing the operations */
+    CORRADE_COMPARE(create.Status, ImTextureStatus_WantCreate);
+    CORRADE_COMPARE(destroy.Status, ImTextureStatus_WantDestroy);
+
+    CORRADE_COMPARE(list.batches().size(), 1);
+    CORRADE_COMPARE(list.batches()[0].texture._TexData, &create);
+}
+#endif
+
+void CommandListTest::buildReuse() {
+    DrawData data{{100.0f, 100.0f}};
+    ImDrawList& drawList = data.addDrawList(4, 12);
+    addCommand(drawList, Range2D{{}, {100.0f, 100.0f}}, 1, 0, 0, 6);
+    addCommand(drawList, Range2D{{}, {50.0f, 100.0f}}, 1, 0, 6, 6);
+
+    CommandList list;
+    list.build(data.drawData);
+    CORRADE_COMPARE(list.batches().size(), 2);
+    CORRADE_COMPARE(list.draws().size(), 2);
+
+    /* Building again replaces the previous contents */
+    DrawData empty{{50.0f, 50.0f}};
+    list.build(empty.drawData);
+    CORRADE_COMPARE(list.framebufferRect(), (Range2Di{{}, {50, 50}}));
+    CORRADE_COMPARE(list.vertexCount(), 0);
+    CORRADE_VERIFY(list.batches().isEmpty());
+    CORRADE_VERIFY(list.draws().isEmpty());
+
+    list.build(data.drawData);
+    CORRADE_COMPARE(list.batches().size(), 2);
+    CORRADE_COMPARE(list.draws().size(), 2);
+}
+
+void CommandListTest::copyBufferData() {
+    /* Odd vertex count to test index alignment if ImDrawVert size isn't a
+       multiple of the index size */
+    DrawData data{{100.0f, 100.0f}};
+    data.addDrawList(3, 6);
+    data.addDrawList(0, 0);
+    data.addDrawList(2, 3);
+
+    CommandList list{CommandList::Flag::CombinedBuffers};
+    list.build(data.drawData);
+    CORRADE_COMPARE(list.indexDataOffset() % sizeof(ImDrawIdx), 0);
+    CORRADE_VERIFY(list.indexDataOffset() >= 5*sizeof(ImDrawVert));
+    CORRADE_COMPARE(list.bufferDataSize(), list.indexDataOffset() + 9*sizeof(ImDrawIdx));
+
+    Containers::Array<char> out{ValueInit, list.bufferDataSize()};
+    list.copyBufferData(data.drawData, out);
+
+    const auto vertices = Containers::arrayCast<const ImDrawVert>(out.prefix(5*sizeof(ImDrawVert)));
+    CORRADE_COMPARE(vertices[0].col, 1000u);
+    CORRADE_COMPARE(vertices[2].col, 1002u);
+    CORRADE_COMPARE(vertices[3].col, 3000u);
+    CORRADE_COMPARE(vertices[4].col, 3001u);
+
+    const auto indices = Containers::arrayCast<const ImDrawIdx>(out.exceptPrefix(list.indexDataOffset()));
+    CORRADE_COMPARE(indices.size(), 9);
+    CORRADE_COMPARE(indices[0], 100);
+    CORRADE_COMPARE(indices[5], 105);
+    CORRADE_COMPARE(indices[6], 300);
+    CORRADE_COMPARE(indices[8], 302);
+}
+
+void CommandListTest::copyBufferDataInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DrawData data{{100.0f, 100.0f}};
+    data.addDrawList(3, 6);
+    DrawData different{{100.0f, 100.0f}};
+    different.addDrawList(4, 6);
+
+    CommandList list{CommandList::Flag::CombinedBuffers};
+    list.build(data.drawData);
+
+    Containers::Array<char> out{ValueInit, list.bufferDataSize()};
+
+    Containers::String message;
+    Error redirectError{&message};
+    list.copyBufferData(different.drawData, out);
+    list.copyBufferData(data.drawData, out.exceptSuffix(1));
+    CORRADE_COMPARE(message, Utility::format(
+        "ImGuiIntegration::CommandList::copyBufferData(): expected draw data with 3 vertices and 6 indices but got 4 and 6\n"
+        "ImGuiIntegration::CommandList::copyBufferData(): expected at least {0} bytes but got {1}\n",
+        list.bufferDataSize(), list.bufferDataSize() - 1));
+}
+
+void CommandListTest::benchmarkBuild() {
+    /* A few hundred windows with a lot of widgets each, alternating between
+       two textures and a few clip rects */
+    DrawData data{{1920.0f, 1080.0f}};
+    for(std::size_t i = 0; i != 200; ++i) {
+        ImDrawList& drawList = data.addDrawList(1000, 1500);
+        for(UnsignedInt j = 0; j != 250; ++j)
+            addCommand(drawList, Range2D::fromSize({Float(j % 4)*10.0f, 0.0f}, {500.0f, 500.0f}), 1 + j % 2, 0, j*6, 6);
+    }
+
+    CommandList list{CommandList::Flag::CombinedBuffers};
+    CORRADE_BENCHMARK(10)
+        list.build(data.drawData);
+
+    CORRADE_VERIFY(!list.batches().isEmpty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::CommandListTest)
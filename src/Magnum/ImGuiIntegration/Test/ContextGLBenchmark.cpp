@@ -0,0 +1,258 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <imgui.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/Math/Angle.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+
+#include "Magnum/ImGuiIntegration/Context.h"
+
+/* Runs headless through GL::OpenGLTester, to benchmark with a software
+   rasterizer on Mesa run it for example with LIBGL_ALWAYS_SOFTWARE=1. The
+   times are taken from Context::frameStatistics(), so each benchmark measures
+   just the part it's named after, even though every iteration does a whole
+   frame. */
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct ContextGLBenchmark: GL::OpenGLTester {
+    explicit ContextGLBenchmark();
+
+    void setup();
+    void teardown();
+
+    void durationBegin();
+    std::uint64_t durationEnd();
+
+    void newFrame();
+    void render();
+    void drawFrame();
+    void drawFrameCachedLayer();
+
+    private:
+        void frame(UnsignedLong FrameStatistics::*duration);
+
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+        Context _context{NoCreate};
+        Containers::Array<Float> _plotData;
+        UnsignedLong _duration;
+};
+
+constexpr Vector2i BenchmarkSize{1920, 1080};
+
+constexpr std::size_t FrameIterations = 10;
+
+/* All UIs are static, so the cached layer can kick in as well */
+const struct {
+    const char* name;
+    void(*ui)(Containers::ArrayView<const Float> plotData);
+} UiData[]{
+    {"10k-row table", [](Containers::ArrayView<const Float>) {
+        ImGui::SetNextWindowPos({0.0f, 0.0f});
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Table");
+        /* Deliberately not using a ImGuiListClipper to stress the worst
+           case */
+        #if IMGUI_VERSION_NUM >= 18000
+        if(ImGui::BeginTable("table", 4, ImGuiTableFlags_Borders|ImGuiTableFlags_RowBg|ImGuiTableFlags_ScrollY)) {
+            for(Int row = 0; row != 10000; ++row) {
+                ImGui::TableNextRow();
+                for(Int column = 0; column != 4; ++column) {
+                    ImGui::TableSetColumnIndex(column);
+                    ImGui::Text("Cell %d:%d", row, column);
+                }
+            }
+            ImGui::EndTable();
+        }
+        #else
+        ImGui::Columns(4, "table");
+        for(Int row = 0; row != 10000; ++row) {
+            for(Int column = 0; column != 4; ++column) {
+                ImGui::Text("Cell %d:%d", row, column);
+                ImGui::NextColumn();
+            }
+        }
+        ImGui::Columns(1);
+        #endif
+        ImGui::End();
+    }},
+    {"200 windows", [](Containers::ArrayView<const Float>) {
+        for(Int i = 0; i != 200; ++i) {
+            const Containers::String name = Utility::format("Window {}", i);
+            ImGui::SetNextWindowPos({Float(i%20)*90.0f, Float(i/20)*100.0f});
+            ImGui::SetNextWindowSize({160.0f, 120.0f});
+            ImGui::Begin(name.data());
+            ImGui::Text("Hello from window %d", i);
+            ImGui::Button("Button");
+            static Float value = 0.5f;
+            ImGui::SliderFloat("Slider", &value, 0.0f, 1.0f);
+            static bool checked = true;
+            ImGui::Checkbox("Checkbox", &checked);
+            ImGui::End();
+        }
+    }},
+    {"100k-point plot", [](Containers::ArrayView<const Float> plotData) {
+        ImGui::SetNextWindowPos({0.0f, 0.0f});
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Plot");
+        ImGui::PlotLines("Lines", plotData.data(), Int(plotData.size()), 0, nullptr, -1.0f, 1.0f, {1800.0f, 450.0f});
+        ImGui::PlotHistogram("Histogram", plotData.data(), Int(plotData.size()), 0, nullptr, -1.0f, 1.0f, {1800.0f, 450.0f});
+        ImGui::End();
+    }},
+    {"10k glyphs of text", [](Containers::ArrayView<const Float>) {
+        ImGui::SetNextWindowPos({0.0f, 0.0f});
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Text");
+        /* 100 lines with 100 characters each, all visible */
+        for(Int line = 0; line != 100; ++line)
+            ImGui::TextUnformatted(
+                "The quick brown fox jumps over the lazy dog. "
+                "PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS! 0123456789");
+        ImGui::End();
+    }},
+};
+
+ContextGLBenchmark::ContextGLBenchmark() {
+    addCustomInstancedBenchmarks({&ContextGLBenchmark::newFrame,
+                                  &ContextGLBenchmark::render,
+                                  &ContextGLBenchmark::drawFrame,
+                                  &ContextGLBenchmark::drawFrameCachedLayer},
+        10, Containers::arraySize(UiData),
+        &ContextGLBenchmark::setup,
+        &ContextGLBenchmark::teardown,
+        &ContextGLBenchmark::durationBegin,
+        &ContextGLBenchmark::durationEnd,
+        BenchmarkUnits::Nanoseconds);
+
+    _plotData = Containers::Array<Float>{NoInit, 100000};
+    for(std::size_t i = 0; i != _plotData.size(); ++i)
+        _plotData[i] = Math::sin(Rad(Float(i)*0.01f))*Math::cos(Rad(Float(i)*0.0007f));
+}
+
+void ContextGLBenchmark::setup() {
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        BenchmarkSize);
+    _framebuffer = GL::Framebuffer{{{}, BenchmarkSize}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .bind();
+
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendEquation(GL::Renderer::BlendEquation::Add, GL::Renderer::BlendEquation::Add);
+    GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::SourceAlpha, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+    GL::Renderer::disable(GL::Renderer::Feature::FaceCulling);
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
+
+    _context = Context{BenchmarkSize};
+    /* Don't litter the filesystem with window positions */
+    ImGui::GetIO().IniFilename = nullptr;
+
+    /* Draw a few frames first so the windows settle, font glyphs get
+       rasterized and buffers reach their final size */
+    for(std::size_t i = 0; i != 3; ++i) {
+        _context.newFrame();
+        UiData[testCaseInstanceId()].ui(_plotData);
+        _context.drawFrame();
+    }
+    GL::Renderer::finish();
+}
+
+void ContextGLBenchmark::teardown() {
+    _context = Context{NoCreate};
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+}
+
+void ContextGLBenchmark::durationBegin() {
+    _duration = 0;
+}
+
+std::uint64_t ContextGLBenchmark::durationEnd() {
+    return _duration;
+}
+
+void ContextGLBenchmark::frame(UnsignedLong FrameStatistics::*duration) {
+    setTestCaseDescription(UiData[testCaseInstanceId()].name);
+
+    CORRADE_BENCHMARK(FrameIterations) {
+        _context.newFrame();
+        UiData[testCaseInstanceId()].ui(_plotData);
+        _context.drawFrame();
+
+        const FrameStatistics& statistics = _context.frameStatistics();
+        _duration += statistics.*duration;
+        /* ImGui::Render() is a part of drawFrame(), subtract it to measure
+           just the backend */
+        if(duration == &FrameStatistics::drawFrameDuration)
+            _duration -= statistics.renderDuration;
+
+        /* Not measured, makes sure the GPU doesn't queue up an arbitrary
+           amount of frames */
+        GL::Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ContextGLBenchmark::newFrame() {
+    frame(&FrameStatistics::newFrameDuration);
+}
+
+void ContextGLBenchmark::render() {
+    frame(&FrameStatistics::renderDuration);
+}
+
+void ContextGLBenchmark::drawFrame() {
+    frame(&FrameStatistics::drawFrameDuration);
+}
+
+void ContextGLBenchmark::drawFrameCachedLayer() {
+    /* The UI doesn't change, so after the first frame this should be just
+       compositing the layer */
+    _context.setFlags(Context::Flag::CachedLayer);
+    frame(&FrameStatistics::drawFrameDuration);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ContextGLBenchmark)
@@ -29,15 +29,19 @@
 
 #include <cstring> /* std::strcpy() */
 #include <limits>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/System.h>
 #include <Corrade/Utility/Path.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/DebugTools/CompareImage.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
 #include <Magnum/GL/Framebuffer.h>
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
@@ -45,6 +49,7 @@
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Vector3.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ImageData.h>
@@ -52,6 +57,7 @@
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
 
+#include "Magnum/ImGuiIntegration/Allocator.h"
 #include "Magnum/ImGuiIntegration/Context.hpp"
 #include "Magnum/ImGuiIntegration/Widgets.h"
 
@@ -237,6 +243,7 @@ struct ContextGLTest: GL::OpenGLTester {
     void construct();
     void constructExistingContext();
     void constructExistingContextAddFont();
+    void constructSharedResources();
     void constructMove();
     void moveAssignEmpty();
 
@@ -248,18 +255,23 @@ struct ContextGLTest: GL::OpenGLTester {
     void relayout();
     void relayoutDpiChange();
     void relayoutDpiChangeCustomFont();
+    #if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+    void relayoutDpiChangeResidentAtlas();
+    #endif
     void relayoutZeroSize();
     void relayoutRefreshFonts();
 
     void pointerInput();
     void pointerInputTooFast();
     void scrollInput();
+    void coalescePointerInput();
     #ifdef MAGNUM_BUILD_DEPRECATED
     void mouseInput();
     void mouseInputTooFast();
     #endif
     void keyInput();
     void textInput();
+    void redrawOnDemand();
     void updateCursor();
 
     void clipboardNoOp();
@@ -277,9 +289,30 @@ struct ContextGLTest: GL::OpenGLTester {
     #if IMGUI_VERSION_NUM >= 19200
     void drawTextSingleChannel();
     #endif
+    #ifndef IMGUI_HAS_TEXTURES
+    void drawTextSingleChannelAtlas();
+    #endif
+    #if IMGUI_VERSION_NUM >= 19200
+    void drawTextTextureUpdates();
+    void drawTextPrewarmGlyphs();
+    #endif
     void drawScissor();
     void drawVertexOffset();
     void drawIndexOffset();
+    void drawMultipleDrawLists();
+    void drawMultipleFrames();
+    void drawMergedBatches();
+    void drawCachedLayer();
+    void drawFrameStatistics();
+    void drawFrameStatisticsGpuTiming();
+    void drawFrameStatisticsAllocator();
+    void drawSharedResources();
+    void drawSharedResourcesAsync();
+    void drawSnapshot();
+    void drawSnapshotNoCurrentContext();
+    #if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+    void drawFontAtlasCache();
+    #endif
 
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager;
@@ -291,7 +324,8 @@ struct ContextGLTest: GL::OpenGLTester {
 ContextGLTest::ContextGLTest() {
     addTests({&ContextGLTest::construct,
               &ContextGLTest::constructExistingContext,
-              &ContextGLTest::constructExistingContextAddFont});
+              &ContextGLTest::constructExistingContextAddFont,
+              &ContextGLTest::constructSharedResources});
 
     addTests({&ContextGLTest::constructMove},
         &ContextGLTest::drawSetup,
@@ -307,18 +341,23 @@ ContextGLTest::ContextGLTest() {
               &ContextGLTest::relayout,
               &ContextGLTest::relayoutDpiChange,
               &ContextGLTest::relayoutDpiChangeCustomFont,
+              #if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+              &ContextGLTest::relayoutDpiChangeResidentAtlas,
+              #endif
               &ContextGLTest::relayoutZeroSize,
               &ContextGLTest::relayoutRefreshFonts,
 
               &ContextGLTest::pointerInput,
               &ContextGLTest::pointerInputTooFast,
               &ContextGLTest::scrollInput,
+              &ContextGLTest::coalescePointerInput,
               #ifdef MAGNUM_BUILD_DEPRECATED
               &ContextGLTest::mouseInput,
               &ContextGLTest::mouseInputTooFast,
               #endif
               &ContextGLTest::keyInput,
-              &ContextGLTest::textInput},
+              &ContextGLTest::textInput,
+              &ContextGLTest::redrawOnDemand},
         &ContextGLTest::drawSetup,
         &ContextGLTest::drawTeardown);
 
@@ -340,9 +379,31 @@ ContextGLTest::ContextGLTest() {
               #if IMGUI_VERSION_NUM >= 19200
               &ContextGLTest::drawTextSingleChannel,
               #endif
+              #ifndef IMGUI_HAS_TEXTURES
+              &ContextGLTest::drawTextSingleChannelAtlas,
+              #endif
+              #if IMGUI_VERSION_NUM >= 19200
+              &ContextGLTest::drawTextTextureUpdates,
+              &ContextGLTest::drawTextPrewarmGlyphs,
+              #endif
               &ContextGLTest::drawScissor,
               &ContextGLTest::drawVertexOffset,
-              &ContextGLTest::drawIndexOffset},
+              &ContextGLTest::drawIndexOffset,
+              &ContextGLTest::drawMultipleDrawLists,
+              &ContextGLTest::drawMultipleFrames,
+              &ContextGLTest::drawMergedBatches,
+              &ContextGLTest::drawCachedLayer,
+              &ContextGLTest::drawFrameStatistics,
+              &ContextGLTest::drawFrameStatisticsGpuTiming,
+              &ContextGLTest::drawFrameStatisticsAllocator,
+              &ContextGLTest::drawSharedResources,
+              &ContextGLTest::drawSharedResourcesAsync,
+              &ContextGLTest::drawSnapshot,
+              &ContextGLTest::drawSnapshotNoCurrentContext,
+              #if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+              &ContextGLTest::drawFontAtlasCache,
+              #endif
+              },
         &ContextGLTest::drawSetup,
         &ContextGLTest::drawTeardown);
 
@@ -464,6 +525,32 @@ void ContextGLTest::constructExistingContextAddFont() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+void ContextGLTest::constructSharedResources() {
+    {
+        SharedResources resources;
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        Context a{resources, {200, 200}};
+        Context b{resources, *ImGui::CreateContext(), {200, 200}};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(a.context());
+        CORRADE_VERIFY(b.context());
+        CORRADE_VERIFY(a.context() != b.context());
+        CORRADE_COMPARE(ImGui::GetCurrentContext(), b.context());
+
+        /* Compiled synchronously, so ready right away */
+        CORRADE_VERIFY(resources.isReady());
+        CORRADE_VERIFY(a.isReady());
+
+        /* Moving the context keeps referencing the same resources */
+        Context c{Utility::move(a)};
+        CORRADE_VERIFY(c.context());
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 void ContextGLTest::constructMove() {
     Context a{{200, 200}};
     ImGuiContext* context = a.context();
@@ -679,6 +766,53 @@ void ContextGLTest::relayoutDpiChange() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+void ContextGLTest::relayoutDpiChangeResidentAtlas() {
+    Context c{{200, 200}};
+    c.setResidentFontAtlasCount(2);
+
+    const GLuint texture1x = c.atlasTexture().id();
+    CORRADE_VERIFY(texture1x);
+
+    /* Changing the ratio builds a new atlas */
+    c.relayout({200, 200}, {200, 200}, {400, 400});
+    const GLuint texture2x = c.atlasTexture().id();
+    CORRADE_VERIFY(texture2x != texture1x);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->Fonts.size(), 1);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->Fonts[0]->FontSize, 26.0f);
+
+    /* Changing it back reuses the original one, and the other way as well */
+    c.relayout({200, 200}, {200, 200}, {200, 200});
+    CORRADE_COMPARE(c.atlasTexture().id(), texture1x);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->TexID, textureId(c.atlasTexture()));
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->Fonts.size(), 1);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->Fonts[0]->FontSize, 13.0f);
+    CORRADE_VERIFY(ImGui::GetIO().Fonts->Fonts[0]->IsLoaded());
+
+    c.relayout({200, 200}, {200, 200}, {400, 400});
+    CORRADE_COMPARE(c.atlasTexture().id(), texture2x);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->Fonts[0]->FontSize, 26.0f);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* A third ratio evicts the least recently used one, which is 1x */
+    c.relayout({200, 200}, {200, 200}, {600, 600});
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->Fonts[0]->FontSize, 39.0f);
+    c.relayout({200, 200}, {200, 200}, {400, 400});
+    CORRADE_COMPARE(c.atlasTexture().id(), texture2x);
+
+    /* The restored atlas should be usable for drawing */
+    c.newFrame();
+    c.drawFrame();
+    Utility::System::sleep(1);
+    c.newFrame();
+    ImGui::Button("test");
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 void ContextGLTest::relayoutDpiChangeCustomFont() {
     ImGui::CreateContext();
 
@@ -991,6 +1125,66 @@ void ContextGLTest::scrollInput() {
     c.drawFrame();
 }
 
+void ContextGLTest::coalescePointerInput() {
+    Context c{{200, 200}};
+    c.setFlags(Context::Flag::CoalesceEvents);
+
+    /* Consecutive moves result in just the last position */
+    PointerMoveEvent move1{PointerEventSource::Mouse, {}, {}, {10.5f, 10.5f}, {}};
+    PointerMoveEvent move2{PointerEventSource::Mouse, {}, {}, {20.5f, 20.5f}, {}};
+    PointerMoveEvent move3{PointerEventSource::Mouse, {}, {}, {30.5f, 30.5f}, {}};
+    c.handlePointerMoveEvent(move1);
+    c.handlePointerMoveEvent(move2);
+    c.handlePointerMoveEvent(move3);
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_COMPARE(Vector2{ImGui::GetMousePos()}, (Vector2{30.0f, 30.0f}));
+    c.drawFrame();
+
+    /* Scroll offsets at the same position get summed */
+    ScrollEvent scroll1{{1.0f, 0.5f}, {30.5f, 30.5f}, {}};
+    ScrollEvent scroll2{{0.5f, 0.25f}, {30.5f, 30.5f}, {}};
+    c.handleScrollEvent(scroll1);
+    c.handleScrollEvent(scroll2);
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_COMPARE_AS(ImGui::GetIO().MouseWheelH, 1.5f, Float);
+    CORRADE_COMPARE_AS(ImGui::GetIO().MouseWheel, 0.75f, Float);
+    c.drawFrame();
+
+    /* A press in between the moves gets the moves before passed to ImGui
+       first, so it happens at the position of its own event and not at the
+       position of the move that comes after */
+    PointerMoveEvent moveBefore{PointerEventSource::Mouse, {}, {}, {40.5f, 40.5f}, {}};
+    PointerEvent press{PointerEventSource::Mouse, Pointer::MouseLeft, {50.5f, 50.5f}, {}};
+    PointerMoveEvent moveAfter{PointerEventSource::Mouse, {}, Pointer::MouseLeft, {60.5f, 60.5f}, {}};
+    c.handlePointerMoveEvent(moveBefore);
+    c.handlePointerPressEvent(press);
+    c.handlePointerMoveEvent(moveAfter);
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_VERIFY(ImGui::IsMouseDown(ImGuiMouseButton_Left));
+    CORRADE_COMPARE(Vector2{ImGui::GetIO().MouseClickedPos[ImGuiMouseButton_Left]}, (Vector2{50.0f, 50.0f}));
+    c.drawFrame();
+
+    /* The last move gets to ImGui at latest in the frame after */
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_COMPARE(Vector2{ImGui::GetMousePos()}, (Vector2{60.0f, 60.0f}));
+    c.drawFrame();
+
+    /* Disabling the flag passes the merged events to ImGui right away */
+    PointerMoveEvent move4{PointerEventSource::Mouse, {}, Pointer::MouseLeft, {70.5f, 70.5f}, {}};
+    c.handlePointerMoveEvent(move4);
+    c.setFlags({});
+    PointerMoveEvent move5{PointerEventSource::Mouse, {}, Pointer::MouseLeft, {80.5f, 80.5f}, {}};
+    c.handlePointerMoveEvent(move5);
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_COMPARE(Vector2{ImGui::GetMousePos()}, (Vector2{80.0f, 80.0f}));
+    c.drawFrame();
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 void ContextGLTest::mouseInput() {
     Context c{{200, 200}};
@@ -1175,6 +1369,95 @@ void ContextGLTest::textInput() {
     c.drawFrame();
 }
 
+void ContextGLTest::redrawOnDemand() {
+    Context c{{200, 200}};
+
+    /* A new context needs to be drawn */
+    CORRADE_VERIFY(c.wantsRedraw());
+    CORRADE_COMPARE(c.nextRedrawDeadline(), 0.0f);
+
+    /* After a few frames it doesn't anymore */
+    for(std::size_t i = 0; i != 3; ++i) {
+        Utility::System::sleep(1);
+        c.newFrame();
+        c.drawFrame();
+    }
+    CORRADE_VERIFY(!c.wantsRedraw());
+    CORRADE_COMPARE(c.nextRedrawDeadline(), Constants::inf());
+
+    /* An event makes it need the frame processing it and two more */
+    PointerMoveEvent move{PointerEventSource::Mouse, {}, {}, {10.5f, 10.5f}, {}};
+    c.handlePointerMoveEvent(move);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(c.wantsRedraw());
+        Utility::System::sleep(1);
+        c.newFrame();
+        c.drawFrame();
+    }
+    CORRADE_VERIFY(!c.wantsRedraw());
+
+    /* A held button keeps it redrawing until released */
+    PointerEvent press{PointerEventSource::Mouse, Pointer::MouseLeft, {10.5f, 10.5f}, {}};
+    c.handlePointerPressEvent(press);
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(c.wantsRedraw());
+        Utility::System::sleep(1);
+        c.newFrame();
+        c.drawFrame();
+    }
+    PointerEvent release{PointerEventSource::Mouse, Pointer::MouseLeft, {10.5f, 10.5f}, {}};
+    c.handlePointerReleaseEvent(release);
+    for(std::size_t i = 0; i != 3; ++i) {
+        Utility::System::sleep(1);
+        c.newFrame();
+        c.drawFrame();
+    }
+    CORRADE_VERIFY(!c.wantsRedraw());
+
+    /* An active text input needs a redraw for the blinking cursor. The focus
+       gets applied in the frame after. */
+    char text[16]{};
+    for(std::size_t i = 0; i != 4; ++i) {
+        Utility::System::sleep(1);
+        c.newFrame();
+        ImGui::SetNextWindowPos({100.0f, 100.0f});
+        ImGui::Begin("Text");
+        if(i == 0)
+            ImGui::SetKeyboardFocusHere();
+        ImGui::InputText("text", text, sizeof(text));
+        ImGui::End();
+        c.drawFrame();
+    }
+    CORRADE_VERIFY(ImGui::GetIO().WantTextInput);
+    CORRADE_VERIFY(!c.wantsRedraw());
+    CORRADE_COMPARE_AS(c.nextRedrawDeadline(), 0.0f,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(c.nextRedrawDeadline(), 0.4f,
+        TestSuite::Compare::LessOrEqual);
+
+    /* A held modifier doesn't force a redraw every frame even if ImGui uses
+       the keyboard. The press itself needs the frame processing it and two
+       more. */
+    KeyEvent ctrl{KeyEvent::Key::LeftCtrl, KeyEvent::Modifier::Ctrl};
+    c.handleKeyPressEvent(ctrl);
+    for(std::size_t i = 0; i != 3; ++i) {
+        Utility::System::sleep(1);
+        c.newFrame();
+        ImGui::SetNextWindowPos({100.0f, 100.0f});
+        ImGui::Begin("Text");
+        ImGui::InputText("text", text, sizeof(text));
+        ImGui::End();
+        c.drawFrame();
+    }
+    CORRADE_VERIFY(ImGui::GetIO().WantCaptureKeyboard);
+    CORRADE_VERIFY(ImGui::GetIO().KeyCtrl);
+    CORRADE_VERIFY(!c.wantsRedraw());
+    CORRADE_COMPARE_AS(c.nextRedrawDeadline(), 0.0f,
+        TestSuite::Compare::Greater);
+}
+
 void ContextGLTest::updateCursor() {
     Context c{{200, 200}, {400, 400}, {300, 300}};
 
@@ -1752,6 +2035,168 @@ void ContextGLTest::drawTextSingleChannel() {
 }
 #endif
 
+#ifndef IMGUI_HAS_TEXTURES
+void ContextGLTest::drawTextSingleChannelAtlas() {
+    #if defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_SKIP("Single-channel textures not supported in OpenGL ES 2.0 or WebGL");
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_rg>())
+        CORRADE_SKIP(GL::Extensions::ARB::texture_rg::string() << "is not supported.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_swizzle>())
+        CORRADE_SKIP(GL::Extensions::ARB::texture_swizzle::string() << "is not supported.");
+    #endif
+
+    Context c{_framebuffer.viewport().size()};
+
+    /* The atlas has no colored glyphs, so it should be uploaded as a
+       single-channel texture. Reading it back as RGBA doesn't apply the
+       swizzle, so the green channel is zero everywhere, while an RGBA atlas
+       has it white. Reading texture data back is possible only on desktop. */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = c.atlasTexture().image(0, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    bool allZero = true;
+    for(Containers::StridedArrayView1D<const Color4ub> row: image.pixels<Color4ub>())
+        for(const Color4ub& pixel: row)
+            if(pixel.g()) allZero = false;
+    CORRADE_VERIFY(allZero);
+    #endif
+
+    /* Drawing gives the same result as with the RGBA atlas */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    drawList->AddRectFilled({size.x*0.1f, size.y*0.2f}, {size.x*0.9f, size.y*0.8f},
+        IM_COL32(255, 128, 128, 255));
+    drawList->AddText(nullptr, 0.0f,
+        {size.x*0.3f, size.y*0.3f}, IM_COL32(255, 255, 0, 200), "Alpha");
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Catch also ABI and interface mismatch errors */
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / PngImporter plugin can't be loaded.");
+
+    /* Same thresholds as in drawText() for older ImGui versions */
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw-text-single-channel.png"),
+        (DebugTools::CompareImageToFile{_manager, 35.0f, 0.4f}));
+}
+#endif
+
+#if IMGUI_VERSION_NUM >= 19200
+void ContextGLTest::drawTextTextureUpdates() {
+    #ifdef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::unpack_subimage>())
+        CORRADE_SKIP(GL::Extensions::EXT::unpack_subimage::string() << "is not supported, the whole texture is always uploaded.");
+    #else
+    CORRADE_SKIP("The whole texture is always uploaded on WebGL 1.");
+    #endif
+    #endif
+
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame, but creates the atlas */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(c.frameStatistics().textureCreateCount, 1);
+
+    Utility::System::sleep(1);
+
+    /* Text in a size that wasn't used yet rasterizes new glyphs into the
+       existing atlas, which then gets updated */
+    c.newFrame();
+    ImGui::PushFont(nullptr, 48.0f);
+    ImGui::GetForegroundDrawList()->AddText({0.0f, 0.0f}, IM_COL32(255, 255, 255, 255), "Hello, AVAV!");
+    ImGui::PopFont();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const FrameStatistics& statistics = c.frameStatistics();
+    const ImTextureData& atlas = *ImGui::GetIO().Fonts->TexData;
+    /* If the atlas had to grow, it's created anew instead */
+    if(statistics.textureCreateCount)
+        CORRADE_SKIP("The atlas got recreated instead of updated.");
+
+    /* Only the updated rectangles are uploaded, not the whole atlas */
+    CORRADE_COMPARE(statistics.textureUpdateCount, 1);
+    CORRADE_VERIFY(statistics.textureUploadedBytes);
+    CORRADE_COMPARE_AS(statistics.textureUploadedBytes,
+        UnsignedLong(atlas.GetSizeInBytes()),
+        TestSuite::Compare::Less);
+}
+
+void ContextGLTest::drawTextPrewarmGlyphs() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame, but creates the atlas */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* A zero budget means one glyph per frame */
+    ImFont& font = *ImGui::GetIO().Fonts->Fonts[0];
+    c.setGlyphPrewarmBudget(0)
+     .prewarmGlyphs(font, 48.0f, {{U'A', U'C'}, {U'x', U'x'}});
+    CORRADE_VERIFY(c.isPrewarmingGlyphs());
+
+    const char32_t glyphs[]{U'A', U'B', U'C', U'x'};
+    for(std::size_t i = 0; i != Containers::arraySize(glyphs); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(c.isPrewarmingGlyphs());
+
+        Utility::System::sleep(1);
+
+        c.newFrame();
+
+        /* The glyph is rasterized in newFrame(), the next one not yet */
+        ImFontBaked* baked = font.GetFontBaked(48.0f);
+        CORRADE_VERIFY(baked->IsGlyphLoaded(ImWchar(glyphs[i])));
+        if(i + 1 != Containers::arraySize(glyphs))
+            CORRADE_VERIFY(!baked->IsGlyphLoaded(ImWchar(glyphs[i + 1])));
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(c.frameStatistics().textureUpdateCount + c.frameStatistics().textureCreateCount, 1);
+    }
+
+    CORRADE_VERIFY(!c.isPrewarmingGlyphs());
+
+    /* Glyphs that are already rasterized are skipped, so there's nothing
+       uploaded next frame */
+    c.prewarmGlyphs(font, 48.0f, {{U'A', U'C'}});
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_VERIFY(!c.isPrewarmingGlyphs());
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(c.frameStatistics().textureUploadedBytes, 0);
+}
+#endif
+
 void ContextGLTest::drawScissor() {
     Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
 
@@ -1903,6 +2348,632 @@ void ContextGLTest::drawIndexOffset() {
         (DebugTools::CompareImage{1.0f, 0.5f}));
 }
 
+void ContextGLTest::drawMultipleDrawLists() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* First and last drawlist that gets rendered, both cover the entire
+       display */
+    ImDrawList* backgroundDrawList = ImGui::GetBackgroundDrawList();
+    ImDrawList* foregroundDrawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    /* If the vertex and index offsets of the foreground draw list weren't
+       applied when all draw lists are uploaded at once, the foreground would
+       draw the red background vertices again */
+    backgroundDrawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    backgroundDrawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    foregroundDrawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawMultipleFrames() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Draw more frames than there are streaming buffer regions, with the
+       amount of data growing each frame to trigger a reallocation in the
+       middle, and with each frame drawing a different color. If a stale
+       region or wrong offsets were used, the colors would mismatch. */
+    const Color4ub colors[]{
+        {255, 0, 0, 255},
+        {0, 0, 255, 255},
+        {255, 255, 0, 255},
+        {0, 255, 255, 255},
+        {0, 255, 0, 255}
+    };
+    std::size_t count = 1;
+    for(std::size_t i = 0; i != Containers::arraySize(colors); ++i, count *= 10) {
+        CORRADE_ITERATION(i);
+
+        Utility::System::sleep(1);
+
+        c.newFrame();
+
+        /* Last drawlist that gets rendered, covers the entire display */
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+        /* Cover the display 1, 10, 100, 1000 and 10000 times */
+        for(std::size_t j = 0; j != count; ++j)
+            drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(colors[i].r(), colors[i].g(), colors[i].b(), 255));
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+        for(Color4ub& p: pixels)
+            p = colors[i];
+
+        CORRADE_COMPARE_WITH(
+            _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+            (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+            (DebugTools::CompareImage{1.0f, 0.5f}));
+    }
+}
+
+
+void ContextGLTest::drawMergedBatches() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    const Color4ub pixel{0, 0, 255, 255};
+    GL::Texture2D texture;
+    texture.setImage(0, GL::TextureFormat::RGBA, ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, Containers::arrayView(&pixel, 1)})
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base);
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* The first rect in each draw list has the same texture and clip rect, so
+       they're merged into a single multi-draw if base vertex is supported.
+       Each following command changes either the clip rect or the texture and
+       thus needs a draw call of its own. */
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+    ImGui::GetBackgroundDrawList()->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    drawList->AddRectFilled({0.0f, 0.0f}, {size.x*0.5f, size.y}, IM_COL32(0, 255, 0, 255));
+    drawList->PushClipRect({0.0f, 0.0f}, {size.x*0.5f, size.y*0.5f});
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 255, 0, 255));
+    drawList->PopClipRect();
+    drawList->AddImage(textureId(texture), {size.x*0.5f, 0.0f}, {size.x, size.y*0.5f});
+    drawList->AddRectFilled({size.x*0.5f, size.y*0.5f}, size, IM_COL32(0, 255, 255, 255));
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const FrameStatistics& statistics = c.frameStatistics();
+    CORRADE_COMPARE(statistics.drawListCount, 2);
+    CORRADE_COMPARE(statistics.drawCommandCount, 5);
+    CORRADE_COMPARE(statistics.drawCallCount,
+        ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset ? 4 : 5);
+}
+
+void ContextGLTest::drawCachedLayer() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    c.setFlags(Context::Flag::CachedLayer);
+    CORRADE_COMPARE(c.flags(), Context::Flag::CachedLayer);
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The second frame has the same contents as the first, so only the layer
+       gets composited. The third is different and translucent, verifying
+       it gets rendered again and is correctly blended. The framebuffer is
+       cleared before each frame, so the layer has to be drawn every time. */
+    const Color4ub colors[]{
+        {255, 0, 0, 255},
+        {255, 0, 0, 255},
+        {255, 0, 0, 128}
+    };
+    const Color4ub expected[]{
+        {255, 0, 0, 255},
+        {255, 0, 0, 255},
+        {192, 64, 127, 255}
+    };
+    for(std::size_t i = 0; i != Containers::arraySize(colors); ++i) {
+        CORRADE_ITERATION(i);
+
+        Utility::System::sleep(1);
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+
+        c.newFrame();
+
+        ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, ImGui::GetIO().DisplaySize, IM_COL32(colors[i].r(), colors[i].g(), colors[i].b(), colors[i].a()));
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+        for(Color4ub& p: pixels)
+            p = expected[i];
+
+        CORRADE_COMPARE_WITH(
+            _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+            (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+            (DebugTools::CompareImage{1.0f, 0.5f}));
+    }
+
+    /* Disabling the flag draws directly again */
+    c.setFlags({});
+    c.newFrame();
+    ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, ImGui::GetIO().DisplaySize, IM_COL32(0, 255, 0, 255));
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawFrameStatistics() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    CORRADE_COMPARE(c.frameStatistics().drawCallCount, 0);
+
+    /* ImGui doesn't draw anything the first frame, but creates the font
+       atlas on 1.92+ */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    {
+        const FrameStatistics& statistics = c.frameStatistics();
+        CORRADE_COMPARE(statistics.drawCallCount, 0);
+        CORRADE_COMPARE(statistics.vertexCount, 0);
+        CORRADE_COMPARE(statistics.indexCount, 0);
+        CORRADE_COMPARE(statistics.uploadedBytes, 0);
+        #ifdef IMGUI_HAS_TEXTURES
+        CORRADE_COMPARE(statistics.textureCreateCount, 1);
+        CORRADE_VERIFY(statistics.textureUploadedBytes);
+        CORRADE_VERIFY(statistics.textureUploadDuration);
+        CORRADE_COMPARE_AS(statistics.textureUploadDuration,
+            statistics.drawFrameDuration,
+            TestSuite::Compare::LessOrEqual);
+        #else
+        CORRADE_COMPARE(statistics.textureCreateCount, 0);
+        CORRADE_COMPARE(statistics.textureUploadedBytes, 0);
+        CORRADE_COMPARE(statistics.textureUploadDuration, 0);
+        #endif
+        CORRADE_COMPARE(statistics.textureUpdateCount, 0);
+        CORRADE_COMPARE(statistics.textureDestroyCount, 0);
+        CORRADE_COMPARE(statistics.gpuDuration, 0);
+    }
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Both draw lists have the same texture and clip rect, so they're drawn
+       with a single multi-draw if base vertex is supported */
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+    ImGui::GetBackgroundDrawList()->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    {
+        const FrameStatistics& statistics = c.frameStatistics();
+        CORRADE_COMPARE(statistics.drawListCount, 2);
+        CORRADE_COMPARE(statistics.drawCommandCount, 2);
+        CORRADE_COMPARE(statistics.drawCallCount,
+            ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset ? 1 : 2);
+        CORRADE_COMPARE(statistics.vertexCount, 8);
+        CORRADE_COMPARE(statistics.indexCount, 12);
+        CORRADE_COMPARE(statistics.uploadedBytes, 8*sizeof(ImDrawVert) + 12*sizeof(ImDrawIdx));
+        CORRADE_COMPARE(statistics.textureCreateCount, 0);
+        CORRADE_COMPARE(statistics.textureUpdateCount, 0);
+        CORRADE_COMPARE(statistics.textureDestroyCount, 0);
+        CORRADE_COMPARE(statistics.textureUploadedBytes, 0);
+        CORRADE_VERIFY(statistics.drawFrameDuration);
+    }
+
+    /* With the cached layer, nothing gets uploaded if the contents stay the
+       same, and only the layer gets drawn */
+    c.setFlags(Context::Flag::CachedLayer);
+    for(std::size_t i = 0; i != 2; ++i) {
+        CORRADE_ITERATION(i);
+
+        Utility::System::sleep(1);
+
+        c.newFrame();
+        ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    {
+        const FrameStatistics& statistics = c.frameStatistics();
+        CORRADE_COMPARE(statistics.drawListCount, 1);
+        CORRADE_COMPARE(statistics.drawCommandCount, 1);
+        CORRADE_COMPARE(statistics.drawCallCount, 1);
+        CORRADE_COMPARE(statistics.vertexCount, 0);
+        CORRADE_COMPARE(statistics.indexCount, 0);
+        CORRADE_COMPARE(statistics.uploadedBytes, 0);
+    }
+}
+
+void ContextGLTest::drawFrameStatisticsGpuTiming() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query_webgl2::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    c.setFlags(Context::Flag::GpuTiming);
+
+    /* The result is available only with a delay, keep drawing until it
+       is */
+    std::size_t i = 0;
+    for(; i != 100 && !c.frameStatistics().gpuDuration; ++i) {
+        Utility::System::sleep(1);
+
+        c.newFrame();
+        ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, ImGui::GetIO().DisplaySize, IM_COL32(0, 255, 0, 255));
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    CORRADE_INFO("GPU duration available after" << i << "frames");
+    /* The query ring has three entries so it can't be faster than that */
+    CORRADE_COMPARE_AS(i, 3, TestSuite::Compare::Greater);
+    CORRADE_VERIFY(c.frameStatistics().gpuDuration);
+
+    /* Disabling the flag resets the duration */
+    c.setFlags({});
+    CORRADE_COMPARE(c.frameStatistics().gpuDuration, 0);
+}
+
+void ContextGLTest::drawFrameStatisticsAllocator() {
+    Allocator allocator;
+
+    {
+        Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+        /* The first frame allocates windows, draw lists and such */
+        const auto ui = []() {
+            ImGui::Begin("Window");
+            ImGui::Text("Hello");
+            ImGui::End();
+        };
+        c.newFrame();
+        ui();
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(c.frameStatistics().allocationCount);
+        CORRADE_VERIFY(c.frameStatistics().allocatedBytes);
+
+        /* Once everything settles, drawing the same UI allocates nothing */
+        for(std::size_t i = 0; i != 3; ++i) {
+            Utility::System::sleep(1);
+            c.newFrame();
+            ui();
+            c.drawFrame();
+        }
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(c.frameStatistics().allocationCount, 0);
+        CORRADE_COMPARE(c.frameStatistics().allocatedBytes, 0);
+    }
+
+    /* Destroying the context frees everything */
+    CORRADE_COMPARE(allocator.statistics().liveAllocationCount, 0);
+}
+
+void ContextGLTest::drawSharedResources() {
+    SharedResources resources;
+    Context a{resources, {200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    Context b{resources, {100, 100}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    a.newFrame();
+    a.drawFrame();
+    b.newFrame();
+    b.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    /* Each context sets its own projection to the shared shader, if it
+       didn't, the second context would draw just a quarter of the
+       framebuffer */
+    const Color4ub colors[]{
+        {255, 0, 0, 255},
+        {0, 255, 0, 255}
+    };
+    Context* contexts[]{&a, &b};
+    for(std::size_t i = 0; i != Containers::arraySize(contexts); ++i) {
+        CORRADE_ITERATION(i);
+
+        contexts[i]->newFrame();
+        ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, ImGui::GetIO().DisplaySize, IM_COL32(colors[i].r(), colors[i].g(), colors[i].b(), 255));
+        contexts[i]->drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+        for(Color4ub& p: pixels)
+            p = colors[i];
+
+        CORRADE_COMPARE_WITH(
+            _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+            (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+            (DebugTools::CompareImage{1.0f, 0.5f}));
+    }
+}
+
+void ContextGLTest::drawSharedResourcesAsync() {
+    SharedResources resources = SharedResources::compile();
+    Context context{resources, {200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* It may or may not be ready yet depending on the driver, but drawing
+       shouldn't fail in either case */
+    Debug{} << "Ready right after construction:" << context.isReady();
+    context.newFrame();
+    context.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Nothing drawn if not ready */
+    if(!context.isReady())
+        CORRADE_COMPARE(context.frameStatistics().drawCallCount, 0);
+
+    /* Querying the shader waits for it */
+    CORRADE_VERIFY(resources.shader().id());
+    CORRADE_VERIFY(resources.isReady());
+    CORRADE_VERIFY(context.isReady());
+
+    Utility::System::sleep(1);
+
+    context.newFrame();
+    ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, ImGui::GetIO().DisplaySize, IM_COL32(255, 0, 0, 255));
+    context.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(context.frameStatistics().drawCallCount);
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = {255, 0, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawSnapshot() {
+    /* Like drawTextDpiScaled(), but with UI construction pipelined with
+       drawing */
+    Context c{{32, 32}, {32, 32}, _framebuffer.viewport().size()};
+
+    /* The first snapshot gets drawn only after the second is rendered. On
+       ImGui 1.92 and newer the first snapshot creates the font atlas texture
+       and the second uploads to it. */
+    c.newFrame();
+    DrawDataSnapshot& first = c.render();
+    CORRADE_COMPARE(first.frame(), 1);
+
+    c.newFrame();
+    DrawDataSnapshot& second = c.render();
+    CORRADE_COMPARE(second.frame(), 2);
+    CORRADE_VERIFY(&second != &first);
+
+    c.draw(first);
+    c.draw(second);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    drawList->AddRectFilled({size.x*0.1f, size.y*0.2f}, {size.x*0.9f, size.y*0.8f},
+        IM_COL32(255, 128, 128, 255));
+    /* Use default font at default size */
+    drawList->AddText(nullptr, 0.0f,
+        {size.x*0.15f, size.y*0.3f}, IM_COL32(255, 255, 0, 200), "DPI");
+
+    /* The first snapshot memory gets reused for the third frame. At this
+       point the ImGui atlas has the texture ID assigned. */
+    DrawDataSnapshot& third = c.render();
+    CORRADE_COMPARE(&third, &first);
+    CORRADE_COMPARE(third.frame(), 3);
+    CORRADE_VERIFY(third.drawData().TotalVtxCount);
+    #ifdef IMGUI_HAS_TEXTURES
+    CORRADE_VERIFY(ImGui::GetIO().Fonts->TexData->GetTexID() != ImTextureID_Invalid);
+    #endif
+
+    /* Building the next frame doesn't affect the snapshot */
+    c.newFrame();
+    ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 0, 255, 255));
+
+    c.draw(third);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Statistics of the third snapshot get included only once render()
+       reuses it, two frames later. Nothing gets drawn in the meantime. */
+    c.render();
+    c.newFrame();
+    c.render();
+    CORRADE_VERIFY(c.frameStatistics().drawCallCount);
+    CORRADE_VERIFY(c.frameStatistics().drawFrameDuration);
+
+    /* Catch also ABI and interface mismatch errors */
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / PngImporter plugin can't be loaded.");
+
+    /* Same as in drawTextDpiScaled() */
+    #if IMGUI_VERSION_NUM < 19200
+    constexpr Float MaxThreshold = 67.0f;
+    constexpr Float MeanThreshold = 1.9f;
+    #else
+    constexpr Float MaxThreshold = 3.0f;
+    constexpr Float MeanThreshold = 0.4f;
+    #endif
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw-text-dpi-scaled.png"),
+        (DebugTools::CompareImageToFile{_manager, MaxThreshold, MeanThreshold}));
+}
+
+void ContextGLTest::drawSnapshotNoCurrentContext() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    DrawDataSnapshot& first = c.render();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+    ImGui::GetForegroundDrawList()->AddRectFilled({0.0f, 0.0f}, ImGui::GetIO().DisplaySize, IM_COL32(255, 0, 0, 255));
+    DrawDataSnapshot& second = c.render();
+
+    /* A render thread has no ImGui context current, draw() shouldn't need
+       it */
+    ImGui::SetCurrentContext(nullptr);
+    c.draw(first);
+    c.draw(second);
+    CORRADE_VERIFY(!ImGui::GetCurrentContext());
+    ImGui::SetCurrentContext(c.context());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = {255, 0, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+
+    /* The statistics of the second snapshot are included once render()
+       reuses it */
+    c.newFrame();
+    c.render();
+    c.newFrame();
+    c.render();
+    CORRADE_VERIFY(c.frameStatistics().drawCallCount);
+}
+
+#if !defined(IMGUI_HAS_TEXTURES) && IMGUI_VERSION_NUM >= 19000
+void ContextGLTest::drawFontAtlasCache() {
+    const Containers::String directory = Utility::Path::join(IMGUIINTEGRATION_TEST_OUTPUT_DIR, "ImGuiIntegrationTestFiles/font-atlas-cache");
+    if(Utility::Path::exists(directory)) {
+        Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+        CORRADE_VERIFY(files);
+        for(const Containers::String& file: *files)
+            CORRADE_VERIFY(Utility::Path::remove(Utility::Path::join(directory, file)));
+    }
+
+    SharedResources resources;
+    resources.setFontAtlasCacheDirectory(directory);
+    CORRADE_COMPARE(resources.fontAtlasCacheDirectory(), directory);
+
+    Containers::Optional<Image2D> images[2];
+    Int glyphCounts[2];
+    for(std::size_t i = 0; i != Containers::arraySize(images); ++i) {
+        CORRADE_ITERATION(i);
+
+        /* The first context rasterizes the atlas and saves it, the second
+           loads it from the cache */
+        Context c{resources, {200, 200}, {70, 70}, _framebuffer.viewport().size()};
+        glyphCounts[i] = ImGui::GetIO().Fonts->Fonts[0]->Glyphs.Size;
+
+        Containers::Optional<Containers::Array<Containers::String>> files = Utility::Path::list(directory, Utility::Path::ListFlag::SkipDirectories|Utility::Path::ListFlag::SkipDotAndDotDot);
+        CORRADE_VERIFY(files);
+        CORRADE_COMPARE(files->size(), 1);
+
+        /* ImGui doesn't draw anything the first frame */
+        c.newFrame();
+        c.drawFrame();
+
+        Utility::System::sleep(1);
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        c.newFrame();
+        ImGui::GetForegroundDrawList()->AddText({0.0f, 0.0f}, IM_COL32(255, 255, 255, 255), "Hello, cache!");
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        images[i] = _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    }
+
+    /* The cached atlas should result in exactly the same output */
+    CORRADE_COMPARE(glyphCounts[1], glyphCounts[0]);
+    CORRADE_COMPARE_WITH(*images[1], *images[0],
+        (DebugTools::CompareImage{0.0f, 0.0f}));
+}
+#endif
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ContextGLTest)
@@ -24,6 +24,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/ImGuiIntegration/Context.h"
@@ -33,19 +34,48 @@ namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
 struct ContextTest: TestSuite::Tester {
     explicit ContextTest();
 
+    void debugFlag();
+    void debugFlags();
+
     void constructNoCreate();
     void constructCopy();
+
+    void setFlags();
+    void setGlyphPrewarmBudget();
+    void setResidentFontAtlasCount();
+    void setResidentFontAtlasCountZero();
 };
 
 ContextTest::ContextTest() {
-    addTests({&ContextTest::constructNoCreate,
-              &ContextTest::constructCopy});
+    addTests({&ContextTest::debugFlag,
+              &ContextTest::debugFlags,
+
+              &ContextTest::constructNoCreate,
+              &ContextTest::constructCopy,
+
+              &ContextTest::setFlags,
+              &ContextTest::setGlyphPrewarmBudget,
+              &ContextTest::setResidentFontAtlasCount,
+              &ContextTest::setResidentFontAtlasCountZero});
+}
+
+void ContextTest::debugFlag() {
+    Containers::String out;
+    Debug{&out} << Context::Flag::CachedLayer << Context::Flag(0xde);
+    CORRADE_COMPARE(out, "ImGuiIntegration::Context::Flag::CachedLayer ImGuiIntegration::Context::Flag(0xde)\n");
+}
+
+void ContextTest::debugFlags() {
+    Containers::String out;
+    Debug{&out} << (Context::Flag::CachedLayer|Context::Flag::GpuTiming|Context::Flag(0x80)) << Context::Flags{};
+    CORRADE_COMPARE(out, "ImGuiIntegration::Context::Flag::CachedLayer|ImGuiIntegration::Context::Flag::GpuTiming|ImGuiIntegration::Context::Flag(0x80) ImGuiIntegration::Context::Flags{}\n");
 }
 
 void ContextTest::constructNoCreate() {
     {
         Context context{NoCreate};
         CORRADE_COMPARE(context.context(), nullptr);
+        CORRADE_COMPARE(context.frameStatistics().drawCallCount, 0);
     }
 
     CORRADE_VERIFY(true);
@@ -56,6 +86,53 @@ void ContextTest::constructCopy() {
     CORRADE_VERIFY(!std::is_assignable<Context, const Context&>{});
 }
 
+void ContextTest::setFlags() {
+    /* The flags are only used in drawFrame(), so this doesn't need a GL
+       context */
+    Context context{NoCreate};
+    CORRADE_COMPARE(context.flags(), Context::Flags{});
+
+    context.setFlags(Context::Flag::CachedLayer);
+    CORRADE_COMPARE(context.flags(), Context::Flag::CachedLayer);
+
+    /* Does nothing as there's no layer created yet */
+    context.invalidateCachedLayer();
+
+    context.setFlags({});
+    CORRADE_COMPARE(context.flags(), Context::Flags{});
+}
+
+
+void ContextTest::setGlyphPrewarmBudget() {
+    /* The budget is only used in newFrame(), so this doesn't need a GL
+       context either */
+    Context context{NoCreate};
+    CORRADE_COMPARE(context.glyphPrewarmBudget(), 65536);
+    CORRADE_VERIFY(!context.isPrewarmingGlyphs());
+
+    context.setGlyphPrewarmBudget(1024);
+    CORRADE_COMPARE(context.glyphPrewarmBudget(), 1024);
+}
+
+void ContextTest::setResidentFontAtlasCount() {
+    /* Used only in relayout(), so no GL context needed here either */
+    Context context{NoCreate};
+    CORRADE_COMPARE(context.residentFontAtlasCount(), 3);
+
+    context.setResidentFontAtlasCount(1);
+    CORRADE_COMPARE(context.residentFontAtlasCount(), 1);
+}
+
+void ContextTest::setResidentFontAtlasCountZero() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Context context{NoCreate};
+
+    Containers::String out;
+    Error redirectError{&out};
+    context.setResidentFontAtlasCount(0);
+    CORRADE_COMPARE(out, "ImGuiIntegration::Context::setResidentFontAtlasCount(): expected a non-zero count\n");
+}
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ContextTest)
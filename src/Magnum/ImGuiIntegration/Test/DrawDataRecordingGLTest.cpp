@@ -0,0 +1,274 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2018 Jonathan Hale <squareys@googlemail.com>
+    Copyright © 2024, 2025, 2026 Pablo Escobar <mail@rvrs.in>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/System.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/Math/Color.h>
+
+#include "Magnum/ImGuiIntegration/Context.hpp"
+#include "Magnum/ImGuiIntegration/DrawDataRecording.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct DrawDataRecordingGLTest: GL::OpenGLTester {
+    explicit DrawDataRecordingGLTest();
+
+    void drawSetup();
+    void drawTeardown();
+
+    void recordReplay();
+    void replayRepeated();
+    void replayNoCurrentContext();
+    void replayInvalid();
+
+    private:
+        Containers::Array<char> draw(Context& context);
+        Containers::Array<char> read();
+
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+DrawDataRecordingGLTest::DrawDataRecordingGLTest() {
+    addTests({&DrawDataRecordingGLTest::recordReplay,
+              &DrawDataRecordingGLTest::replayRepeated,
+              &DrawDataRecordingGLTest::replayNoCurrentContext,
+              &DrawDataRecordingGLTest::replayInvalid},
+        &DrawDataRecordingGLTest::drawSetup,
+        &DrawDataRecordingGLTest::drawTeardown);
+
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendEquation(GL::Renderer::BlendEquation::Add, GL::Renderer::BlendEquation::Add);
+    GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::SourceAlpha, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+
+    GL::Renderer::disable(GL::Renderer::Feature::FaceCulling);
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
+}
+
+constexpr Vector2i DrawSize{64, 64};
+
+void DrawDataRecordingGLTest::drawSetup() {
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        DrawSize);
+
+    _framebuffer = GL::Framebuffer{{{}, DrawSize}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .clear(GL::FramebufferClear::Color)
+        .bind();
+}
+
+void DrawDataRecordingGLTest::drawTeardown() {
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+}
+
+Containers::Array<char> DrawDataRecordingGLTest::draw(Context& context) {
+    Utility::System::sleep(1);
+
+    context.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+    drawList->AddRectFilled({size.x*0.1f, size.y*0.2f}, {size.x*0.9f, size.y*0.8f},
+        IM_COL32(255, 128, 128, 255));
+    /* Use default font at default size, to have the font atlas used */
+    drawList->AddText(nullptr, 0.0f,
+        {size.x*0.15f, size.y*0.3f}, IM_COL32(255, 255, 0, 200), "Rec");
+
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    context.drawFrame();
+    return read();
+}
+
+Containers::Array<char> DrawDataRecordingGLTest::read() {
+    Image2D image = _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    return image.release();
+}
+
+void DrawDataRecordingGLTest::recordReplay() {
+    DrawDataRecorder recorder;
+    Containers::Array<char> expected;
+    {
+        Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+
+        /* A dummy frame first as ImGui doesn't draw anything the first frame.
+           It creates the font atlas texture on ImGui 1.92+, which then has to
+           get recorded as well even though it existed before the recorder
+           was set. */
+        c.newFrame();
+        c.drawFrame();
+
+        c.setRecorder(&recorder);
+        CORRADE_COMPARE(c.recorder(), &recorder);
+        expected = draw(c);
+        c.setRecorder(nullptr);
+
+        /* This frame isn't recorded anymore */
+        draw(c);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    CORRADE_COMPARE(recorder.frameCount(), 1);
+
+    Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(Containers::Array<char>{InPlaceInit, recorder.data()});
+    CORRADE_VERIFY(recording);
+    CORRADE_COMPARE(recording->frameCount(), 1);
+    CORRADE_COMPARE(recording->displaySize(0), Vector2{DrawSize});
+
+    /* Replay in a completely new context, without building any UI in it */
+    Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    c.replay(*recording, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(c.frameStatistics().drawCallCount);
+
+    CORRADE_COMPARE_AS(read(), expected,
+        TestSuite::Compare::Container);
+}
+
+void DrawDataRecordingGLTest::replayRepeated() {
+    DrawDataRecorder recorder;
+    Containers::Array<char> expected;
+    {
+        Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+        c.setRecorder(&recorder);
+        c.newFrame();
+        c.drawFrame();
+        draw(c);
+        expected = draw(c);
+    }
+
+    CORRADE_COMPARE(recorder.frameCount(), 3);
+
+    Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(Containers::Array<char>{InPlaceInit, recorder.data()});
+    CORRADE_VERIFY(recording);
+    CORRADE_COMPARE(recording->frameCount(), 3);
+
+    /* Replaying the whole recording several times in a loop recreates the
+       textures each time without leaking the previous ones. The statistics
+       are reset for every replayed frame, so they don't accumulate. */
+    Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+    FrameStatistics expectedStatistics{};
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        for(std::size_t frame = 0; frame != recording->frameCount(); ++frame) {
+            CORRADE_ITERATION(frame);
+            _framebuffer.clear(GL::FramebufferClear::Color);
+            c.replay(*recording, frame);
+        }
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        CORRADE_COMPARE_AS(read(), expected,
+            TestSuite::Compare::Container);
+
+        const FrameStatistics& statistics = c.frameStatistics();
+        CORRADE_VERIFY(statistics.drawCallCount);
+        if(i == 0) {
+            expectedStatistics = statistics;
+            continue;
+        }
+        CORRADE_COMPARE(statistics.drawListCount, expectedStatistics.drawListCount);
+        CORRADE_COMPARE(statistics.drawCommandCount, expectedStatistics.drawCommandCount);
+        CORRADE_COMPARE(statistics.drawCallCount, expectedStatistics.drawCallCount);
+        CORRADE_COMPARE(statistics.vertexCount, expectedStatistics.vertexCount);
+        CORRADE_COMPARE(statistics.indexCount, expectedStatistics.indexCount);
+        CORRADE_COMPARE(statistics.uploadedBytes, expectedStatistics.uploadedBytes);
+        CORRADE_COMPARE(statistics.textureCreateCount, expectedStatistics.textureCreateCount);
+        CORRADE_COMPARE(statistics.textureUpdateCount, expectedStatistics.textureUpdateCount);
+        CORRADE_COMPARE(statistics.textureDestroyCount, expectedStatistics.textureDestroyCount);
+        CORRADE_COMPARE(statistics.textureUploadedBytes, expectedStatistics.textureUploadedBytes);
+    }
+}
+
+void DrawDataRecordingGLTest::replayNoCurrentContext() {
+    DrawDataRecorder recorder;
+    Containers::Array<char> expected;
+    {
+        Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+        c.newFrame();
+        c.drawFrame();
+        c.setRecorder(&recorder);
+        expected = draw(c);
+    }
+
+    Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(Containers::Array<char>{InPlaceInit, recorder.data()});
+    CORRADE_VERIFY(recording);
+    CORRADE_COMPARE(recording->frameCount(), 1);
+
+    /* Replaying doesn't need any ImGui context to be current, the vertex
+       offset support is remembered by the context on construction */
+    Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+    ImGui::SetCurrentContext(nullptr);
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    c.replay(*recording, 0);
+    CORRADE_VERIFY(!ImGui::GetCurrentContext());
+    ImGui::SetCurrentContext(c.context());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(c.frameStatistics().drawCallCount);
+
+    CORRADE_COMPARE_AS(read(), expected,
+        TestSuite::Compare::Container);
+}
+
+void DrawDataRecordingGLTest::replayInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    DrawDataRecorder recorder;
+    Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(Containers::Array<char>{InPlaceInit, recorder.data()});
+    CORRADE_VERIFY(recording);
+
+    Context c{Vector2{DrawSize}, DrawSize, DrawSize};
+
+    Containers::String out;
+    Error redirectError{&out};
+    c.replay(*recording, 0);
+    recording->displaySize(0);
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::Context::replay(): frame 0 out of range for 0 frames\n"
+        "ImGuiIntegration::DrawDataRecording::displaySize(): frame 0 out of range for 0 frames\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::DrawDataRecordingGLTest)
@@ -0,0 +1,268 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <imgui.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Vector4.h>
+
+#include "Magnum/ImGuiIntegration/DrawDataRecording.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct DrawDataRecordingTest: TestSuite::Tester {
+    explicit DrawDataRecordingTest();
+
+    void recorderConstruct();
+    void recorderConstructCopy();
+
+    void construct();
+    void constructCopy();
+
+    void fromDataInvalid();
+    void fromDataIndexOutOfRange();
+    void fromDataTextureTooLarge();
+    void loadFailed();
+};
+
+const struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    char value;
+    const char* message;
+} FromDataInvalidData[]{
+    {"too short", 7, 0, 0,
+        "expected at least 8 bytes but got 7"},
+    {"invalid signature", 8, 3, 'X',
+        "invalid signature"},
+    {"unsupported version", 8, 4, 2,
+        "unsupported version 2"},
+    /* A frame header is 36 bytes */
+    {"truncated frame header", 8 + 35, 0, 0,
+        "frame 0 is truncated"},
+    {"zero frame size", 8 + 36, 0, 0,
+        "frame 0 has an invalid size 0"},
+    /* The frame size is a little-endian 32-bit number at the start of the
+       header */
+    {"frame size larger than the data", 8 + 36, 8, 37,
+        "frame 0 has an invalid size 37"},
+    {"frame size not matching contents", 8 + 37, 8, 37,
+        "frame 0 is corrupted"},
+};
+
+DrawDataRecordingTest::DrawDataRecordingTest() {
+    addTests({&DrawDataRecordingTest::recorderConstruct,
+              &DrawDataRecordingTest::recorderConstructCopy,
+
+              &DrawDataRecordingTest::construct,
+              &DrawDataRecordingTest::constructCopy});
+
+    addInstancedTests({&DrawDataRecordingTest::fromDataInvalid},
+        Containers::arraySize(FromDataInvalidData));
+
+    addTests({&DrawDataRecordingTest::fromDataIndexOutOfRange,
+              &DrawDataRecordingTest::fromDataTextureTooLarge,
+              &DrawDataRecordingTest::loadFailed});
+}
+
+template<class T> void append(Containers::Array<char>& out, const T& value) {
+    arrayAppend(out, Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+void DrawDataRecordingTest::recorderConstruct() {
+    DrawDataRecorder recorder;
+    CORRADE_COMPARE(recorder.frameCount(), 0);
+    /* Just the file header */
+    CORRADE_COMPARE(recorder.data().size(), 8);
+    CORRADE_COMPARE(Containers::StringView{recorder.data().prefix(4)}, "MIDR");
+
+    recorder.clear();
+    CORRADE_COMPARE(recorder.frameCount(), 0);
+    CORRADE_COMPARE(recorder.data().size(), 8);
+}
+
+void DrawDataRecordingTest::recorderConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DrawDataRecorder>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DrawDataRecorder>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DrawDataRecorder>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DrawDataRecorder>::value);
+}
+
+void DrawDataRecordingTest::construct() {
+    DrawDataRecorder recorder;
+
+    /* A recording without any frames is valid */
+    Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(Containers::Array<char>{InPlaceInit, recorder.data()});
+    CORRADE_VERIFY(recording);
+    CORRADE_COMPARE(recording->frameCount(), 0);
+}
+
+void DrawDataRecordingTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DrawDataRecording>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DrawDataRecording>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DrawDataRecording>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DrawDataRecording>::value);
+}
+
+void DrawDataRecordingTest::fromDataInvalid() {
+    auto&& data = FromDataInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Start with a valid file header, make it larger with zeros or cut it
+       and then corrupt a single byte */
+    DrawDataRecorder recorder;
+    const std::size_t headerSize = Math::min(data.size, recorder.data().size());
+    Containers::Array<char> bytes{ValueInit, data.size};
+    Utility::copy(recorder.data().prefix(headerSize), bytes.prefix(headerSize));
+    if(data.value)
+        bytes[data.offset] = data.value;
+
+    Containers::String out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!DrawDataRecording::fromData(Utility::move(bytes)));
+    CORRADE_COMPARE(out, Utility::format("ImGuiIntegration::DrawDataRecording::fromData(): {}\n", data.message));
+}
+
+void DrawDataRecordingTest::fromDataIndexOutOfRange() {
+    /* A frame with a single draw list of three vertices, three indices and
+       a command drawing them all with given vertex offset. Has to match the
+       layout in DrawDataRecording.cpp. */
+    const auto frame = [](UnsignedInt vertexOffset) {
+        DrawDataRecorder recorder;
+        Containers::Array<char> out;
+        arrayAppend(out, recorder.data());
+        const std::size_t frameOffset = out.size();
+        /* Size, texture count, draw list count, display position and size
+           and framebuffer scale */
+        append(out, UnsignedInt{});
+        append(out, UnsignedInt{0});
+        append(out, UnsignedInt{1});
+        append(out, Vector2{});
+        append(out, Vector2{100.0f});
+        append(out, Vector2{1.0f});
+        /* Vertex, index and command count */
+        append(out, UnsignedInt{3});
+        append(out, UnsignedInt{3});
+        append(out, UnsignedInt{1});
+        for(std::size_t i = 0; i != 3; ++i)
+            append(out, ImDrawVert{});
+        for(std::size_t i = 0; i != 3; ++i)
+            append(out, ImDrawIdx(i));
+        /* Clip rect, texture, vertex offset, index offset, element count,
+           reserved */
+        append(out, Vector4{0.0f, 0.0f, 100.0f, 100.0f});
+        append(out, UnsignedLong{});
+        append(out, vertexOffset);
+        append(out, UnsignedInt{0});
+        append(out, UnsignedInt{3});
+        append(out, UnsignedInt{});
+        const UnsignedInt frameSize = out.size() - frameOffset;
+        Utility::copy(Containers::arrayView(reinterpret_cast<const char*>(&frameSize), sizeof(frameSize)), out.sliceSize(frameOffset, sizeof(frameSize)));
+        return out;
+    };
+
+    /* All indices in range */
+    {
+        Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(frame(0));
+        CORRADE_VERIFY(recording);
+        CORRADE_COMPARE(recording->frameCount(), 1);
+    }
+
+    /* The last index plus the vertex offset is past the vertex count */
+    Containers::String out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!DrawDataRecording::fromData(frame(1)));
+    CORRADE_COMPARE(out, "ImGuiIntegration::DrawDataRecording::fromData(): frame 0 is corrupted\n");
+}
+
+void DrawDataRecordingTest::fromDataTextureTooLarge() {
+    /* A frame with a single single-channel texture of given size created
+       together with its pixel data. Has to match the layout in
+       DrawDataRecording.cpp. */
+    const auto frame = [](Int width) {
+        DrawDataRecorder recorder;
+        Containers::Array<char> out;
+        arrayAppend(out, recorder.data());
+        const std::size_t frameOffset = out.size();
+        /* Size, texture count, draw list count, display position and size
+           and framebuffer scale */
+        append(out, UnsignedInt{});
+        append(out, UnsignedInt{1});
+        append(out, UnsignedInt{0});
+        append(out, Vector2{});
+        append(out, Vector2{100.0f});
+        append(out, Vector2{1.0f});
+        /* ID, width, height, update count, create request, bytes per pixel,
+           reserved */
+        append(out, UnsignedLong{1});
+        append(out, width);
+        append(out, Int{1});
+        append(out, UnsignedShort{});
+        append(out, UnsignedByte{});
+        append(out, UnsignedByte{1});
+        append(out, UnsignedInt{});
+        arrayAppend(out, ValueInit, std::size_t(width));
+        const UnsignedInt frameSize = out.size() - frameOffset;
+        Utility::copy(Containers::arrayView(reinterpret_cast<const char*>(&frameSize), sizeof(frameSize)), out.sliceSize(frameOffset, sizeof(frameSize)));
+        return out;
+    };
+
+    /* The largest size that fits into ImTextureRect */
+    {
+        Containers::Optional<DrawDataRecording> recording = DrawDataRecording::fromData(frame(65535));
+        CORRADE_VERIFY(recording);
+        CORRADE_COMPARE(recording->frameCount(), 1);
+    }
+
+    /* Larger textures are rejected even if all their data are present */
+    Containers::String out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!DrawDataRecording::fromData(frame(65536)));
+    CORRADE_COMPARE(out, "ImGuiIntegration::DrawDataRecording::fromData(): frame 0 is corrupted\n");
+}
+
+void DrawDataRecordingTest::loadFailed() {
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!DrawDataRecording::load("nonexistent.bin"));
+    }
+    /* There's an error from Path::read() before */
+    CORRADE_COMPARE_AS(out,
+        "\nImGuiIntegration::DrawDataRecording::load(): can't read nonexistent.bin\n",
+        TestSuite::Compare::StringHasSuffix);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::DrawDataRecordingTest)
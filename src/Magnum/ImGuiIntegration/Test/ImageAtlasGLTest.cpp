@@ -0,0 +1,283 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/System.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Math/Color.h>
+
+#include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/ImageAtlas.h"
+#include "Magnum/ImGuiIntegration/Widgets.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct ImageAtlasGLTest: GL::OpenGLTester {
+    explicit ImageAtlasGLTest();
+
+    void add();
+    void addShelves();
+    void addPages();
+    void remove();
+    void removeShelf();
+    void removeClear();
+
+    void draw();
+};
+
+using namespace Math::Literals;
+
+ImageAtlasGLTest::ImageAtlasGLTest() {
+    addTests({&ImageAtlasGLTest::add,
+              &ImageAtlasGLTest::addShelves,
+              &ImageAtlasGLTest::addPages,
+              &ImageAtlasGLTest::remove,
+              &ImageAtlasGLTest::removeShelf,
+              &ImageAtlasGLTest::removeClear,
+
+              &ImageAtlasGLTest::draw});
+}
+
+/* Image of given size filled with a single color */
+Image2D filledImage(const Vector2i& size, const Color4ub& color) {
+    Image2D image{PixelFormat::RGBA8Unorm, size, Containers::Array<char>{NoInit, std::size_t(size.product()*4)}};
+    for(Containers::StridedArrayView1D<Color4ub> row: image.mutablePixels<Color4ub>())
+        for(Color4ub& pixel: row)
+            pixel = color;
+    return image;
+}
+
+void ImageAtlasGLTest::add() {
+    ImageAtlas atlas{{64, 64}};
+    CORRADE_COMPARE(atlas.pageSize(), (Vector2i{64, 64}));
+    CORRADE_COMPARE(atlas.padding(), 1);
+    CORRADE_COMPARE(atlas.pageCount(), 0);
+    CORRADE_COMPARE(atlas.imageCount(), 0);
+
+    UnsignedInt a = atlas.add(filledImage({8, 4}, 0xff3366ff_rgba));
+    UnsignedInt b = atlas.add(filledImage({8, 4}, 0x33ff66ff_rgba));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(atlas.pageCount(), 1);
+    CORRADE_COMPARE(atlas.imageCount(), 2);
+    CORRADE_VERIFY(atlas.contains(a));
+    CORRADE_VERIFY(atlas.contains(b));
+    CORRADE_VERIFY(!atlas.contains(2));
+
+    /* Placed next to each other, separated by the padding */
+    CORRADE_COMPARE(atlas.page(a), 0);
+    CORRADE_COMPARE(atlas.page(b), 0);
+    CORRADE_COMPARE(atlas.rectangle(a), Range2Di::fromSize({0, 0}, {8, 4}));
+    CORRADE_COMPARE(atlas.rectangle(b), Range2Di::fromSize({9, 0}, {8, 4}));
+    CORRADE_COMPARE(atlas.uvRange(b), (Range2D{{9.0f/64.0f, 0.0f}, {17.0f/64.0f, 4.0f/64.0f}}));
+    CORRADE_COMPARE(&atlas.texture(a), &atlas.pageTexture(0));
+    CORRADE_COMPARE(&atlas.texture(b), &atlas.pageTexture(0));
+
+    /* Verify the contents, the padding stays transparent */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D page = atlas.pageTexture(0).image(0, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(page.pixels<Color4ub>()[2][3], 0xff3366ff_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[2][8], 0x00000000_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[2][12], 0x33ff66ff_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[4][12], 0x00000000_rgba);
+    #endif
+}
+
+void ImageAtlasGLTest::addShelves() {
+    ImageAtlas atlas{{64, 64}};
+
+    UnsignedInt a = atlas.add(filledImage({8, 4}, 0xffffffff_rgba));
+    /* Too tall for the first shelf, opens a new one */
+    UnsignedInt b = atlas.add(filledImage({8, 16}, 0xffffffff_rgba));
+    /* Slightly shorter than the first shelf, goes there */
+    UnsignedInt c = atlas.add(filledImage({8, 3}, 0xffffffff_rgba));
+    /* Much shorter than both, opens a new shelf */
+    UnsignedInt d = atlas.add(filledImage({8, 1}, 0xffffffff_rgba));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(atlas.rectangle(a), Range2Di::fromSize({0, 0}, {8, 4}));
+    CORRADE_COMPARE(atlas.rectangle(b), Range2Di::fromSize({0, 5}, {8, 16}));
+    CORRADE_COMPARE(atlas.rectangle(c), Range2Di::fromSize({9, 0}, {8, 3}));
+    CORRADE_COMPARE(atlas.rectangle(d), Range2Di::fromSize({0, 22}, {8, 1}));
+    CORRADE_COMPARE(atlas.pageCount(), 1);
+}
+
+void ImageAtlasGLTest::addPages() {
+    ImageAtlas atlas{{32, 32}};
+
+    /* Neither fits next to or below the first */
+    UnsignedInt a = atlas.add(filledImage({20, 20}, 0xffffffff_rgba));
+    UnsignedInt b = atlas.add(filledImage({20, 20}, 0xffffffff_rgba));
+    /* Fits to the first page below the first */
+    UnsignedInt c = atlas.add(filledImage({32, 11}, 0xffffffff_rgba));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(atlas.pageCount(), 2);
+    CORRADE_COMPARE(atlas.page(a), 0);
+    CORRADE_COMPARE(atlas.page(b), 1);
+    CORRADE_COMPARE(atlas.page(c), 0);
+    CORRADE_COMPARE(atlas.rectangle(b), Range2Di::fromSize({0, 0}, {20, 20}));
+    CORRADE_COMPARE(atlas.rectangle(c), Range2Di::fromSize({0, 21}, {32, 11}));
+    CORRADE_VERIFY(atlas.pageTexture(0).id() != atlas.pageTexture(1).id());
+    CORRADE_COMPARE(&atlas.texture(b), &atlas.pageTexture(1));
+}
+
+void ImageAtlasGLTest::remove() {
+    ImageAtlas atlas{{64, 64}};
+
+    UnsignedInt a = atlas.add(filledImage({8, 4}, 0xffffffff_rgba));
+    UnsignedInt b = atlas.add(filledImage({8, 4}, 0xffffffff_rgba));
+    UnsignedInt c = atlas.add(filledImage({8, 4}, 0xffffffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(c), Range2Di::fromSize({18, 0}, {8, 4}));
+
+    /* Removing from the middle leaves a hole that gets reused, together with
+       the ID */
+    atlas.remove(b);
+    CORRADE_VERIFY(!atlas.contains(b));
+    CORRADE_COMPARE(atlas.imageCount(), 2);
+    UnsignedInt d = atlas.add(filledImage({6, 4}, 0xffffffff_rgba));
+    CORRADE_COMPARE(d, b);
+    CORRADE_COMPARE(atlas.rectangle(d), Range2Di::fromSize({9, 0}, {6, 4}));
+
+    /* Removing from the end gives the space back, including the remaining
+       space of the reused hole */
+    atlas.remove(c);
+    CORRADE_COMPARE(atlas.imageCount(), 2);
+    UnsignedInt e = atlas.add(filledImage({16, 4}, 0xffffffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(e), Range2Di::fromSize({16, 0}, {16, 4}));
+
+    atlas.remove(d);
+    atlas.remove(e);
+    UnsignedInt f = atlas.add(filledImage({20, 4}, 0xffffffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(f), Range2Di::fromSize({9, 0}, {20, 4}));
+    CORRADE_VERIFY(atlas.contains(a));
+    CORRADE_COMPARE(atlas.imageCount(), 2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ImageAtlasGLTest::removeShelf() {
+    ImageAtlas atlas{{64, 64}};
+
+    UnsignedInt a = atlas.add(filledImage({8, 4}, 0xffffffff_rgba));
+    UnsignedInt b = atlas.add(filledImage({8, 16}, 0xffffffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(b), Range2Di::fromSize({0, 5}, {8, 16}));
+
+    /* The last shelf gives the space back to the page when it becomes
+       empty */
+    atlas.remove(b);
+    UnsignedInt c = atlas.add(filledImage({8, 30}, 0xffffffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(c), Range2Di::fromSize({0, 5}, {8, 30}));
+
+    /* Other shelves stay, but can be used by images of any height that fits */
+    atlas.remove(a);
+    UnsignedInt d = atlas.add(filledImage({4, 2}, 0xffffffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(d), Range2Di::fromSize({0, 0}, {4, 2}));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ImageAtlasGLTest::removeClear() {
+    ImageAtlas atlas{{64, 64}};
+
+    UnsignedInt a = atlas.add(filledImage({8, 4}, 0xff3366ff_rgba));
+    atlas.add(filledImage({8, 4}, 0x33ff66ff_rgba));
+
+    /* A smaller image placed into the hole has the rest of the hole as its
+       padding */
+    atlas.remove(a);
+    UnsignedInt c = atlas.add(filledImage({6, 3}, 0x3366ffff_rgba));
+    CORRADE_COMPARE(atlas.rectangle(c), Range2Di::fromSize({0, 0}, {6, 3}));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The old contents are gone from both the padding on the right and
+       below */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D page = atlas.pageTexture(0).image(0, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(page.pixels<Color4ub>()[1][5], 0x3366ffff_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[1][6], 0x00000000_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[1][7], 0x00000000_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[3][2], 0x00000000_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[3][7], 0x00000000_rgba);
+    CORRADE_COMPARE(page.pixels<Color4ub>()[2][12], 0x33ff66ff_rgba);
+    #endif
+}
+
+void ImageAtlasGLTest::draw() {
+    GL::Renderbuffer color;
+    color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        {400, 400});
+    GL::Framebuffer framebuffer{{{}, {400, 400}}};
+    framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+        .bind();
+
+    ImageAtlas atlas{{256, 256}};
+    Containers::Array<UnsignedInt> ids;
+    for(std::size_t i = 0; i != 100; ++i)
+        arrayAppend(ids, atlas.add(filledImage({16, 16}, Color4ub{UnsignedByte(i*2), 128, 255, 255})));
+    CORRADE_COMPARE(atlas.pageCount(), 1);
+
+    Context context{{400, 400}};
+    for(std::size_t frame = 0; frame != 2; ++frame) {
+        Utility::System::sleep(1);
+        context.newFrame();
+        ImGui::SetNextWindowPos({0.0f, 0.0f});
+        ImGui::SetNextWindowSize({400.0f, 400.0f});
+        ImGui::Begin("Thumbnails");
+        for(UnsignedInt id: ids) {
+            ImGuiIntegration::image(atlas.texture(id),
+                Vector2{atlas.rectangle(id).size()}, atlas.uvRange(id));
+            ImGui::SameLine();
+        }
+        ImGui::End();
+        context.drawFrame();
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* All images are merged into a single ImGui draw command, the rest is the
+       window itself. With a texture for each image it'd be at least 100. */
+    CORRADE_COMPARE_AS(context.frameStatistics().drawCommandCount, 5,
+        TestSuite::Compare::LessOrEqual);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ImageAtlasGLTest)
@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+
+#include "Magnum/ImGuiIntegration/ImageAtlas.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct ImageAtlasTest: TestSuite::Tester {
+    explicit ImageAtlasTest();
+
+    void constructNoCreate();
+    void constructInvalid();
+    void constructCopy();
+
+    void addInvalid();
+    void accessInvalid();
+};
+
+ImageAtlasTest::ImageAtlasTest() {
+    addTests({&ImageAtlasTest::constructNoCreate,
+              &ImageAtlasTest::constructInvalid,
+              &ImageAtlasTest::constructCopy,
+
+              &ImageAtlasTest::addInvalid,
+              &ImageAtlasTest::accessInvalid});
+}
+
+void ImageAtlasTest::constructNoCreate() {
+    {
+        ImageAtlas atlas{NoCreate};
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void ImageAtlasTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Containers::String out;
+    Error redirectError{&out};
+    ImageAtlas{{0, 16}};
+    ImageAtlas{{16, 16}, -1};
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::ImageAtlas: expected a non-zero page size but got Vector(0, 16)\n"
+        "ImGuiIntegration::ImageAtlas: expected a non-negative padding but got -1\n");
+}
+
+void ImageAtlasTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ImageAtlas>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ImageAtlas>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ImageAtlas>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ImageAtlas>::value);
+}
+
+void ImageAtlasTest::addInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* No GL objects get created before the checks */
+    ImageAtlas atlas{{16, 16}};
+
+    const char data[17*17*4]{};
+    Containers::String out;
+    Error redirectError{&out};
+    atlas.add(ImageView2D{PixelFormat::RGB8Unorm, {4, 4}, data});
+    atlas.add(ImageView2D{PixelFormat::RGBA8Unorm, {17, 4}, data});
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::ImageAtlas::add(): expected an RGBA8 image but got PixelFormat::RGB8Unorm\n"
+        "ImGuiIntegration::ImageAtlas::add(): image of size Vector(17, 4) doesn't fit into a page of size Vector(16, 16)\n");
+}
+
+void ImageAtlasTest::accessInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ImageAtlas atlas;
+    CORRADE_VERIFY(!atlas.contains(0));
+
+    Containers::String out;
+    Error redirectError{&out};
+    atlas.remove(0);
+    atlas.pageTexture(0);
+    atlas.page(0);
+    atlas.texture(0);
+    atlas.rectangle(0);
+    atlas.uvRange(0);
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::ImageAtlas::remove(): image 0 not found\n"
+        "ImGuiIntegration::ImageAtlas::pageTexture(): index 0 out of range for 0 pages\n"
+        "ImGuiIntegration::ImageAtlas::page(): image 0 not found\n"
+        "ImGuiIntegration::ImageAtlas::texture(): image 0 not found\n"
+        "ImGuiIntegration::ImageAtlas::rectangle(): image 0 not found\n"
+        "ImGuiIntegration::ImageAtlas::uvRange(): image 0 not found\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ImageAtlasTest)
@@ -0,0 +1,395 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <type_traits>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/DebugTools/CompareImage.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Packing.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "Magnum/ImGuiIntegration/SoftwareRenderer.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct SoftwareRendererTest: TestSuite::Tester {
+    explicit SoftwareRendererTest();
+
+    void construct();
+    void constructCopy();
+    void setThreadCountTileSize();
+    void setThreadCountTileSizeInvalid();
+
+    void addRemoveTexture();
+    void addTextureInvalid();
+    void removeTextureNotFound();
+
+    void drawInvalidImage();
+    void draw();
+    void drawTexture();
+    void drawThreads();
+
+    private:
+        PluginManager::Manager<Trade::AbstractImporter> _manager;
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+    Vector2i tileSize;
+} DrawData[]{
+    {"", 1, Vector2i{64}},
+    {"4 threads", 4, Vector2i{16}},
+    {"3 threads, tiles not dividing the image", 3, {7, 13}},
+};
+
+SoftwareRendererTest::SoftwareRendererTest() {
+    addTests({&SoftwareRendererTest::construct,
+              &SoftwareRendererTest::constructCopy,
+              &SoftwareRendererTest::setThreadCountTileSize,
+              &SoftwareRendererTest::setThreadCountTileSizeInvalid,
+
+              &SoftwareRendererTest::addRemoveTexture,
+              &SoftwareRendererTest::addTextureInvalid,
+              &SoftwareRendererTest::removeTextureNotFound,
+
+              &SoftwareRendererTest::drawInvalidImage});
+
+    addInstancedTests({&SoftwareRendererTest::draw,
+                       &SoftwareRendererTest::drawTexture},
+        Containers::arraySize(DrawData));
+
+    addTests({&SoftwareRendererTest::drawThreads});
+}
+
+/* Same as in ContextGLTest */
+constexpr Color4 DrawClearColor{0.5f, 0.5f, 1.0f, 1.0f};
+constexpr Vector2i DrawSize{64, 64};
+
+/* An ImGui context set up the same as a Context{{200, 200}, {70, 70},
+   DrawSize} in ContextGLTest, as far as drawing primitives goes */
+struct ImGuiSetup {
+    explicit ImGuiSetup(SoftwareRenderer& renderer) {
+        context = ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(200.0f, 200.0f);
+        io.DisplayFramebufferScale = ImVec2(DrawSize.x()/200.0f, DrawSize.y()/200.0f);
+        io.DeltaTime = 1.0f/60.0f;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        #ifdef IMGUI_HAS_TEXTURES
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+        static_cast<void>(renderer);
+        #else
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        io.Fonts->SetTexID(renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {width, height}, {pixels, std::size_t(width*height*4)}}));
+        #endif
+    }
+
+    ~ImGuiSetup() {
+        ImGui::DestroyContext(context);
+    }
+
+    ImGuiContext* context;
+};
+
+void SoftwareRendererTest::construct() {
+    SoftwareRenderer renderer;
+    CORRADE_COMPARE(renderer.threadCount(), 1);
+    CORRADE_COMPARE(renderer.tileSize(), Vector2i{64});
+    CORRADE_COMPARE(renderer.textureCount(), 0);
+}
+
+void SoftwareRendererTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<SoftwareRenderer>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<SoftwareRenderer>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SoftwareRenderer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SoftwareRenderer>::value);
+}
+
+void SoftwareRendererTest::setThreadCountTileSize() {
+    SoftwareRenderer renderer;
+    renderer
+        .setThreadCount(3)
+        .setTileSize({16, 32});
+    CORRADE_COMPARE(renderer.threadCount(), 3);
+    CORRADE_COMPARE(renderer.tileSize(), (Vector2i{16, 32}));
+}
+
+void SoftwareRendererTest::setThreadCountTileSizeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SoftwareRenderer renderer;
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.setThreadCount(0);
+    renderer.setTileSize({16, 0});
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::SoftwareRenderer::setThreadCount(): expected a non-zero count\n"
+        "ImGuiIntegration::SoftwareRenderer::setTileSize(): expected a positive size, got {16, 0}\n");
+}
+
+void SoftwareRendererTest::addRemoveTexture() {
+    SoftwareRenderer renderer;
+
+    const Color4ub rgba[]{0xff3366cc_rgba, 0x00000000_rgba};
+    const Color3ub rgb[]{0x3366cc_rgb, 0x000000_rgb};
+
+    ImTextureID a = renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {1, 2}, rgba});
+    ImTextureID b = renderer.addTexture(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {2, 1}, rgb}, SamplerFilter::Nearest);
+    CORRADE_VERIFY(a != ImTextureID{});
+    CORRADE_VERIFY(b != ImTextureID{});
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(renderer.textureCount(), 2);
+
+    /* The ID of a removed texture gets reused */
+    renderer.removeTexture(a);
+    CORRADE_COMPARE(renderer.textureCount(), 1);
+    ImTextureID c = renderer.addTexture(ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, rgba});
+    CORRADE_VERIFY(c == a);
+    CORRADE_COMPARE(renderer.textureCount(), 2);
+
+    renderer.removeTexture(b);
+    renderer.removeTexture(c);
+    CORRADE_COMPARE(renderer.textureCount(), 0);
+}
+
+void SoftwareRendererTest::addTextureInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SoftwareRenderer renderer;
+
+    const char data[4]{};
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.addTexture(ImageView2D{PixelFormat::R8Unorm, {4, 1}, data});
+    renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {0, 1}, nullptr});
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::SoftwareRenderer::addTexture(): expected an RGBA8 or RGB8 image, got PixelFormat::R8Unorm\n"
+        "ImGuiIntegration::SoftwareRenderer::addTexture(): expected a non-empty image\n");
+}
+
+void SoftwareRendererTest::removeTextureNotFound() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SoftwareRenderer renderer;
+
+    const Color4ub data[1]{};
+    ImTextureID id = renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    renderer.removeTexture(id);
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.removeTexture(id);
+    #if IMGUI_VERSION_NUM >= 19131
+    CORRADE_COMPARE(out, "ImGuiIntegration::SoftwareRenderer::removeTexture(): texture 1 not found\n");
+    #else
+    CORRADE_COMPARE(out, "ImGuiIntegration::SoftwareRenderer::removeTexture(): texture 0x1 not found\n");
+    #endif
+}
+
+void SoftwareRendererTest::drawInvalidImage() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    SoftwareRenderer renderer;
+    ImDrawData drawData;
+
+    char data[4*4*3];
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.draw(drawData, MutableImageView2D{PixelFormat::RGB8Unorm, {4, 4}, data});
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::SoftwareRenderer::draw(): expected an RGBA8 image, got PixelFormat::RGB8Unorm\n");
+}
+
+void SoftwareRendererTest::draw() {
+    auto&& data = DrawData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SoftwareRenderer renderer;
+    renderer
+        .setThreadCount(data.threadCount)
+        .setTileSize(data.tileSize);
+    ImGuiSetup setup{renderer};
+
+    ImGui::NewFrame();
+
+    /* Same as ContextGLTest::draw() */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    drawList->AddRectFilled({size.x*0.1f, size.y*0.2f}, {size.x*0.9f, size.y*0.8f},
+        IM_COL32(255, 128, 128, 255));
+    drawList->AddRectFilled({size.x*0.5f, size.y*0.5f}, size,
+        IM_COL32(255, 255, 255, 128));
+    drawList->AddTriangleFilled({0.0f, 0.0f}, {size.x*0.5f, 0.0f}, {size.x*0.25f, size.y*0.5f},
+        IM_COL32(128, 255, 128, 255));
+
+    ImGui::Render();
+
+    Containers::Array<Color4ub> pixels{DirectInit, std::size_t(DrawSize.product()), Math::pack<Color4ub>(DrawClearColor)};
+    renderer.draw(*ImGui::GetDrawData(), MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, pixels});
+
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / PngImporter plugin can't be loaded.");
+
+    /* Pixel centers are sampled the same way as with OpenGL, but the GPU can
+       round coverage of a pixel exactly on an edge or the blending result
+       differently, so allow a few pixels to differ */
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, pixels}.pixels<Color4ub>()),
+        Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw.png"),
+        (DebugTools::CompareImageToFile{_manager, 96.0f, 0.5f}));
+}
+
+void SoftwareRendererTest::drawTexture() {
+    auto&& data = DrawData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / PngImporter plugin can't be loaded.");
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _manager.instantiate("PngImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/texture.png")));
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+
+    SoftwareRenderer renderer;
+    renderer
+        .setThreadCount(data.threadCount)
+        .setTileSize(data.tileSize);
+    ImGuiSetup setup{renderer};
+
+    ImTextureID texture1 = renderer.addTexture(*image, SamplerFilter::Nearest);
+
+    for(auto row: image->mutablePixels<Color3ub>())
+    for(Color3ub& p: row)
+        p = Color3ub{255} - p;
+
+    ImTextureID texture2 = renderer.addTexture(*image, SamplerFilter::Nearest);
+
+    ImGui::NewFrame();
+
+    /* Same as ContextGLTest::drawTexture() */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    drawList->AddImage(texture1, {0.0f, 0.0f}, {size.x, size.y*0.5f});
+    drawList->AddImage(texture2, {0.0f, size.y*0.5f}, size,
+        {0.25f, 0.25f}, {1.0f, 0.75f});
+
+    ImGui::Render();
+
+    Containers::Array<Color4ub> pixels{DirectInit, std::size_t(DrawSize.product()), Math::pack<Color4ub>(DrawClearColor)};
+    renderer.draw(*ImGui::GetDrawData(), MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, pixels});
+
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, pixels}.pixels<Color4ub>()),
+        Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw-texture.png"),
+        (DebugTools::CompareImageToFile{_manager, 96.0f, 0.5f}));
+}
+
+void SoftwareRendererTest::drawThreads() {
+    SoftwareRenderer renderer;
+    ImGuiSetup setup{renderer};
+
+    /* A window with text, overlapping tile boundaries in all sorts of ways.
+       ImGui doesn't draw windows in the first frame. */
+    for(std::size_t i = 0; i != 2; ++i) {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos({10.0f, 10.0f});
+        ImGui::Begin("Hello");
+        ImGui::Text("Hello from a software renderer");
+        ImGui::Button("Button");
+        ImGui::End();
+        ImGui::Render();
+    }
+
+    Containers::Array<Color4ub> single{DirectInit, std::size_t(DrawSize.product()), Math::pack<Color4ub>(DrawClearColor)};
+    renderer.draw(*ImGui::GetDrawData(), MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, single});
+
+    #ifdef IMGUI_HAS_TEXTURES
+    /* The font atlas got created */
+    CORRADE_COMPARE(renderer.textureCount(), 1);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->TexData->Status, ImTextureStatus_OK);
+    #endif
+
+    /* Something got drawn */
+    std::size_t changed = 0;
+    for(const Color4ub& pixel: single)
+        if(pixel != Math::pack<Color4ub>(DrawClearColor)) ++changed;
+    CORRADE_VERIFY(changed);
+
+    /* The same draw data drawn with multiple threads gives the exact same
+       output */
+    renderer
+        .setThreadCount(4)
+        .setTileSize({5, 11});
+    Containers::Array<Color4ub> multiple{DirectInit, std::size_t(DrawSize.product()), Math::pack<Color4ub>(DrawClearColor)};
+    renderer.draw(*ImGui::GetDrawData(), MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, multiple});
+    CORRADE_COMPARE_AS(multiple, single,
+        TestSuite::Compare::Container);
+
+    /* Drawing again reuses the worker threads from the previous draw */
+    Containers::Array<Color4ub> again{DirectInit, std::size_t(DrawSize.product()), Math::pack<Color4ub>(DrawClearColor)};
+    renderer.draw(*ImGui::GetDrawData(), MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, again});
+    CORRADE_COMPARE_AS(again, single,
+        TestSuite::Compare::Container);
+
+    /* Changing the thread count recreates them */
+    renderer.setThreadCount(2);
+    Containers::Array<Color4ub> fewer{DirectInit, std::size_t(DrawSize.product()), Math::pack<Color4ub>(DrawClearColor)};
+    renderer.draw(*ImGui::GetDrawData(), MutableImageView2D{PixelFormat::RGBA8Unorm, DrawSize, fewer});
+    CORRADE_COMPARE_AS(fewer, single,
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::SoftwareRendererTest)
@@ -0,0 +1,435 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <type_traits>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Move.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/DebugTools/CompareImage.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Packing.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+#include <Magnum/Vk/BufferCreateInfo.h>
+#include <Magnum/Vk/CommandBuffer.h>
+#include <Magnum/Vk/CommandPoolCreateInfo.h>
+#include <Magnum/Vk/DeviceProperties.h>
+#include <Magnum/Vk/Fence.h>
+#include <Magnum/Vk/FramebufferCreateInfo.h>
+#include <Magnum/Vk/ImageCreateInfo.h>
+#include <Magnum/Vk/ImageViewCreateInfo.h>
+#include <Magnum/Vk/Memory.h>
+#include <Magnum/Vk/Pipeline.h>
+#include <Magnum/Vk/Queue.h>
+#include <Magnum/Vk/RenderPassCreateInfo.h>
+#include <Magnum/Vk/VulkanTester.h>
+
+#include "Magnum/ImGuiIntegration/VulkanRenderer.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct VulkanRendererVkTest: Vk::VulkanTester {
+    explicit VulkanRendererVkTest();
+
+    void construct();
+    void constructZeroFramesInFlight();
+    void constructCopy();
+    void constructMove();
+
+    void addRemoveTexture();
+    void addTextureInvalid();
+    void removeTextureNotFound();
+
+    void drawWithoutUpload();
+    void draw();
+    void drawTexture();
+    void drawFramesInFlight();
+
+    private:
+        /* Renders the draw data to _color and reads it back to _pixelData */
+        ImageView2D render(VulkanRenderer& renderer, ImDrawData& drawData);
+
+        PluginManager::Manager<Trade::AbstractImporter> _manager;
+        Vk::CommandPool _pool{NoCreate};
+        Vk::RenderPass _renderPass{NoCreate};
+        Vk::Image _color{NoCreate};
+        Vk::ImageView _colorView{NoCreate};
+        Vk::Framebuffer _framebuffer{NoCreate};
+        Vk::Buffer _pixels{NoCreate};
+        Containers::Array<char> _pixelData;
+};
+
+/* Same as in ContextGLTest */
+constexpr Color4 DrawClearColor{0.5f, 0.5f, 1.0f, 1.0f};
+constexpr Vector2i DrawSize{64, 64};
+
+VulkanRendererVkTest::VulkanRendererVkTest() {
+    addTests({&VulkanRendererVkTest::construct,
+              &VulkanRendererVkTest::constructZeroFramesInFlight,
+              &VulkanRendererVkTest::constructCopy,
+              &VulkanRendererVkTest::constructMove,
+
+              &VulkanRendererVkTest::addRemoveTexture,
+              &VulkanRendererVkTest::addTextureInvalid,
+              &VulkanRendererVkTest::removeTextureNotFound,
+
+              &VulkanRendererVkTest::drawWithoutUpload,
+              &VulkanRendererVkTest::draw,
+              &VulkanRendererVkTest::drawTexture,
+              &VulkanRendererVkTest::drawFramesInFlight});
+
+    _pool = Vk::CommandPool{device(), Vk::CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(Vk::QueueFlag::Graphics)}};
+
+    /* The color attachment ends up in a layout for copying to a buffer, with
+       the copy waiting for the render pass to finish */
+    _renderPass = Vk::RenderPass{device(), Vk::RenderPassCreateInfo{}
+        .setAttachments({
+            Vk::AttachmentDescription{Vk::PixelFormat::RGBA8Unorm,
+                Vk::AttachmentLoadOperation::Clear,
+                Vk::AttachmentStoreOperation::Store,
+                Vk::ImageLayout::Undefined,
+                Vk::ImageLayout::TransferSource}
+        })
+        .addSubpass(Vk::SubpassDescription{}.setColorAttachments({
+            Vk::AttachmentReference{0, Vk::ImageLayout::ColorAttachment}
+        }))
+        .setDependencies({Vk::SubpassDependency{
+            0, Vk::SubpassDependency::External,
+            Vk::PipelineStage::ColorAttachmentOutput,
+            Vk::PipelineStage::Transfer,
+            Vk::Access::ColorAttachmentWrite,
+            Vk::Access::TransferRead}})
+    };
+
+    _color = Vk::Image{device(), Vk::ImageCreateInfo2D{
+        Vk::ImageUsage::ColorAttachment|Vk::ImageUsage::TransferSource,
+        Vk::PixelFormat::RGBA8Unorm, DrawSize, 1}, Vk::MemoryFlag::DeviceLocal};
+    _colorView = Vk::ImageView{device(), Vk::ImageViewCreateInfo2D{_color}};
+    _framebuffer = Vk::Framebuffer{device(), Vk::FramebufferCreateInfo{_renderPass, {_colorView}, DrawSize}};
+    _pixels = Vk::Buffer{device(), Vk::BufferCreateInfo{
+        Vk::BufferUsage::TransferDestination, std::size_t(DrawSize.product()*4)
+    }, Vk::MemoryFlag::HostVisible};
+}
+
+ImageView2D VulkanRendererVkTest::render(VulkanRenderer& renderer, ImDrawData& drawData) {
+    Vk::CommandBuffer cmd = _pool.allocate();
+    cmd.begin();
+    renderer.upload(cmd, drawData);
+    cmd.beginRenderPass(Vk::RenderPassBeginInfo{_renderPass, _framebuffer}
+        .clearColor(0, DrawClearColor));
+    renderer.draw(cmd, drawData);
+    cmd.endRenderPass()
+       .copyImageToBuffer({_color, Vk::ImageLayout::TransferSource, _pixels, {
+            Vk::BufferImageCopy2D{0, Vk::ImageAspect::Color, 0, {{}, DrawSize}}
+        }})
+       .pipelineBarrier(Vk::PipelineStage::Transfer, Vk::PipelineStage::Host, {
+            {Vk::Access::TransferWrite, Vk::Access::HostRead, _pixels}
+        })
+       .end();
+    queue().submit({Vk::SubmitInfo{}.setCommandBuffers({cmd})}).wait();
+
+    /* Copy the data out so the memory can be mapped again in the next
+       call */
+    const Containers::Array<const char, Vk::MemoryMapDeleter> data = _pixels.dedicatedMemory().mapRead();
+    _pixelData = Containers::Array<char>{NoInit, std::size_t(DrawSize.product()*4)};
+    std::memcpy(_pixelData.data(), data.data(), _pixelData.size());
+    return ImageView2D{PixelFormat::RGBA8Unorm, DrawSize, _pixelData};
+}
+
+/* An ImGui context set up the same as a Context{{200, 200}, {70, 70},
+   DrawSize} in ContextGLTest, as far as drawing primitives goes */
+struct ImGuiSetup {
+    explicit ImGuiSetup(VulkanRenderer& renderer) {
+        context = ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(200.0f, 200.0f);
+        io.DisplayFramebufferScale = ImVec2(DrawSize.x()/200.0f, DrawSize.y()/200.0f);
+        io.DeltaTime = 1.0f/60.0f;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        #ifdef IMGUI_HAS_TEXTURES
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+        static_cast<void>(renderer);
+        #else
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        io.Fonts->SetTexID(renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {width, height}, {pixels, std::size_t(width*height*4)}}));
+        #endif
+    }
+
+    ~ImGuiSetup() {
+        ImGui::DestroyContext(context);
+    }
+
+    ImGuiContext* context;
+};
+
+void VulkanRendererVkTest::construct() {
+    VulkanRenderer renderer{device(), _renderPass, 0, 3};
+    CORRADE_COMPARE(renderer.framesInFlight(), 3);
+    CORRADE_COMPARE(renderer.textureCount(), 0);
+}
+
+void VulkanRendererVkTest::constructZeroFramesInFlight() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Containers::String out;
+    Error redirectError{&out};
+    VulkanRenderer{device(), _renderPass, 0, 0};
+    CORRADE_COMPARE(out, "ImGuiIntegration::VulkanRenderer: expected a non-zero count of frames in flight\n");
+}
+
+void VulkanRendererVkTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<VulkanRenderer>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<VulkanRenderer>{});
+}
+
+void VulkanRendererVkTest::constructMove() {
+    VulkanRenderer a{device(), _renderPass};
+
+    VulkanRenderer b = Utility::move(a);
+    CORRADE_COMPARE(b.framesInFlight(), 2);
+
+    VulkanRenderer c{NoCreate};
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.framesInFlight(), 2);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<VulkanRenderer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<VulkanRenderer>::value);
+}
+
+void VulkanRendererVkTest::addRemoveTexture() {
+    VulkanRenderer renderer{device(), _renderPass};
+
+    const Color4ub rgba[]{0xff3366cc_rgba, 0x00000000_rgba};
+    const Color3ub rgb[]{0x3366cc_rgb, 0x000000_rgb};
+
+    Vk::Image image{device(), Vk::ImageCreateInfo2D{
+        Vk::ImageUsage::Sampled, Vk::PixelFormat::RGBA8Unorm, {4, 4}, 1},
+        Vk::MemoryFlag::DeviceLocal};
+    Vk::ImageView view{device(), Vk::ImageViewCreateInfo2D{image}};
+
+    ImTextureID a = renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {1, 2}, rgba});
+    ImTextureID b = renderer.addTexture(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {2, 1}, rgb}, SamplerFilter::Nearest);
+    ImTextureID c = renderer.addTexture(view);
+    CORRADE_VERIFY(a != ImTextureID{});
+    CORRADE_VERIFY(b != ImTextureID{});
+    CORRADE_VERIFY(c != ImTextureID{});
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(b != c);
+    CORRADE_COMPARE(renderer.textureCount(), 3);
+
+    /* Removing a texture before its data got uploaded is fine */
+    renderer.removeTexture(a);
+    CORRADE_COMPARE(renderer.textureCount(), 2);
+
+    /* The descriptor set of a removed texture isn't reused until the GPU
+       is done with it */
+    ImTextureID d = renderer.addTexture(ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, rgba});
+    CORRADE_VERIFY(d != a);
+    CORRADE_COMPARE(renderer.textureCount(), 3);
+
+    renderer.removeTexture(b);
+    renderer.removeTexture(c);
+    renderer.removeTexture(d);
+    CORRADE_COMPARE(renderer.textureCount(), 0);
+}
+
+void VulkanRendererVkTest::addTextureInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    VulkanRenderer renderer{device(), _renderPass};
+
+    const char data[4]{};
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.addTexture(ImageView2D{PixelFormat::R8Unorm, {4, 1}, data});
+    renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {0, 1}, nullptr});
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::VulkanRenderer::addTexture(): expected an RGBA8 or RGB8 image, got PixelFormat::R8Unorm\n"
+        "ImGuiIntegration::VulkanRenderer::addTexture(): expected a non-empty image\n");
+}
+
+void VulkanRendererVkTest::removeTextureNotFound() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    VulkanRenderer renderer{device(), _renderPass};
+
+    const Color4ub data[1]{};
+    ImTextureID id = renderer.addTexture(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    renderer.removeTexture(id);
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.removeTexture(id);
+    #if IMGUI_VERSION_NUM >= 19131
+    CORRADE_COMPARE(out, "ImGuiIntegration::VulkanRenderer::removeTexture(): texture 1 not found\n");
+    #else
+    CORRADE_COMPARE(out, "ImGuiIntegration::VulkanRenderer::removeTexture(): texture 0x1 not found\n");
+    #endif
+}
+
+void VulkanRendererVkTest::drawWithoutUpload() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    VulkanRenderer renderer{device(), _renderPass};
+    ImDrawData drawData;
+
+    Vk::CommandBuffer cmd = _pool.allocate();
+
+    Containers::String out;
+    Error redirectError{&out};
+    renderer.draw(cmd, drawData);
+    CORRADE_COMPARE(out, "ImGuiIntegration::VulkanRenderer::draw(): upload() wasn't called with the same draw data\n");
+}
+
+void VulkanRendererVkTest::draw() {
+    VulkanRenderer renderer{device(), _renderPass};
+    ImGuiSetup setup{renderer};
+
+    ImGui::NewFrame();
+
+    /* Same as ContextGLTest::draw() */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    drawList->AddRectFilled({size.x*0.1f, size.y*0.2f}, {size.x*0.9f, size.y*0.8f},
+        IM_COL32(255, 128, 128, 255));
+    drawList->AddRectFilled({size.x*0.5f, size.y*0.5f}, size,
+        IM_COL32(255, 255, 255, 128));
+    drawList->AddTriangleFilled({0.0f, 0.0f}, {size.x*0.5f, 0.0f}, {size.x*0.25f, size.y*0.5f},
+        IM_COL32(128, 255, 128, 255));
+
+    ImGui::Render();
+
+    ImageView2D image = render(renderer, *ImGui::GetDrawData());
+
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / PngImporter plugin can't be loaded.");
+
+    /* Vulkan has the origin at the top left, the ground-truth images are
+       bottom-up */
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<const Color3ub>(image.pixels<Color4ub>().flipped<0>()),
+        Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw.png"),
+        (DebugTools::CompareImageToFile{_manager, 1.0f, 0.5f}));
+}
+
+void VulkanRendererVkTest::drawTexture() {
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / PngImporter plugin can't be loaded.");
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _manager.instantiate("PngImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/texture.png")));
+    Containers::Optional<Trade::ImageData2D> textureImage = importer->image2D(0);
+    CORRADE_VERIFY(textureImage);
+    CORRADE_COMPARE(textureImage->format(), PixelFormat::RGB8Unorm);
+
+    VulkanRenderer renderer{device(), _renderPass};
+    ImGuiSetup setup{renderer};
+
+    ImTextureID texture1 = renderer.addTexture(*textureImage, SamplerFilter::Nearest);
+
+    for(auto row: textureImage->mutablePixels<Color3ub>())
+    for(Color3ub& p: row)
+        p = Color3ub{255} - p;
+
+    ImTextureID texture2 = renderer.addTexture(*textureImage, SamplerFilter::Nearest);
+
+    ImGui::NewFrame();
+
+    /* Same as ContextGLTest::drawTexture() */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    drawList->AddImage(texture1, {0.0f, 0.0f}, {size.x, size.y*0.5f});
+    drawList->AddImage(texture2, {0.0f, size.y*0.5f}, size,
+        {0.25f, 0.25f}, {1.0f, 0.75f});
+
+    ImGui::Render();
+
+    ImageView2D image = render(renderer, *ImGui::GetDrawData());
+
+    CORRADE_COMPARE_WITH(
+        Containers::arrayCast<const Color3ub>(image.pixels<Color4ub>().flipped<0>()),
+        Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw-texture.png"),
+        (DebugTools::CompareImageToFile{_manager, 1.0f, 0.5f}));
+}
+
+void VulkanRendererVkTest::drawFramesInFlight() {
+    VulkanRenderer renderer{device(), _renderPass};
+    ImGuiSetup setup{renderer};
+
+    /* Draw more frames than there are frames in flight, so the per-frame
+       buffers get reused. ImGui doesn't draw windows in the first frame. */
+    Containers::Array<Color4ub> pixels{NoInit, std::size_t(DrawSize.product())};
+    for(std::size_t i = 0; i != 4; ++i) {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos({10.0f, 10.0f});
+        ImGui::Begin("Hello");
+        ImGui::Text("Hello from Vulkan, frame %zu", i);
+        ImGui::Button("Button");
+        ImGui::End();
+        ImGui::Render();
+
+        ImageView2D image = render(renderer, *ImGui::GetDrawData());
+            Utility::copy(image.pixels<Color4ub>(), Containers::StridedArrayView2D<Color4ub>{pixels, {std::size_t(DrawSize.y()), std::size_t(DrawSize.x())}});
+    }
+
+    #ifdef IMGUI_HAS_TEXTURES
+    /* The font atlas got created */
+    CORRADE_COMPARE(renderer.textureCount(), 1);
+    CORRADE_COMPARE(ImGui::GetIO().Fonts->TexData->Status, ImTextureStatus_OK);
+    #endif
+
+    /* Something got drawn */
+    const Color4ub clearColor = Math::pack<Color4ub>(DrawClearColor);
+    std::size_t changed = 0;
+    for(const Color4ub& pixel: pixels)
+        if(pixel != clearColor) ++changed;
+    CORRADE_VERIFY(changed);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::VulkanRendererVkTest)
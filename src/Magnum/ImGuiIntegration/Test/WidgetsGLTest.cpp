@@ -26,6 +26,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/System.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/GL/Framebuffer.h>
@@ -33,6 +37,7 @@
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
 #include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Functions.h>
 
 #include "Magnum/ImGuiIntegration/Context.hpp"
 #include "Magnum/ImGuiIntegration/Widgets.h"
@@ -52,6 +57,9 @@ struct WidgetsGLTest: GL::OpenGLTester {
 
     void image();
     void imageButton();
+    void list();
+    void table();
+    void plot();
 
     private:
         GL::Renderbuffer _color{NoCreate};
@@ -60,7 +68,10 @@ struct WidgetsGLTest: GL::OpenGLTester {
 
 WidgetsGLTest::WidgetsGLTest() {
     addTests({&WidgetsGLTest::image,
-              &WidgetsGLTest::imageButton},
+              &WidgetsGLTest::imageButton,
+              &WidgetsGLTest::list,
+              &WidgetsGLTest::table,
+              &WidgetsGLTest::plot},
         &WidgetsGLTest::drawSetup,
         &WidgetsGLTest::drawTeardown);
 
@@ -167,6 +178,114 @@ void WidgetsGLTest::imageButton() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+void WidgetsGLTest::list() {
+    /* Checks compilation and no GL errors only */
+    Context c{{200, 200}};
+
+    /* Again a dummy frame first as ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    Containers::Array<Containers::String> strings{10000};
+    Containers::Array<Containers::StringView> items{strings.size()};
+    for(std::size_t i = 0; i != strings.size(); ++i) {
+        strings[i] = Utility::format("Item {}", i);
+        items[i] = strings[i];
+    }
+
+    TableIndex index;
+    index.setFilter("7")
+        .setSort(0);
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    Int selected = 3;
+    CORRADE_VERIFY(!ImGuiIntegration::list("list", items, selected));
+    CORRADE_VERIFY(!ImGuiIntegration::list("filtered", items, selected, &index, {100, 100}));
+    CORRADE_COMPARE(selected, 3);
+    CORRADE_COMPARE(index.rows().size(), 3439);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void WidgetsGLTest::table() {
+    /* Checks compilation and no GL errors only */
+    Context c{{200, 200}};
+
+    /* Again a dummy frame first as ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    Containers::StringView names[]{"a", "b", "c"};
+    Int ints[]{1, -2, 3};
+    UnsignedInt unsignedInts[]{4, 5, 6};
+    Float floats[]{1.5f, 2.5f, 3.5f};
+    Double doubles[]{0.25, 0.5, 0.75};
+    Color4 colors[]{Color4::red(), Color4::green(), Color4::blue()};
+    const TableColumn columns[]{
+        TableColumn{"Name", Containers::stridedArrayView(names)},
+        TableColumn{"Int", Containers::stridedArrayView(ints)},
+        TableColumn{"UnsignedInt", Containers::stridedArrayView(unsignedInts), "0x%x"},
+        TableColumn{"Float", Containers::stridedArrayView(floats)},
+        TableColumn{"Double", Containers::stridedArrayView(doubles), "%.3f"},
+        TableColumn{"Color", Containers::stridedArrayView(colors)}
+    };
+
+    TableIndex index;
+    index.setFilter("b");
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    ImGuiIntegration::table("table", columns);
+    ImGuiIntegration::table("filtered", columns, &index, {180, 80});
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        1
+    }), TestSuite::Compare::Container);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void WidgetsGLTest::plot() {
+    /* Checks compilation and no GL errors only */
+    Context c{{200, 200}};
+
+    /* Again a dummy frame first as ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    /* Enough values to go through the min/max path */
+    Containers::Array<Float> x{NoInit, 10000};
+    Containers::Array<Float> values{NoInit, 10000};
+    for(std::size_t i = 0; i != values.size(); ++i) {
+        x[i] = Float(i)*Float(i);
+        values[i] = Math::sin(Rad(Float(i)*0.01f));
+    }
+
+    PlotCache cache;
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    ImGuiIntegration::plot("direct", Containers::stridedArrayView(values).prefix(10));
+    ImGuiIntegration::plot("uncached", Containers::stridedArrayView(values));
+    ImGuiIntegration::plot("cached", Containers::stridedArrayView(values), &cache, {-2.0f, 2.0f}, {150, 40});
+    ImGuiIntegration::plot("x", Containers::stridedArrayView(x), Containers::stridedArrayView(values));
+    CORRADE_COMPARE(cache.sampleCount(), 10000);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::WidgetsGLTest)
@@ -0,0 +1,460 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include <Magnum/Math/Functions.h>
+
+#include "Magnum/ImGuiIntegration/Widgets.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct WidgetsTest: TestSuite::Tester {
+    explicit WidgetsTest();
+
+    void tableColumn();
+
+    void tableIndex();
+    void tableIndexFilter();
+    void tableIndexSort();
+    void tableIndexSortDescending();
+    void tableIndexAppend();
+    void tableIndexShrink();
+    void tableIndexInvalidate();
+    void tableIndexInvalid();
+
+    void plotCache();
+    void plotCacheAppend();
+    void plotCacheShrink();
+    void plotCacheInvalidate();
+    void plotCacheInvalid();
+
+    void plotInvalid();
+};
+
+WidgetsTest::WidgetsTest() {
+    addTests({&WidgetsTest::tableColumn,
+
+              &WidgetsTest::tableIndex,
+              &WidgetsTest::tableIndexFilter,
+              &WidgetsTest::tableIndexSort,
+              &WidgetsTest::tableIndexSortDescending,
+              &WidgetsTest::tableIndexAppend,
+              &WidgetsTest::tableIndexShrink,
+              &WidgetsTest::tableIndexInvalidate,
+              &WidgetsTest::tableIndexInvalid,
+
+              &WidgetsTest::plotCache,
+              &WidgetsTest::plotCacheAppend,
+              &WidgetsTest::plotCacheShrink,
+              &WidgetsTest::plotCacheInvalidate,
+              &WidgetsTest::plotCacheInvalid,
+
+              &WidgetsTest::plotInvalid});
+}
+
+using namespace Containers::Literals;
+
+Range1D bruteForceRange(Containers::ArrayView<const Float> samples, std::size_t begin, std::size_t end) {
+    Range1D out{samples[begin], samples[begin]};
+    for(std::size_t i = begin; i != end; ++i)
+        out = {Math::min(out.min(), samples[i]), Math::max(out.max(), samples[i])};
+    return out;
+}
+
+void WidgetsTest::tableColumn() {
+    const Float data[]{1.0f, 2.0f, 3.0f};
+    TableColumn column{"Value", Containers::stridedArrayView(data), "%.2f"};
+    CORRADE_COMPARE(Containers::StringView{column.name()}, "Value"_s);
+    CORRADE_COMPARE(column.type(), TableColumn::Type::Float);
+    CORRADE_COMPARE(Containers::StringView{column.format()}, "%.2f"_s);
+    CORRADE_COMPARE(column.size(), 3);
+    CORRADE_COMPARE(column.data().data(), static_cast<const void*>(data));
+
+    const Containers::StringView strings[]{"a"_s, "b"_s};
+    TableColumn stringColumn{"Name", Containers::stridedArrayView(strings)};
+    CORRADE_COMPARE(stringColumn.type(), TableColumn::Type::String);
+    CORRADE_VERIFY(!stringColumn.format());
+    CORRADE_COMPARE(stringColumn.size(), 2);
+}
+
+void WidgetsTest::tableIndex() {
+    const Containers::StringView names[]{"c"_s, "a"_s, "b"_s};
+    const TableColumn columns[]{
+        TableColumn{"Name", Containers::stridedArrayView(names)}
+    };
+
+    TableIndex index;
+    CORRADE_COMPARE(index.filter(), ""_s);
+    CORRADE_COMPARE(index.sortColumn(), -1);
+    CORRADE_VERIFY(index.isSortAscending());
+    CORRADE_VERIFY(index.rows().isEmpty());
+
+    /* Without a filter or sort the rows are in the original order */
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void WidgetsTest::tableIndexFilter() {
+    const Containers::StringView names[]{"apple"_s, "banana"_s, "cherry"_s, "pineapple"_s};
+    const Containers::StringView tags[]{"red"_s, "yellow"_s, "red"_s, "yellow"_s};
+    const Int counts[]{1, 2, 3, 4};
+    const TableColumn columns[]{
+        TableColumn{"Name", Containers::stridedArrayView(names)},
+        TableColumn{"Tag", Containers::stridedArrayView(tags)},
+        TableColumn{"Count", Containers::stridedArrayView(counts)}
+    };
+
+    TableIndex index;
+    index.setFilter("apple");
+    CORRADE_COMPARE(index.filter(), "apple"_s);
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        0, 3
+    }), TestSuite::Compare::Container);
+
+    /* Any string column can match, numeric columns are not considered */
+    index.setFilter("ell");
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        1, 3
+    }), TestSuite::Compare::Container);
+
+    index.setFilter("3");
+    index.update(columns);
+    CORRADE_VERIFY(index.rows().isEmpty());
+
+    /* Empty filter keeps everything */
+    index.setFilter("");
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void WidgetsTest::tableIndexSort() {
+    const Containers::StringView names[]{"d"_s, "b"_s, "a"_s, "c"_s, "e"_s};
+    const Float values[]{2.0f, 1.0f, 2.0f, 0.5f, 1.0f};
+    const TableColumn columns[]{
+        TableColumn{"Name", Containers::stridedArrayView(names)},
+        TableColumn{"Value", Containers::stridedArrayView(values)}
+    };
+
+    TableIndex index;
+    index.setSort(0);
+    CORRADE_COMPARE(index.sortColumn(), 0);
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        2, 1, 3, 0, 4
+    }), TestSuite::Compare::Container);
+
+    /* Equal values stay in the original order */
+    index.setSort(1);
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        3, 1, 4, 0, 2
+    }), TestSuite::Compare::Container);
+
+    /* Filter and sort combined */
+    index.setFilter("a");
+    index.setSort(-1);
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        2
+    }), TestSuite::Compare::Container);
+}
+
+void WidgetsTest::tableIndexSortDescending() {
+    const UnsignedInt values[]{3, 1, 4, 1, 5};
+    const TableColumn columns[]{
+        TableColumn{"Value", Containers::stridedArrayView(values)}
+    };
+
+    TableIndex index;
+    index.setSort(0, false);
+    CORRADE_VERIFY(!index.isSortAscending());
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        4, 2, 0, 1, 3
+    }), TestSuite::Compare::Container);
+}
+
+void WidgetsTest::tableIndexAppend() {
+    /* A growing log, with only the new rows being processed */
+    Containers::Array<Containers::StringView> messages;
+    Containers::Array<Int> levels;
+    arrayAppend(messages, {"warning: b"_s, "info: c"_s, "warning: a"_s});
+    arrayAppend(levels, {1, 0, 1});
+
+    TableIndex index;
+    index.setFilter("warning")
+        .setSort(0);
+    {
+        const TableColumn columns[]{
+            TableColumn{"Message", Containers::stridedArrayView(messages)},
+            TableColumn{"Level", Containers::stridedArrayView(levels)}
+        };
+        index.update(columns);
+        CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+            2, 0
+        }), TestSuite::Compare::Container);
+
+        /* Updating with the same data doesn't change anything */
+        index.update(columns);
+        CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+            2, 0
+        }), TestSuite::Compare::Container);
+    }
+
+    arrayAppend(messages, {"warning: 0"_s, "info: d"_s, "warning: c"_s, "warning: a"_s});
+    arrayAppend(levels, {1, 0, 1, 1});
+    {
+        const TableColumn columns[]{
+            TableColumn{"Message", Containers::stridedArrayView(messages)},
+            TableColumn{"Level", Containers::stridedArrayView(levels)}
+        };
+        index.update(columns);
+        /* The new rows are merged in, equal values keep the original order */
+        CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+            3, 2, 6, 0, 5
+        }), TestSuite::Compare::Container);
+    }
+}
+
+void WidgetsTest::tableIndexShrink() {
+    const Int values[]{5, 3, 4, 1};
+    const TableColumn columns[]{
+        TableColumn{"Value", Containers::stridedArrayView(values)}
+    };
+    const TableColumn fewerColumns[]{
+        TableColumn{"Value", Containers::stridedArrayView(values).prefix(2)}
+    };
+
+    TableIndex index;
+    index.setSort(0);
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        3, 1, 2, 0
+    }), TestSuite::Compare::Container);
+
+    /* Fewer rows make the index rebuild */
+    index.update(fewerColumns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        1, 0
+    }), TestSuite::Compare::Container);
+}
+
+void WidgetsTest::tableIndexInvalidate() {
+    Int values[]{3, 1, 2};
+    const TableColumn columns[]{
+        TableColumn{"Value", Containers::stridedArrayView(values)}
+    };
+
+    TableIndex index;
+    index.setSort(0);
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        1, 2, 0
+    }), TestSuite::Compare::Container);
+
+    /* Modifying the data isn't detected */
+    values[0] = 0;
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        1, 2, 0
+    }), TestSuite::Compare::Container);
+
+    /* Until the index is invalidated */
+    index.invalidate();
+    index.update(columns);
+    CORRADE_COMPARE_AS(index.rows(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void WidgetsTest::tableIndexInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Int a[3]{};
+    const Int b[2]{};
+    const TableColumn columns[]{
+        TableColumn{"A", Containers::stridedArrayView(a)},
+        TableColumn{"B", Containers::stridedArrayView(b)}
+    };
+
+    TableIndex index;
+
+    Containers::String out;
+    Error redirectError{&out};
+    index.setSort(-2);
+    index.update(columns);
+    index.setSort(2);
+    index.update(Containers::arrayView(columns).prefix(1));
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::TableIndex::setSort(): invalid column -2\n"
+        "ImGuiIntegration::TableIndex::update(): expected column 1 to have 3 rows but got 2\n"
+        "ImGuiIntegration::TableIndex::update(): sort column 2 out of range for 1 columns\n");
+}
+
+void WidgetsTest::plotCache() {
+    /* Deterministic pseudo-random data spanning several pyramid levels */
+    Containers::Array<Float> data{NoInit, 1000};
+    UnsignedInt seed = 1;
+    for(Float& i: data) {
+        seed = seed*1103515245u + 12345u;
+        i = Float((seed >> 16) & 0x7fff) - 16384.0f;
+    }
+    const Containers::StridedArrayView1D<const Float> samples = Containers::stridedArrayView(data);
+
+    PlotCache cache;
+    CORRADE_COMPARE(cache.sampleCount(), 0);
+    cache.update(samples);
+    CORRADE_COMPARE(cache.sampleCount(), 1000);
+
+    /* Ranges within a block, across block boundaries, aligned to blocks and
+       covering everything */
+    for(std::size_t begin: {0, 1, 15, 16, 17, 100, 255, 256, 511, 999}) {
+        for(std::size_t end: {1, 2, 16, 17, 31, 32, 33, 250, 256, 512, 513, 998, 1000}) {
+            if(begin >= end) continue;
+            CORRADE_ITERATION(begin);
+            CORRADE_ITERATION(end);
+            CORRADE_COMPARE(cache.range(samples, begin, end),
+                bruteForceRange(data, begin, end));
+        }
+    }
+}
+
+void WidgetsTest::plotCacheAppend() {
+    /* Growing telemetry, with only the new samples being processed */
+    Containers::Array<Float> samples;
+    for(std::size_t i = 0; i != 40; ++i)
+        arrayAppend(samples, Float(i % 7));
+
+    PlotCache cache;
+    cache.update(Containers::stridedArrayView(samples));
+    CORRADE_COMPARE(cache.range(Containers::stridedArrayView(samples), 0, 40), (Range1D{0.0f, 6.0f}));
+
+    /* Updating with the same data doesn't change anything */
+    cache.update(Containers::stridedArrayView(samples));
+    CORRADE_COMPARE(cache.sampleCount(), 40);
+
+    /* New extremes in the appended samples, completing the partial block */
+    for(std::size_t i = 0; i != 100; ++i)
+        arrayAppend(samples, i == 50 ? 100.0f : i == 70 ? -3.0f : 1.0f);
+    cache.update(Containers::stridedArrayView(samples));
+    CORRADE_COMPARE(cache.sampleCount(), 140);
+    CORRADE_COMPARE(cache.range(Containers::stridedArrayView(samples), 0, 140), (Range1D{-3.0f, 100.0f}));
+    CORRADE_COMPARE(cache.range(Containers::stridedArrayView(samples), 0, 90), (Range1D{0.0f, 6.0f}));
+    CORRADE_COMPARE(cache.range(Containers::stridedArrayView(samples), 91, 140), (Range1D{-3.0f, 1.0f}));
+    for(std::size_t begin = 0; begin != 140; begin += 7) {
+        CORRADE_ITERATION(begin);
+        CORRADE_COMPARE(cache.range(Containers::stridedArrayView(samples), begin, 140),
+            bruteForceRange(samples, begin, 140));
+    }
+}
+
+void WidgetsTest::plotCacheShrink() {
+    const Float samples[]{
+        5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f, 1.0f, 2.0f,
+        3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f,
+        11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f, 17.0f, 18.0f,
+        19.0f, 20.0f, 21.0f, 22.0f, 23.0f, 24.0f, 25.0f, 26.0f,
+        27.0f, 28.0f
+    };
+
+    PlotCache cache;
+    cache.update(samples);
+    CORRADE_COMPARE(cache.range(samples, 0, 34), (Range1D{0.0f, 28.0f}));
+
+    /* Fewer samples make the cache rebuild */
+    const Containers::StridedArrayView1D<const Float> fewer = Containers::stridedArrayView(samples).prefix(20);
+    cache.update(fewer);
+    CORRADE_COMPARE(cache.sampleCount(), 20);
+    CORRADE_COMPARE(cache.range(fewer, 0, 20), (Range1D{0.0f, 14.0f}));
+}
+
+void WidgetsTest::plotCacheInvalidate() {
+    Float samples[40]{};
+    samples[3] = 1.0f;
+
+    PlotCache cache;
+    cache.update(samples);
+    CORRADE_COMPARE(cache.range(samples, 0, 32), (Range1D{0.0f, 1.0f}));
+
+    /* Modifying the data isn't detected for whole blocks */
+    samples[5] = 2.0f;
+    cache.update(samples);
+    CORRADE_COMPARE(cache.range(samples, 0, 32), (Range1D{0.0f, 1.0f}));
+
+    /* Until the cache is invalidated */
+    cache.invalidate();
+    CORRADE_COMPARE(cache.sampleCount(), 0);
+    cache.update(samples);
+    CORRADE_COMPARE(cache.range(samples, 0, 32), (Range1D{0.0f, 2.0f}));
+}
+
+void WidgetsTest::plotCacheInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Float samples[20]{};
+
+    PlotCache cache;
+    cache.update(Containers::stridedArrayView(samples).prefix(10));
+
+    Containers::String out;
+    Error redirectError{&out};
+    cache.range(samples, 0, 5);
+    cache.range(Containers::stridedArrayView(samples).prefix(10), 5, 5);
+    cache.range(Containers::stridedArrayView(samples).prefix(10), 5, 11);
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::PlotCache::range(): expected 10 samples but got 20\n"
+        "ImGuiIntegration::PlotCache::range(): invalid range [5, 5) for 10 samples\n"
+        "ImGuiIntegration::PlotCache::range(): invalid range [5, 11) for 10 samples\n");
+}
+
+void WidgetsTest::plotInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* Checked before any ImGui function is called, so no context is needed */
+    const Float x[3]{};
+    const Float values[2]{};
+
+    Containers::String out;
+    Error redirectError{&out};
+    plot("plot", x, values);
+    CORRADE_COMPARE(out,
+        "ImGuiIntegration::plot(): expected 2 X coordinates but got 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::WidgetsTest)
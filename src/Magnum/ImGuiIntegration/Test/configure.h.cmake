@@ -26,3 +26,4 @@
 */
 
 #define IMGUIINTEGRATION_TEST_DIR "${IMGUIINTEGRATION_TEST_DIR}"
+#define IMGUIINTEGRATION_TEST_OUTPUT_DIR "${IMGUIINTEGRATION_TEST_OUTPUT_DIR}"
@@ -0,0 +1,836 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VulkanRenderer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Move.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Vk/Assert.h>
+#include <Magnum/Vk/Buffer.h>
+#include <Magnum/Vk/BufferCreateInfo.h>
+#include <Magnum/Vk/CommandBuffer.h>
+#include <Magnum/Vk/Device.h>
+#include <Magnum/Vk/Image.h>
+#include <Magnum/Vk/ImageCreateInfo.h>
+#include <Magnum/Vk/ImageView.h>
+#include <Magnum/Vk/ImageViewCreateInfo.h>
+#include <Magnum/Vk/Memory.h>
+#include <Magnum/Vk/PixelFormat.h>
+#include <Magnum/Vk/RenderPass.h>
+
+#include "Magnum/ImGuiIntegration/CommandList.h"
+#include "Magnum/ImGuiIntegration/Integration.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+/* SPIR-V 1.0 equivalent to the following GLSL. The vertex shader:
+
+    layout(location = 0) in vec2 position;
+    layout(location = 1) in vec2 textureCoordinates;
+    layout(location = 2) in vec4 color;
+
+    layout(push_constant) uniform PushConstants {
+        vec2 scale;
+        vec2 translation;
+    };
+
+    layout(location = 0) out vec2 interpolatedTextureCoordinates;
+    layout(location = 1) out vec4 interpolatedColor;
+
+    void main() {
+        interpolatedTextureCoordinates = textureCoordinates;
+        interpolatedColor = color;
+        gl_Position = vec4(position*scale + translation, 0.0, 1.0);
+    }
+
+   And the fragment shader:
+
+    layout(set = 0, binding = 0) uniform sampler2D textureData;
+
+    layout(location = 0) in vec2 interpolatedTextureCoordinates;
+    layout(location = 1) in vec4 interpolatedColor;
+
+    layout(location = 0) out vec4 fragmentColor;
+
+    void main() {
+        fragmentColor = interpolatedColor*texture(textureData, interpolatedTextureCoordinates);
+    }
+*/
+constexpr UnsignedInt VertexShaderCode[]{
+    0x07230203, 0x00010000, 0x00000000, 0x00000027, 0x00000000, 0x00020011,
+    0x00000001, 0x0003000e, 0x00000000, 0x00000001, 0x000b000f, 0x00000000,
+    0x00000001, 0x6e69616d, 0x00000000, 0x00000002, 0x00000003, 0x00000004,
+    0x00000005, 0x00000006, 0x00000007, 0x00040047, 0x00000002, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000003, 0x0000001e, 0x00000001, 0x00040047,
+    0x00000004, 0x0000001e, 0x00000002, 0x00040047, 0x00000005, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000006, 0x0000001e, 0x00000001, 0x00040047,
+    0x00000007, 0x0000000b, 0x00000000, 0x00030047, 0x00000008, 0x00000002,
+    0x00050048, 0x00000008, 0x00000000, 0x00000023, 0x00000000, 0x00050048,
+    0x00000008, 0x00000001, 0x00000023, 0x00000008, 0x00020013, 0x00000009,
+    0x00030021, 0x0000000a, 0x00000009, 0x00030016, 0x0000000b, 0x00000020,
+    0x00040017, 0x0000000c, 0x0000000b, 0x00000002, 0x00040017, 0x0000000d,
+    0x0000000b, 0x00000004, 0x00040015, 0x0000000e, 0x00000020, 0x00000001,
+    0x00040020, 0x0000000f, 0x00000001, 0x0000000c, 0x00040020, 0x00000010,
+    0x00000001, 0x0000000d, 0x00040020, 0x00000011, 0x00000003, 0x0000000c,
+    0x00040020, 0x00000012, 0x00000003, 0x0000000d, 0x0004001e, 0x00000008,
+    0x0000000c, 0x0000000c, 0x00040020, 0x00000013, 0x00000009, 0x00000008,
+    0x00040020, 0x00000014, 0x00000009, 0x0000000c, 0x0004002b, 0x0000000e,
+    0x00000015, 0x00000000, 0x0004002b, 0x0000000e, 0x00000016, 0x00000001,
+    0x0004002b, 0x0000000b, 0x00000017, 0x00000000, 0x0004002b, 0x0000000b,
+    0x00000018, 0x3f800000, 0x0004003b, 0x0000000f, 0x00000002, 0x00000001,
+    0x0004003b, 0x0000000f, 0x00000003, 0x00000001, 0x0004003b, 0x00000010,
+    0x00000004, 0x00000001, 0x0004003b, 0x00000011, 0x00000005, 0x00000003,
+    0x0004003b, 0x00000012, 0x00000006, 0x00000003, 0x0004003b, 0x00000012,
+    0x00000007, 0x00000003, 0x0004003b, 0x00000013, 0x00000019, 0x00000009,
+    0x00050036, 0x00000009, 0x00000001, 0x00000000, 0x0000000a, 0x000200f8,
+    0x0000001a, 0x0004003d, 0x0000000c, 0x0000001b, 0x00000003, 0x0003003e,
+    0x00000005, 0x0000001b, 0x0004003d, 0x0000000d, 0x0000001c, 0x00000004,
+    0x0003003e, 0x00000006, 0x0000001c, 0x0004003d, 0x0000000c, 0x0000001d,
+    0x00000002, 0x00050041, 0x00000014, 0x0000001e, 0x00000019, 0x00000015,
+    0x0004003d, 0x0000000c, 0x0000001f, 0x0000001e, 0x00050041, 0x00000014,
+    0x00000020, 0x00000019, 0x00000016, 0x0004003d, 0x0000000c, 0x00000021,
+    0x00000020, 0x00050085, 0x0000000c, 0x00000022, 0x0000001d, 0x0000001f,
+    0x00050081, 0x0000000c, 0x00000023, 0x00000022, 0x00000021, 0x00050051,
+    0x0000000b, 0x00000024, 0x00000023, 0x00000000, 0x00050051, 0x0000000b,
+    0x00000025, 0x00000023, 0x00000001, 0x00070050, 0x0000000d, 0x00000026,
+    0x00000024, 0x00000025, 0x00000017, 0x00000018, 0x0003003e, 0x00000007,
+    0x00000026, 0x000100fd, 0x00010038
+};
+
+constexpr UnsignedInt FragmentShaderCode[]{
+    0x07230203, 0x00010000, 0x00000000, 0x00000017, 0x00000000, 0x00020011,
+    0x00000001, 0x0003000e, 0x00000000, 0x00000001, 0x0008000f, 0x00000004,
+    0x00000001, 0x6e69616d, 0x00000000, 0x00000002, 0x00000003, 0x00000004,
+    0x00030010, 0x00000001, 0x00000007, 0x00040047, 0x00000002, 0x0000001e,
+    0x00000000, 0x00040047, 0x00000003, 0x0000001e, 0x00000001, 0x00040047,
+    0x00000004, 0x0000001e, 0x00000000, 0x00040047, 0x00000005, 0x00000022,
+    0x00000000, 0x00040047, 0x00000005, 0x00000021, 0x00000000, 0x00020013,
+    0x00000006, 0x00030021, 0x00000007, 0x00000006, 0x00030016, 0x00000008,
+    0x00000020, 0x00040017, 0x00000009, 0x00000008, 0x00000002, 0x00040017,
+    0x0000000a, 0x00000008, 0x00000004, 0x00090019, 0x0000000b, 0x00000008,
+    0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000,
+    0x0003001b, 0x0000000c, 0x0000000b, 0x00040020, 0x0000000d, 0x00000000,
+    0x0000000c, 0x00040020, 0x0000000e, 0x00000001, 0x00000009, 0x00040020,
+    0x0000000f, 0x00000001, 0x0000000a, 0x00040020, 0x00000010, 0x00000003,
+    0x0000000a, 0x0004003b, 0x0000000d, 0x00000005, 0x00000000, 0x0004003b,
+    0x0000000e, 0x00000002, 0x00000001, 0x0004003b, 0x0000000f, 0x00000003,
+    0x00000001, 0x0004003b, 0x00000010, 0x00000004, 0x00000003, 0x00050036,
+    0x00000006, 0x00000001, 0x00000000, 0x00000007, 0x000200f8, 0x00000011,
+    0x0004003d, 0x0000000c, 0x00000012, 0x00000005, 0x0004003d, 0x00000009,
+    0x00000013, 0x00000002, 0x00050057, 0x0000000a, 0x00000014, 0x00000012,
+    0x00000013, 0x0004003d, 0x0000000a, 0x00000015, 0x00000003, 0x00050085,
+    0x0000000a, 0x00000016, 0x00000015, 0x00000014, 0x0003003e, 0x00000004,
+    0x00000016, 0x000100fd, 0x00010038
+};
+
+struct PushConstants {
+    Vector2 scale;
+    Vector2 translation;
+};
+
+/* Descriptor sets are never freed, only reused for subsequently added
+   textures, so the pools don't need to support freeing either */
+constexpr UnsignedInt DescriptorSetsPerPool = 64;
+
+struct Texture {
+    VkDescriptorSet descriptorSet;
+    bool used;
+    /* Frame in which the texture was removed, the descriptor set can be
+       updated again only once the GPU is done with it */
+    UnsignedLong removedFrame;
+    /* Empty if the texture was added from an external image view */
+    Vk::Image image{NoCreate};
+    Vk::ImageView view{NoCreate};
+    Vector2i size;
+    UnsignedInt pixelSize;
+    /* Whether the image has any contents yet, i.e. whether its layout is
+       shader read only or undefined */
+    bool initialized;
+};
+
+/* Vertex and index data, and data for texture uploads. Kept for each frame
+   in flight. */
+struct Frame {
+    Vk::Buffer buffer{NoCreate};
+    UnsignedLong bufferSize;
+    Vk::Buffer stagingBuffer{NoCreate};
+    UnsignedLong stagingBufferSize;
+};
+
+/* Image of a removed texture, destroyed once the GPU is done with it */
+struct Garbage {
+    UnsignedLong frame;
+    Vk::Image image{NoCreate};
+    Vk::ImageView view{NoCreate};
+};
+
+/* Data of a texture added with addTexture(const ImageView2D&), uploaded in
+   the next upload() */
+struct PendingUpload {
+    /* Set to ~std::size_t{} if the texture got removed before the upload */
+    std::size_t texture;
+    Containers::Array<Color4ub> data;
+};
+
+struct Upload {
+    VkImage image;
+    bool initialized;
+    UnsignedInt regionOffset;
+    UnsignedInt regionCount;
+};
+
+#if IMGUI_VERSION_NUM >= 19131
+inline ImTextureID textureIdForIndex(const std::size_t index) {
+    return ImTextureID(index + 1);
+}
+
+inline std::size_t textureIndexForId(const ImTextureID id) {
+    return std::size_t(id) - 1;
+}
+#else
+inline ImTextureID textureIdForIndex(const std::size_t index) {
+    return reinterpret_cast<ImTextureID>(std::uintptr_t(index + 1));
+}
+
+inline std::size_t textureIndexForId(const ImTextureID id) {
+    return std::size_t(reinterpret_cast<std::uintptr_t>(id)) - 1;
+}
+#endif
+
+VkFilter vkFilter(const SamplerFilter filter) {
+    return filter == SamplerFilter::Nearest ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+}
+
+}
+
+struct VulkanRenderer::State {
+    explicit State(Vk::Device& device, UnsignedInt framesInFlight);
+    ~State();
+
+    std::size_t addTextureSlot();
+    void setTexture(std::size_t index, VkImageView view, SamplerFilter filter);
+    void createTextureImage(Texture& texture, const Vector2i& size, bool singleChannel);
+    void removeTextureSlot(std::size_t index);
+    char* addUploadRegion(Texture& texture, const Range2Di& region);
+    void ensureBufferSize(Vk::Buffer& buffer, UnsignedLong& bufferSize, UnsignedLong size, Vk::BufferUsages usages);
+    void bindRenderState(VkCommandBuffer commandBuffer, Frame& currentFrame, const ImDrawData& drawData);
+
+    Vk::Device& device;
+    UnsignedInt framesInFlight;
+
+    /* Indexed with SamplerFilter */
+    VkSampler samplers[2]{};
+    VkDescriptorSetLayout descriptorSetLayout{};
+    VkPipelineLayout pipelineLayout{};
+    VkPipeline pipeline{};
+
+    Containers::Array<VkDescriptorPool> descriptorPools;
+    /* Count of sets allocated from the last pool */
+    UnsignedInt descriptorPoolUsage = DescriptorSetsPerPool;
+
+    /* Index is the texture ID minus one */
+    Containers::Array<Texture> textures;
+    std::size_t textureCount = 0;
+
+    Containers::Array<Frame> frames;
+    /* Incremented in each upload(), so the first frame is 1 */
+    UnsignedLong frame = 0;
+    Containers::Array<Garbage> garbage;
+    Containers::Array<PendingUpload> pendingUploads;
+
+    /* Reused across upload() calls */
+    CommandList commandList{CommandList::Flag::CombinedBuffers};
+    Containers::Array<char> stagingData;
+    Containers::Array<Upload> uploads;
+    Containers::Array<VkBufferImageCopy> uploadRegions;
+    Containers::Array<VkImageMemoryBarrier> barriers;
+};
+
+VulkanRenderer::State::State(Vk::Device& device, const UnsignedInt framesInFlight): device(device), framesInFlight{framesInFlight}, frames{ValueInit, framesInFlight} {
+    for(const SamplerFilter filter: {SamplerFilter::Nearest, SamplerFilter::Linear}) {
+        VkSamplerCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        info.magFilter = vkFilter(filter);
+        info.minFilter = vkFilter(filter);
+        info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.maxLod = 0.25f;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateSampler(device, &info, nullptr, &samplers[UnsignedInt(filter)]));
+    }
+
+    {
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        VkDescriptorSetLayoutCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        info.bindingCount = 1;
+        info.pBindings = &binding;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateDescriptorSetLayout(device, &info, nullptr, &descriptorSetLayout));
+    }
+
+    {
+        VkPushConstantRange range{};
+        range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        range.offset = 0;
+        range.size = sizeof(PushConstants);
+
+        VkPipelineLayoutCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        info.setLayoutCount = 1;
+        info.pSetLayouts = &descriptorSetLayout;
+        info.pushConstantRangeCount = 1;
+        info.pPushConstantRanges = &range;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreatePipelineLayout(device, &info, nullptr, &pipelineLayout));
+    }
+}
+
+VulkanRenderer::State::~State() {
+    device->DestroyPipeline(device, pipeline, nullptr);
+    device->DestroyPipelineLayout(device, pipelineLayout, nullptr);
+    /* Frees all descriptor sets as well */
+    for(VkDescriptorPool pool: descriptorPools)
+        device->DestroyDescriptorPool(device, pool, nullptr);
+    device->DestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+    for(VkSampler sampler: samplers)
+        device->DestroySampler(device, sampler, nullptr);
+}
+
+/* Returns a free texture slot with a descriptor set that's safe to update,
+   allocating a new one if there's none */
+std::size_t VulkanRenderer::State::addTextureSlot() {
+    for(std::size_t i = 0; i != textures.size(); ++i) {
+        const Texture& texture = textures[i];
+        if(!texture.used && texture.removedFrame + framesInFlight <= frame)
+            return i;
+    }
+
+    if(descriptorPoolUsage == DescriptorSetsPerPool) {
+        VkDescriptorPoolSize size{};
+        size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        size.descriptorCount = DescriptorSetsPerPool;
+
+        VkDescriptorPoolCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        info.maxSets = DescriptorSetsPerPool;
+        info.poolSizeCount = 1;
+        info.pPoolSizes = &size;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateDescriptorPool(device, &info, nullptr, &arrayAppend(descriptorPools, VkDescriptorPool{})));
+        descriptorPoolUsage = 0;
+    }
+
+    VkDescriptorSetAllocateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    info.descriptorPool = descriptorPools.back();
+    info.descriptorSetCount = 1;
+    info.pSetLayouts = &descriptorSetLayout;
+    Texture& texture = arrayAppend(textures, InPlaceInit);
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->AllocateDescriptorSets(device, &info, &texture.descriptorSet));
+    ++descriptorPoolUsage;
+    return textures.size() - 1;
+}
+
+void VulkanRenderer::State::setTexture(const std::size_t index, const VkImageView view, const SamplerFilter filter) {
+    Texture& texture = textures[index];
+    texture.used = true;
+
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.sampler = samplers[UnsignedInt(filter)];
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = texture.descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    device->UpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+    ++textureCount;
+}
+
+/* Creates an image for the texture, with single-channel textures swizzled to
+   white with the value in alpha, the same as Context does */
+void VulkanRenderer::State::createTextureImage(Texture& texture, const Vector2i& size, const bool singleChannel) {
+    texture.image = Vk::Image{device, Vk::ImageCreateInfo2D{
+        Vk::ImageUsage::Sampled|Vk::ImageUsage::TransferDestination,
+        singleChannel ? Vk::PixelFormat::R8Unorm : Vk::PixelFormat::RGBA8Unorm,
+        size, 1}, Vk::MemoryFlag::DeviceLocal};
+    Vk::ImageViewCreateInfo2D info{texture.image};
+    if(singleChannel) info->components = {
+        VK_COMPONENT_SWIZZLE_ONE,
+        VK_COMPONENT_SWIZZLE_ONE,
+        VK_COMPONENT_SWIZZLE_ONE,
+        VK_COMPONENT_SWIZZLE_R
+    };
+    texture.view = Vk::ImageView{device, info};
+    texture.size = size;
+    texture.pixelSize = singleChannel ? 1 : 4;
+    texture.initialized = false;
+}
+
+void VulkanRenderer::State::removeTextureSlot(const std::size_t index) {
+    Texture& texture = textures[index];
+    if(texture.image.handle()) {
+        Garbage& out = arrayAppend(garbage, InPlaceInit);
+        out.frame = frame;
+        out.image = Utility::move(texture.image);
+        out.view = Utility::move(texture.view);
+    }
+    texture.used = false;
+    texture.removedFrame = frame;
+    --textureCount;
+}
+
+/* Appends an upload region, with row data to be filled by the caller */
+char* VulkanRenderer::State::addUploadRegion(Texture& texture, const Range2Di& region) {
+    if(uploads.isEmpty() || uploads.back().image != texture.image.handle()) {
+        Upload& upload = arrayAppend(uploads, InPlaceInit);
+        upload.image = texture.image;
+        upload.initialized = texture.initialized;
+        upload.regionOffset = uploadRegions.size();
+        texture.initialized = true;
+    }
+    ++uploads.back().regionCount;
+
+    /* Buffer offsets have to be a multiple of four */
+    const std::size_t offset = (stagingData.size() + 3) & ~std::size_t{3};
+    const std::size_t size = std::size_t(region.size().product())*texture.pixelSize;
+    arrayResize(stagingData, NoInit, offset + size);
+
+    VkBufferImageCopy& copy = arrayAppend(uploadRegions, InPlaceInit);
+    copy.bufferOffset = offset;
+    copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copy.imageSubresource.layerCount = 1;
+    copy.imageOffset = {region.min().x(), region.min().y(), 0};
+    copy.imageExtent = {UnsignedInt(region.sizeX()), UnsignedInt(region.sizeY()), 1};
+    return stagingData + offset;
+}
+
+/* Ensures the buffer is at least as large as requested. The buffer isn't
+   used by the GPU anymore at this point, so it can be replaced right
+   away. */
+void VulkanRenderer::State::ensureBufferSize(Vk::Buffer& buffer, UnsignedLong& bufferSize, const UnsignedLong size, const Vk::BufferUsages usages) {
+    if(bufferSize >= size) return;
+    bufferSize = Math::max(size, bufferSize*2);
+    buffer = Vk::Buffer{device, Vk::BufferCreateInfo{usages, bufferSize}, Vk::MemoryFlag::HostVisible|Vk::MemoryFlag::HostCoherent};
+}
+
+void VulkanRenderer::State::bindRenderState(const VkCommandBuffer commandBuffer, Frame& currentFrame, const ImDrawData& drawData) {
+    device->CmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+    if(commandList.vertexCount()) {
+        const VkBuffer buffer = currentFrame.buffer;
+        const VkDeviceSize offset = 0;
+        device->CmdBindVertexBuffers(commandBuffer, 0, 1, &buffer, &offset);
+        device->CmdBindIndexBuffer(commandBuffer, buffer, commandList.indexDataOffset(), sizeof(ImDrawIdx) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+    }
+
+    const Range2Di framebufferRect = commandList.framebufferRect();
+    VkViewport viewport{};
+    viewport.width = Float(framebufferRect.sizeX());
+    viewport.height = Float(framebufferRect.sizeY());
+    viewport.maxDepth = 1.0f;
+    device->CmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    /* Maps the display rectangle to [-1, 1], Vulkan has Y down so there's no
+       need to flip */
+    PushConstants pushConstants;
+    pushConstants.scale = 2.0f/Vector2{drawData.DisplaySize};
+    pushConstants.translation = Vector2{-1.0f} - Vector2{drawData.DisplayPos}*pushConstants.scale;
+    device->CmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstants), &pushConstants);
+}
+
+VulkanRenderer::VulkanRenderer(Vk::Device& device, Vk::RenderPass& renderPass, const UnsignedInt subpass, const UnsignedInt framesInFlight) {
+    CORRADE_ASSERT(framesInFlight,
+        "ImGuiIntegration::VulkanRenderer: expected a non-zero count of frames in flight", );
+
+    _state.emplace(device, framesInFlight);
+    State& state = *_state;
+
+    VkShaderModule shaders[2];
+    {
+        VkShaderModuleCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        info.codeSize = sizeof(VertexShaderCode);
+        info.pCode = VertexShaderCode;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateShaderModule(device, &info, nullptr, &shaders[0]));
+        info.codeSize = sizeof(FragmentShaderCode);
+        info.pCode = FragmentShaderCode;
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateShaderModule(device, &info, nullptr, &shaders[1]));
+    }
+
+    VkPipelineShaderStageCreateInfo stages[2]{};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = shaders[0];
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = shaders[1];
+    stages[1].pName = "main";
+
+    VkVertexInputBindingDescription binding{};
+    binding.binding = 0;
+    binding.stride = sizeof(ImDrawVert);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    VkVertexInputAttributeDescription attributes[3]{};
+    attributes[0].location = 0;
+    attributes[0].format = VK_FORMAT_R32G32_SFLOAT;
+    attributes[0].offset = offsetof(ImDrawVert, pos);
+    attributes[1].location = 1;
+    attributes[1].format = VK_FORMAT_R32G32_SFLOAT;
+    attributes[1].offset = offsetof(ImDrawVert, uv);
+    attributes[2].location = 2;
+    attributes[2].format = VK_FORMAT_R8G8B8A8_UNORM;
+    attributes[2].offset = offsetof(ImDrawVert, col);
+
+    VkPipelineVertexInputStateCreateInfo vertexInput{};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = 1;
+    vertexInput.pVertexBindingDescriptions = &binding;
+    vertexInput.vertexAttributeDescriptionCount = 3;
+    vertexInput.pVertexAttributeDescriptions = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    /* Viewport and scissor are dynamic */
+    VkPipelineViewportStateCreateInfo viewport{};
+    viewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport.viewportCount = 1;
+    viewport.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterization{};
+    rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode = VK_CULL_MODE_NONE;
+    rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+
+    VkPipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.blendEnable = VK_TRUE;
+    blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT|VK_COLOR_COMPONENT_G_BIT|VK_COLOR_COMPONENT_B_BIT|VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo blend{};
+    blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    blend.attachmentCount = 1;
+    blend.pAttachments = &blendAttachment;
+
+    const VkDynamicState dynamicStates[]{
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR
+    };
+    VkPipelineDynamicStateCreateInfo dynamic{};
+    dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = Containers::arraySize(dynamicStates);
+    dynamic.pDynamicStates = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.stageCount = 2;
+    info.pStages = stages;
+    info.pVertexInputState = &vertexInput;
+    info.pInputAssemblyState = &inputAssembly;
+    info.pViewportState = &viewport;
+    info.pRasterizationState = &rasterization;
+    info.pMultisampleState = &multisample;
+    info.pDepthStencilState = &depthStencil;
+    info.pColorBlendState = &blend;
+    info.pDynamicState = &dynamic;
+    info.layout = state.pipelineLayout;
+    info.renderPass = renderPass;
+    info.subpass = subpass;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateGraphicsPipelines(device, {}, 1, &info, nullptr, &state.pipeline));
+
+    device->DestroyShaderModule(device, shaders[0], nullptr);
+    device->DestroyShaderModule(device, shaders[1], nullptr);
+}
+
+VulkanRenderer::VulkanRenderer(NoCreateT) noexcept {}
+
+VulkanRenderer::VulkanRenderer(VulkanRenderer&&) noexcept = default;
+
+VulkanRenderer::~VulkanRenderer() = default;
+
+VulkanRenderer& VulkanRenderer::operator=(VulkanRenderer&&) noexcept = default;
+
+UnsignedInt VulkanRenderer::framesInFlight() const {
+    return _state->framesInFlight;
+}
+
+std::size_t VulkanRenderer::textureCount() const {
+    return _state->textureCount;
+}
+
+ImTextureID VulkanRenderer::addTexture(Vk::ImageView& view, const SamplerFilter filter) {
+    State& state = *_state;
+    const std::size_t index = state.addTextureSlot();
+    state.setTexture(index, view, filter);
+    return textureIdForIndex(index);
+}
+
+ImTextureID VulkanRenderer::addTexture(const ImageView2D& image, const SamplerFilter filter) {
+    const PixelFormat format = image.format();
+    const bool rgba = format == PixelFormat::RGBA8Unorm || format == PixelFormat::RGBA8Srgb;
+    CORRADE_ASSERT(rgba || format == PixelFormat::RGB8Unorm || format == PixelFormat::RGB8Srgb,
+        "ImGuiIntegration::VulkanRenderer::addTexture(): expected an RGBA8 or RGB8 image, got" << format, {});
+    CORRADE_ASSERT(image.size().product(),
+        "ImGuiIntegration::VulkanRenderer::addTexture(): expected a non-empty image", {});
+
+    State& state = *_state;
+    const std::size_t index = state.addTextureSlot();
+    Texture& texture = state.textures[index];
+    state.createTextureImage(texture, image.size(), false);
+    state.setTexture(index, texture.view, filter);
+
+    /* Convert the data to a tightly packed RGBA8 right away, as the view
+       isn't guaranteed to stay alive until the upload */
+    PendingUpload& upload = arrayAppend(state.pendingUploads, InPlaceInit);
+    upload.texture = index;
+    upload.data = Containers::Array<Color4ub>{NoInit, std::size_t(image.size().product())};
+    const Containers::StridedArrayView2D<Color4ub> out{upload.data, {std::size_t(image.size().y()), std::size_t(image.size().x())}};
+    if(rgba) {
+        const Containers::StridedArrayView2D<const Color4ub> in = image.pixels<Color4ub>();
+        for(std::size_t y = 0; y != out.size()[0]; ++y)
+            for(std::size_t x = 0; x != out.size()[1]; ++x)
+                out[y][x] = in[y][x];
+    } else {
+        const Containers::StridedArrayView2D<const Color3ub> in = image.pixels<Color3ub>();
+        for(std::size_t y = 0; y != out.size()[0]; ++y)
+            for(std::size_t x = 0; x != out.size()[1]; ++x)
+                out[y][x] = Color4ub{in[y][x], 255};
+    }
+
+    return textureIdForIndex(index);
+}
+
+void VulkanRenderer::removeTexture(const ImTextureID id) {
+    State& state = *_state;
+    const std::size_t index = textureIndexForId(id);
+    CORRADE_ASSERT(index < state.textures.size() && state.textures[index].used,
+        "ImGuiIntegration::VulkanRenderer::removeTexture(): texture" << id << "not found", );
+
+    for(PendingUpload& upload: state.pendingUploads)
+        if(upload.texture == index) upload.texture = ~std::size_t{};
+
+    state.removeTextureSlot(index);
+}
+
+void VulkanRenderer::upload(Vk::CommandBuffer& commandBuffer, ImDrawData& drawData) {
+    State& state = *_state;
+    Vk::Device& device = state.device;
+
+    /* The application waited for the frame that used the same buffers to
+       finish, so images removed that long ago can be destroyed */
+    ++state.frame;
+    {
+        std::size_t i = 0;
+        for(Garbage& garbage: state.garbage)
+            if(garbage.frame + state.framesInFlight > state.frame)
+                state.garbage[i++] = Utility::move(garbage);
+        arrayRemoveSuffix(state.garbage, state.garbage.size() - i);
+    }
+
+    const CommandList& commandList = state.commandList.build(drawData);
+    Frame& frame = state.frames[state.frame % state.framesInFlight];
+
+    /* Collect all texture uploads into a single staging buffer */
+    arrayRemoveSuffix(state.stagingData, state.stagingData.size());
+    arrayRemoveSuffix(state.uploads, state.uploads.size());
+    arrayRemoveSuffix(state.uploadRegions, state.uploadRegions.size());
+    for(const PendingUpload& upload: state.pendingUploads) {
+        if(upload.texture == ~std::size_t{}) continue;
+        Texture& texture = state.textures[upload.texture];
+        std::memcpy(state.addUploadRegion(texture, {{}, texture.size}), upload.data.data(), upload.data.size()*sizeof(Color4ub));
+    }
+    arrayRemoveSuffix(state.pendingUploads, state.pendingUploads.size());
+
+    #ifdef IMGUI_HAS_TEXTURES
+    for(const CommandListTexture& request: commandList.textures()) {
+        ImTextureData& texture = *request.texture;
+
+        if(request.operation == CommandListTextureOperation::Destroy) {
+            const std::size_t index = textureIndexForId(texture.GetTexID());
+            CORRADE_INTERNAL_ASSERT(index < state.textures.size());
+            state.removeTextureSlot(index);
+            texture.SetTexID(ImTextureID_Invalid);
+            texture.SetStatus(ImTextureStatus_Destroyed);
+            continue;
+        }
+
+        CORRADE_INTERNAL_ASSERT(texture.Format == ImTextureFormat_Alpha8 || texture.Format == ImTextureFormat_RGBA32);
+        std::size_t index;
+        if(request.operation == CommandListTextureOperation::Create) {
+            index = state.addTextureSlot();
+            state.createTextureImage(state.textures[index], {texture.Width, texture.Height}, texture.Format == ImTextureFormat_Alpha8);
+            state.setTexture(index, state.textures[index].view, SamplerFilter::Linear);
+            texture.SetTexID(textureIdForIndex(index));
+        } else index = textureIndexForId(texture.GetTexID());
+        CORRADE_INTERNAL_ASSERT(index < state.textures.size());
+
+        Texture& out = state.textures[index];
+        for(const Range2Di& region: commandList.textureRegions().sliceSize(request.regionOffset, request.regionCount)) {
+            char* data = state.addUploadRegion(out, region);
+            const std::size_t rowSize = std::size_t(region.sizeX())*out.pixelSize;
+            for(Int y = region.min().y(); y != region.max().y(); ++y, data += rowSize)
+                std::memcpy(data, texture.GetPixelsAt(region.min().x(), y), rowSize);
+        }
+        texture.SetStatus(ImTextureStatus_OK);
+    }
+    #endif
+
+    if(!state.uploads.isEmpty()) {
+        state.ensureBufferSize(frame.stagingBuffer, frame.stagingBufferSize, state.stagingData.size(), Vk::BufferUsage::TransferSource);
+        Containers::Array<char, Vk::MemoryMapDeleter> data = frame.stagingBuffer.dedicatedMemory().map();
+        std::memcpy(data.data(), state.stagingData.data(), state.stagingData.size());
+
+        /* Transition all images for the transfer at once, then copy, then
+           transition them for sampling again */
+        arrayRemoveSuffix(state.barriers, state.barriers.size());
+        for(const Upload& upload: state.uploads) {
+            VkImageMemoryBarrier& barrier = arrayAppend(state.barriers, InPlaceInit);
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = upload.initialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = upload.image;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.layerCount = 1;
+        }
+        device->CmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, UnsignedInt(state.barriers.size()), state.barriers);
+
+        for(const Upload& upload: state.uploads)
+            device->CmdCopyBufferToImage(commandBuffer, frame.stagingBuffer, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, upload.regionCount, state.uploadRegions + upload.regionOffset);
+
+        for(VkImageMemoryBarrier& barrier: state.barriers) {
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        }
+        device->CmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, UnsignedInt(state.barriers.size()), state.barriers);
+    }
+
+    /* Vertex and index data of all draw lists in a single buffer, written
+       directly to host-visible memory */
+    if(const std::size_t size = commandList.bufferDataSize()) {
+        state.ensureBufferSize(frame.buffer, frame.bufferSize, size, Vk::BufferUsage::VertexBuffer|Vk::BufferUsage::IndexBuffer);
+        Containers::Array<char, Vk::MemoryMapDeleter> data = frame.buffer.dedicatedMemory().map();
+        commandList.copyBufferData(drawData, data.prefix(size));
+    }
+}
+
+void VulkanRenderer::draw(Vk::CommandBuffer& commandBuffer, const ImDrawData& drawData) {
+    State& state = *_state;
+    const CommandList& commandList = state.commandList;
+    CORRADE_ASSERT(state.frame && std::size_t(drawData.TotalVtxCount) == commandList.vertexCount() && std::size_t(drawData.TotalIdxCount) == commandList.indexCount(),
+        "ImGuiIntegration::VulkanRenderer::draw(): upload() wasn't called with the same draw data", );
+
+    Vk::Device& device = state.device;
+    Frame& frame = state.frames[state.frame % state.framesInFlight];
+    state.bindRenderState(commandBuffer, frame, drawData);
+
+    VkDescriptorSet boundDescriptorSet{};
+    for(const CommandListBatch& batch: commandList.batches()) {
+        if(batch.callback) {
+            #if IMGUI_VERSION_NUM < 19280
+            if(batch.callback->UserCallback != ImDrawCallback_ResetRenderState)
+            #endif
+            {
+                batch.callback->UserCallback(drawData.CmdLists[batch.drawList], batch.callback);
+            }
+            state.bindRenderState(commandBuffer, frame, drawData);
+            boundDescriptorSet = {};
+            continue;
+        }
+
+        #ifdef IMGUI_HAS_TEXTURES
+        const ImTextureID id = batch.texture.GetTexID();
+        #else
+        const ImTextureID id = batch.texture;
+        #endif
+        const std::size_t textureIndex = textureIndexForId(id);
+        CORRADE_ASSERT(textureIndex < state.textures.size() && state.textures[textureIndex].used,
+            "ImGuiIntegration::VulkanRenderer::draw(): texture" << id << "not found", );
+        const VkDescriptorSet descriptorSet = state.textures[textureIndex].descriptorSet;
+        if(descriptorSet != boundDescriptorSet) {
+            device->CmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, state.pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+            boundDescriptorSet = descriptorSet;
+        }
+
+        /* The scissor rectangles are in framebuffer pixels with the origin at
+           the top left, the same as in Vulkan */
+        VkRect2D scissor;
+        scissor.offset = {batch.scissor.min().x(), batch.scissor.min().y()};
+        scissor.extent = {UnsignedInt(batch.scissor.sizeX()), UnsignedInt(batch.scissor.sizeY())};
+        device->CmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        for(const CommandListDraw& draw: commandList.draws().sliceSize(batch.drawOffset, batch.drawCount))
+            device->CmdDrawIndexed(commandBuffer, draw.indexCount, 1, draw.indexOffset, draw.baseVertex, 0);
+    }
+}
+
+}}
@@ -0,0 +1,221 @@
+#ifndef Magnum_ImGuiIntegration_VulkanRenderer_h
+#define Magnum_ImGuiIntegration_VulkanRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::VulkanRenderer
+ * @m_since_latest_{integration}
+ */
+
+#include "Magnum/ImGuiIntegration/configure.h"
+
+#ifdef MAGNUM_IMGUIINTEGRATION_TARGET_VK
+#include "Magnum/ImGuiIntegration/visibility.h" /* defines IMGUI_API */
+
+#include <imgui.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Sampler.h>
+#include <Magnum/Tags.h>
+#include <Magnum/Vk/Vk.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Vulkan renderer
+@m_since_latest_{integration}
+
+Draws @cpp ImDrawData @ce using Vulkan, as a counterpart to
+@ref Context::drawFrame() that draws with OpenGL. Available only if the
+library is built with `MAGNUM_IMGUIINTEGRATION_TARGET_VK` enabled, which makes
+it depend on the @ref Vk library. Same as with @ref SoftwareRenderer, the
+application sets up the ImGui context, feeds it input and builds the frame
+itself, the renderer only records the commands:
+
+@snippet ImGuiIntegration-vk.cpp VulkanRenderer
+
+@ref upload() records texture uploads and copies vertex and index data, and
+has to be called outside of a render pass. @ref draw() then records the draws
+inside a render pass that's compatible with the one passed to the constructor.
+The pipeline draws to a single color attachment with
+@cpp VK_SAMPLE_COUNT_1_BIT @ce and blends with source alpha and one minus
+source alpha, the same as recommended for @ref Context.
+
+@section ImGuiIntegration-VulkanRenderer-frames Frames in flight
+
+Vertex, index and staging buffers are kept for each frame in flight and reused
+once the renderer cycles back to them, so the buffers aren't overwritten while
+the GPU is still reading them. Each @ref upload() call starts a new frame. The
+application is expected to wait for a frame to finish on the GPU before it
+calls @ref upload() for the frame that's @ref framesInFlight() later, which is
+what a typical swapchain loop waiting on a per-frame fence does. Images and
+descriptor sets of removed textures are destroyed or reused only after the
+same delay.
+
+@section ImGuiIntegration-VulkanRenderer-textures Textures
+
+Each texture ID is backed by a descriptor set with a combined image sampler,
+allocated from descriptor pools owned by the renderer and cached for reuse by
+subsequently added textures. On ImGui 1.92 and newer, the renderer processes
+texture requests in @cpp ImDrawData::Textures @ce on its own, creating an
+image for each and uploading the updated rectangles through the per-frame
+staging buffer, and it should be advertised with
+@cpp ImGuiBackendFlags_RendererHasTextures @ce. On older versions, the font
+atlas has to be added with @ref addTexture(const ImageView2D&, SamplerFilter)
+and its ID passed to @cpp ImFontAtlas::SetTexID() @ce.
+
+@section ImGuiIntegration-VulkanRenderer-limitations Limitations
+
+Unlike @ref Context, the renderer doesn't handle input events, window size or
+DPI changes. User callbacks set with @cpp ImDrawList::AddCallback() @ce are
+called with the command buffer state being unspecified and the renderer state
+is bound again after each of them.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT VulkanRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Device to create the resources on
+         * @param renderPass        Render pass to create the pipeline for
+         * @param subpass           Subpass to create the pipeline for
+         * @param framesInFlight    Count of frames in flight
+         *
+         * Expects that @p framesInFlight is not zero. The @p device has to
+         * stay alive for the whole renderer lifetime.
+         */
+        explicit VulkanRenderer(Vk::Device& device, Vk::RenderPass& renderPass, UnsignedInt subpass = 0, UnsignedInt framesInFlight = 2);
+
+        /**
+         * @brief Construct without creating the renderer
+         *
+         * The instance is equivalent to a moved-from state. Move another
+         * object over it to make it useful.
+         */
+        explicit VulkanRenderer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        VulkanRenderer(const VulkanRenderer&) = delete;
+
+        /** @brief Move constructor */
+        VulkanRenderer(VulkanRenderer&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that the GPU doesn't use any of the resources anymore.
+         */
+        ~VulkanRenderer();
+
+        /** @brief Copying is not allowed */
+        VulkanRenderer& operator=(const VulkanRenderer&) = delete;
+
+        /** @brief Move assignment */
+        VulkanRenderer& operator=(VulkanRenderer&&) noexcept;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt framesInFlight() const;
+
+        /**
+         * @brief Count of textures
+         *
+         * Includes textures added with @ref addTexture() as well as textures
+         * created by ImGui on version 1.92 and newer.
+         */
+        std::size_t textureCount() const;
+
+        /**
+         * @brief Add an image view as a texture
+         * @param view      Image view to sample
+         * @param filter    Filtering to use when sampling the texture
+         * @return ID to use in ImGui APIs
+         *
+         * The view is expected to be in
+         * @ref Vk::ImageLayout::ShaderReadOnly when drawing and to stay alive
+         * until the texture is removed with @ref removeTexture() and the
+         * frames using it finish.
+         */
+        ImTextureID addTexture(Vk::ImageView& view, SamplerFilter filter = SamplerFilter::Linear);
+
+        /**
+         * @brief Add an image as a texture
+         * @param image     Image to copy the texture data from
+         * @param filter    Filtering to use when sampling the texture
+         * @return ID to use in ImGui APIs
+         *
+         * Expects that @p image is @ref PixelFormat::RGBA8Unorm,
+         * @ref PixelFormat::RGBA8Srgb, @ref PixelFormat::RGB8Unorm or
+         * @ref PixelFormat::RGB8Srgb. The renderer creates a device-local
+         * image for it right away, the data are copied and uploaded in the
+         * next @ref upload() call.
+         */
+        ImTextureID addTexture(const ImageView2D& image, SamplerFilter filter = SamplerFilter::Linear);
+
+        /**
+         * @brief Remove a texture
+         *
+         * Expects that @p id was returned from @ref addTexture() and wasn't
+         * removed yet. An image created by the renderer for the texture is
+         * destroyed once the frames that could use it finish.
+         */
+        void removeTexture(ImTextureID id);
+
+        /**
+         * @brief Upload data for a new frame
+         *
+         * Starts a new frame, see @ref ImGuiIntegration-VulkanRenderer-frames
+         * for when it's safe to call. Records pending texture uploads to
+         * @p commandBuffer, which has to be outside of a render pass, and
+         * copies vertex and index data of @p drawData to the frame buffers.
+         * On ImGui 1.92 and newer, texture requests in
+         * @cpp ImDrawData::Textures @ce are processed and their status is
+         * updated.
+         */
+        void upload(Vk::CommandBuffer& commandBuffer, ImDrawData& drawData);
+
+        /**
+         * @brief Draw
+         *
+         * Records draws of @p drawData to @p commandBuffer, which has to be
+         * inside a render pass compatible with the one passed to the
+         * constructor. The viewport is set to the display size scaled by
+         * @cpp ImDrawData::FramebufferScale @ce. Expects that @ref upload()
+         * was called with the same @p drawData for this frame and that all
+         * textures referenced by it were added with @ref addTexture() or
+         * created by ImGui.
+         */
+        void draw(Vk::CommandBuffer& commandBuffer, const ImDrawData& drawData);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only with MAGNUM_IMGUIINTEGRATION_TARGET_VK enabled
+#endif
+
+#endif
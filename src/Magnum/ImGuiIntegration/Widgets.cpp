@@ -0,0 +1,472 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Widgets.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Functions.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+TableColumn::TableColumn(const char* const name, const Containers::StridedArrayView1D<const Containers::StringView>& data): _name{name}, _format{}, _data{data}, _type{Type::String} {}
+
+TableColumn::TableColumn(const char* const name, const Containers::StridedArrayView1D<const Int>& data, const char* const format): _name{name}, _format{format}, _data{data}, _type{Type::Int} {}
+
+TableColumn::TableColumn(const char* const name, const Containers::StridedArrayView1D<const UnsignedInt>& data, const char* const format): _name{name}, _format{format}, _data{data}, _type{Type::UnsignedInt} {}
+
+TableColumn::TableColumn(const char* const name, const Containers::StridedArrayView1D<const Float>& data, const char* const format): _name{name}, _format{format}, _data{data}, _type{Type::Float} {}
+
+TableColumn::TableColumn(const char* const name, const Containers::StridedArrayView1D<const Double>& data, const char* const format): _name{name}, _format{format}, _data{data}, _type{Type::Double} {}
+
+TableColumn::TableColumn(const char* const name, const Containers::StridedArrayView1D<const Color4>& data): _name{name}, _format{}, _data{data}, _type{Type::Color} {}
+
+namespace {
+
+template<class T> inline const T& get(const TableColumn& column, const std::size_t row) {
+    return Containers::arrayCast<const T>(column.data())[row];
+}
+
+bool lessThan(const TableColumn& column, const UnsignedInt a, const UnsignedInt b) {
+    switch(column.type()) {
+        case TableColumn::Type::String:
+            return get<Containers::StringView>(column, a) < get<Containers::StringView>(column, b);
+        case TableColumn::Type::Int:
+            return get<Int>(column, a) < get<Int>(column, b);
+        case TableColumn::Type::UnsignedInt:
+            return get<UnsignedInt>(column, a) < get<UnsignedInt>(column, b);
+        case TableColumn::Type::Float:
+            return get<Float>(column, a) < get<Float>(column, b);
+        case TableColumn::Type::Double:
+            return get<Double>(column, a) < get<Double>(column, b);
+        /* Colors sorted by hue first, then by brightness */
+        case TableColumn::Type::Color: {
+            const Color4& ca = get<Color4>(column, a);
+            const Color4& cb = get<Color4>(column, b);
+            const ColorHsv ha = ca.toHsv();
+            const ColorHsv hb = cb.toHsv();
+            if(ha.hue != hb.hue) return ha.hue < hb.hue;
+            return ha.value < hb.value;
+        }
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+bool matches(const Containers::ArrayView<const TableColumn> columns, const std::size_t row, const Containers::StringView filter) {
+    for(const TableColumn& column: columns)
+        if(column.type() == TableColumn::Type::String && get<Containers::StringView>(column, row).contains(filter))
+            return true;
+    return false;
+}
+
+}
+
+TableIndex::TableIndex() = default;
+
+TableIndex& TableIndex::setFilter(const Containers::StringView filter) {
+    if(filter != _filter) {
+        _filter = filter;
+        _dirty = true;
+    }
+    return *this;
+}
+
+TableIndex& TableIndex::setSort(const Int column, const bool ascending) {
+    CORRADE_ASSERT(column >= -1,
+        "ImGuiIntegration::TableIndex::setSort(): invalid column" << column, *this);
+    if(column != _sortColumn || (column != -1 && ascending != _sortAscending)) {
+        _sortColumn = column;
+        _sortAscending = ascending;
+        _dirty = true;
+    }
+    return *this;
+}
+
+TableIndex& TableIndex::invalidate() {
+    _dirty = true;
+    return *this;
+}
+
+void TableIndex::update(const Containers::ArrayView<const TableColumn> columns) {
+    const std::size_t rowCount = columns.isEmpty() ? 0 : columns[0].size();
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 1; i != columns.size(); ++i)
+        CORRADE_ASSERT(columns[i].size() == rowCount,
+            "ImGuiIntegration::TableIndex::update(): expected column" << i << "to have" << rowCount << "rows but got" << columns[i].size(), );
+    #endif
+    CORRADE_ASSERT(_sortColumn < Int(columns.size()),
+        "ImGuiIntegration::TableIndex::update(): sort column" << _sortColumn << "out of range for" << columns.size() << "columns", );
+
+    /* If the filter or sort changed or the data shrank, start from scratch */
+    if(_dirty || rowCount < _rowCount) {
+        arrayRemoveSuffix(_rows, _rows.size());
+        _rowCount = 0;
+        _dirty = false;
+    }
+
+    /* Nothing was appended, nothing to do */
+    if(rowCount == _rowCount) return;
+
+    /* Filter the newly appended rows */
+    const std::size_t begin = _rows.size();
+    if(_filter.isEmpty()) {
+        UnsignedInt* const out = arrayAppend(_rows, NoInit, rowCount - _rowCount);
+        for(std::size_t i = 0; i != rowCount - _rowCount; ++i)
+            out[i] = UnsignedInt(_rowCount + i);
+    } else for(std::size_t i = _rowCount; i != rowCount; ++i) {
+        if(matches(columns, i, _filter))
+            arrayAppend(_rows, UnsignedInt(i));
+    }
+    _rowCount = rowCount;
+
+    /* Sort just the new rows and merge them with the already sorted ones.
+       Both algorithms are stable, so rows with equal values stay in the
+       original order. */
+    if(_sortColumn != -1) {
+        const TableColumn& column = columns[_sortColumn];
+        const bool ascending = _sortAscending;
+        const auto compare = [&column, ascending](const UnsignedInt a, const UnsignedInt b) {
+            return ascending ? lessThan(column, a, b) : lessThan(column, b, a);
+        };
+        std::stable_sort(_rows.begin() + begin, _rows.end(), compare);
+        std::inplace_merge(_rows.begin(), _rows.begin() + begin, _rows.end(), compare);
+    }
+}
+
+bool list(const char* const id, const Containers::StridedArrayView1D<const Containers::StringView>& items, Int& selected, TableIndex* const index, const Vector2& size) {
+    if(index) {
+        const TableColumn column{"", items};
+        index->update({&column, 1});
+    }
+
+    bool changed = false;
+    if(ImGui::BeginChild(id, ImVec2(size), true)) {
+        ImDrawList* const drawList = ImGui::GetWindowDrawList();
+        const ImU32 color = ImGui::GetColorU32(ImGuiCol_Text);
+
+        /* Only the visible items get emitted */
+        ImGuiListClipper clipper;
+        clipper.Begin(Int(index ? index->rows().size() : items.size()));
+        while(clipper.Step()) {
+            for(Int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const Int item = index ? Int(index->rows()[i]) : i;
+                const Containers::StringView text = items[item];
+
+                /* Drawing the text directly instead of passing it as a
+                   label, as it doesn't need to be null-terminated and could
+                   contain ## */
+                ImGui::PushID(item);
+                const ImVec2 position = ImGui::GetCursorScreenPos();
+                if(ImGui::Selectable("##item", item == selected) && item != selected) {
+                    selected = item;
+                    changed = true;
+                }
+                drawList->AddText(position, color, text.begin(), text.end());
+                ImGui::PopID();
+            }
+        }
+    }
+    ImGui::EndChild();
+
+    return changed;
+}
+
+void table(const char* const id, const Containers::ArrayView<const TableColumn> columns, TableIndex* const index, const Vector2& size) {
+    CORRADE_ASSERT(!columns.isEmpty(),
+        "ImGuiIntegration::table(): expected at least one column", );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 1; i != columns.size(); ++i)
+        CORRADE_ASSERT(columns[i].size() == columns[0].size(),
+            "ImGuiIntegration::table(): expected column" << i << "to have" << columns[0].size() << "rows but got" << columns[i].size(), );
+    #endif
+
+    ImGuiTableFlags flags = ImGuiTableFlags_ScrollY|ImGuiTableFlags_RowBg|ImGuiTableFlags_Borders|ImGuiTableFlags_Resizable;
+    /* Without the tristate the first column would be sorted by default */
+    if(index) flags |= ImGuiTableFlags_Sortable|ImGuiTableFlags_SortTristate;
+    if(!ImGui::BeginTable(id, Int(columns.size()), flags, ImVec2(size)))
+        return;
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    for(const TableColumn& column: columns)
+        ImGui::TableSetupColumn(column.name());
+    ImGui::TableHeadersRow();
+
+    if(index) {
+        ImGuiTableSortSpecs* const sortSpecs = ImGui::TableGetSortSpecs();
+        if(sortSpecs && sortSpecs->SpecsDirty) {
+            if(sortSpecs->SpecsCount)
+                index->setSort(sortSpecs->Specs[0].ColumnIndex, sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Ascending);
+            else
+                index->setSort(-1);
+            sortSpecs->SpecsDirty = false;
+        }
+
+        index->update(columns);
+    }
+
+    /* Only the visible rows get formatted and emitted */
+    ImGuiListClipper clipper;
+    clipper.Begin(Int(index ? index->rows().size() : columns[0].size()));
+    while(clipper.Step()) {
+        for(Int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const std::size_t row = index ? index->rows()[i] : i;
+            ImGui::TableNextRow();
+            for(std::size_t c = 0; c != columns.size(); ++c) {
+                const TableColumn& column = columns[c];
+                ImGui::TableSetColumnIndex(Int(c));
+                switch(column.type()) {
+                    case TableColumn::Type::String: {
+                        const Containers::StringView text = get<Containers::StringView>(column, row);
+                        ImGui::TextUnformatted(text.begin(), text.end());
+                    } break;
+                    case TableColumn::Type::Int:
+                        ImGui::Text(column.format(), get<Int>(column, row));
+                        break;
+                    case TableColumn::Type::UnsignedInt:
+                        ImGui::Text(column.format(), get<UnsignedInt>(column, row));
+                        break;
+                    case TableColumn::Type::Float:
+                        ImGui::Text(column.format(), Double(get<Float>(column, row)));
+                        break;
+                    case TableColumn::Type::Double:
+                        ImGui::Text(column.format(), get<Double>(column, row));
+                        break;
+                    case TableColumn::Type::Color: {
+                        const Color4& color = get<Color4>(column, row);
+                        /* The address is unique for every cell. Making the
+                           button as tall as a text line to have all rows of
+                           the same height, which the clipper relies on. */
+                        ImGui::PushID(&color);
+                        const Float height = ImGui::GetTextLineHeight();
+                        ImGui::ColorButton("##color", ImVec4(color), ImGuiColorEditFlags_AlphaPreview|ImGuiColorEditFlags_NoDragDrop, ImVec2{2.0f*height, height});
+                        ImGui::PopID();
+                    } break;
+                }
+            }
+        }
+    }
+
+    ImGui::EndTable();
+}
+
+namespace {
+
+/* Not using Math::join(), as that treats zero-sized ranges as empty */
+inline Range1D join(const Range1D& a, const Range1D& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+inline Range1D join(const Range1D& a, const Float b) {
+    return {Math::min(a.min(), b), Math::max(a.max(), b)};
+}
+
+Range1D rawRange(const Containers::StridedArrayView1D<const Float>& samples, const std::size_t begin, const std::size_t end) {
+    Range1D out{samples[begin], samples[begin]};
+    for(std::size_t i = begin + 1; i < end; ++i)
+        out = join(out, samples[i]);
+    return out;
+}
+
+}
+
+PlotCache::PlotCache() = default;
+
+PlotCache& PlotCache::invalidate() {
+    arrayRemoveSuffix(_levels, _levels.size());
+    _sampleCount = 0;
+    return *this;
+}
+
+void PlotCache::update(const Containers::StridedArrayView1D<const Float>& samples) {
+    /* If the data shrank, start from scratch */
+    if(samples.size() < _sampleCount) invalidate();
+
+    /* Nothing was appended, nothing to do */
+    if(samples.size() == _sampleCount) return;
+
+    /* Calculate ranges of newly completed blocks. Samples after the last
+       whole block are processed directly in range(). */
+    if(_levels.isEmpty()) arrayAppend(_levels, InPlaceInit);
+    for(std::size_t i = _levels[0].size(), end = samples.size()/BlockSize; i < end; ++i)
+        arrayAppend(_levels[0], rawRange(samples, i*BlockSize, (i + 1)*BlockSize));
+
+    /* Propagate the new blocks to the upper levels, each block covering two
+       blocks of the level below */
+    for(std::size_t level = 1; _levels[level - 1].size() >= 2; ++level) {
+        if(_levels.size() == level) arrayAppend(_levels, InPlaceInit);
+        const Containers::ArrayView<const Range1D> below = _levels[level - 1];
+        for(std::size_t i = _levels[level].size(), end = below.size()/2; i < end; ++i)
+            arrayAppend(_levels[level], join(below[2*i], below[2*i + 1]));
+    }
+
+    _sampleCount = samples.size();
+}
+
+Range1D PlotCache::range(const Containers::StridedArrayView1D<const Float>& samples, std::size_t begin, std::size_t end) const {
+    CORRADE_ASSERT(samples.size() == _sampleCount,
+        "ImGuiIntegration::PlotCache::range(): expected" << _sampleCount << "samples but got" << samples.size(), {});
+    CORRADE_ASSERT(begin < end && end <= samples.size(),
+        "ImGuiIntegration::PlotCache::range(): invalid range [" << Debug::nospace << begin << Debug::nospace << "," << end << Debug::nospace << ") for" << samples.size() << "samples", {});
+
+    /* Samples before the first and after the last whole block */
+    Range1D out{samples[begin], samples[begin]};
+    while(begin < end && begin % BlockSize)
+        out = join(out, samples[begin++]);
+    while(begin < end && end % BlockSize)
+        out = join(out, samples[--end]);
+
+    /* Whole blocks, going up the pyramid while there are blocks whose pair
+       isn't in the range */
+    std::size_t i = begin/BlockSize;
+    std::size_t j = end/BlockSize;
+    for(std::size_t level = 0; i < j; ++level) {
+        if(i & 1) out = join(out, _levels[level][i++]);
+        if(j & 1) out = join(out, _levels[level][--j]);
+        i >>= 1;
+        j >>= 1;
+    }
+
+    return out;
+}
+
+namespace {
+
+void plotInternal(const char* const id, const Containers::StridedArrayView1D<const Float>& x, const Containers::StridedArrayView1D<const Float>& values, PlotCache* const cache, const Range1D& valueRange, const Vector2& size) {
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const Vector2 frameSize{
+        size.x() > 0.0f ? size.x() : Math::max(ImGui::GetContentRegionAvail().x, 1.0f),
+        size.y() > 0.0f ? size.y() : 4.0f*ImGui::GetFrameHeight()};
+
+    const ImVec2 frameMin = ImGui::GetCursorScreenPos();
+    const ImVec2 frameMax{frameMin.x + frameSize.x(), frameMin.y + frameSize.y()};
+    ImGui::InvisibleButton(id, ImVec2(frameSize));
+    if(!ImGui::IsItemVisible())
+        return;
+
+    ImDrawList* const drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(frameMin, frameMax, ImGui::GetColorU32(ImGuiCol_FrameBg), style.FrameRounding);
+    if(values.isEmpty())
+        return;
+
+    if(cache) cache->update(values);
+    const auto range = [&](const std::size_t begin, const std::size_t end) {
+        return cache ? cache->range(values, begin, end) : rawRange(values, begin, end);
+    };
+
+    const Range2D inner{
+        {frameMin.x + style.FramePadding.x, frameMin.y + style.FramePadding.y},
+        {frameMax.x - style.FramePadding.x, frameMax.y - style.FramePadding.y}};
+    const std::size_t count = values.size();
+
+    /* Vertical mapping, values outside of the range get clipped */
+    const Range1D yRange = valueRange.size() != 0.0f ? valueRange : range(0, count);
+    const Float yScale = yRange.size() != 0.0f ? inner.sizeY()/yRange.size() : 0.0f;
+    const auto toY = [&](const Float value) {
+        return yScale != 0.0f ? inner.max().y() - (value - yRange.min())*yScale : inner.centerY();
+    };
+
+    /* Horizontal mapping, either evenly spaced or by the X coordinates */
+    const Range1D xRange = x.isEmpty() ? Range1D{0.0f, Float(count - 1)} : Range1D{x[0], x[count - 1]};
+    const Float xScale = xRange.size() != 0.0f ? inner.sizeX()/xRange.size() : 0.0f;
+    const auto toX = [&](const std::size_t i) {
+        const Float value = x.isEmpty() ? Float(i) : x[i];
+        return xScale != 0.0f ? inner.min().x() + (value - xRange.min())*xScale : inner.centerX();
+    };
+
+    const std::size_t columnCount = Math::max(std::size_t(inner.sizeX()), std::size_t{1});
+    Containers::Array<ImVec2> points;
+    std::size_t pointCount = 0;
+
+    /* Few enough values, draw them directly */
+    if(count <= 2*columnCount) {
+        points = Containers::Array<ImVec2>{NoInit, count};
+        for(; pointCount != count; ++pointCount)
+            points[pointCount] = ImVec2{toX(pointCount), toY(values[pointCount])};
+
+    /* Otherwise draw minimum and maximum of values in each pixel column */
+    } else {
+        /* First value falling into given column. Without X coordinates the
+           values are evenly distributed, otherwise it's a binary search. */
+        const auto firstValue = [&](const std::size_t column) -> std::size_t {
+            if(column == columnCount) return count;
+            if(x.isEmpty()) return count*column/columnCount;
+            const Float value = xRange.min() + xRange.size()*Float(column)/Float(columnCount);
+            std::size_t begin = 0, end = count;
+            while(begin < end) {
+                const std::size_t middle = begin + (end - begin)/2;
+                if(x[middle] < value) begin = middle + 1;
+                else end = middle;
+            }
+            return begin;
+        };
+
+        points = Containers::Array<ImVec2>{NoInit, 2*columnCount};
+        std::size_t begin = firstValue(0);
+        for(std::size_t column = 0; column != columnCount; ++column) {
+            const std::size_t end = firstValue(column + 1);
+            if(begin == end) continue;
+
+            const Range1D columnRange = range(begin, end);
+            const Float px = inner.min().x() + Float(column) + 0.5f;
+            const Float minY = toY(columnRange.min());
+            const Float maxY = toY(columnRange.max());
+
+            /* Start with whichever end is closer to the previous column to
+               avoid crossing lines */
+            if(pointCount && Math::abs(points[pointCount - 1].y - maxY) < Math::abs(points[pointCount - 1].y - minY)) {
+                points[pointCount++] = ImVec2{px, maxY};
+                points[pointCount++] = ImVec2{px, minY};
+            } else {
+                points[pointCount++] = ImVec2{px, minY};
+                points[pointCount++] = ImVec2{px, maxY};
+            }
+
+            begin = end;
+        }
+    }
+
+    drawList->PushClipRect(ImVec2(inner.min()), ImVec2(inner.max()), true);
+    drawList->AddPolyline(points.data(), Int(pointCount),
+        ImGui::GetColorU32(ImGui::IsItemHovered() ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotLines), 0, 1.0f);
+    drawList->PopClipRect();
+}
+
+}
+
+void plot(const char* const id, const Containers::StridedArrayView1D<const Float>& values, PlotCache* const cache, const Range1D& valueRange, const Vector2& size) {
+    plotInternal(id, nullptr, values, cache, valueRange, size);
+}
+
+void plot(const char* const id, const Containers::StridedArrayView1D<const Float>& x, const Containers::StridedArrayView1D<const Float>& values, PlotCache* const cache, const Range1D& valueRange, const Vector2& size) {
+    CORRADE_ASSERT(x.size() == values.size(),
+        "ImGuiIntegration::plot(): expected" << values.size() << "X coordinates but got" << x.size(), );
+    plotInternal(id, x, values, cache, valueRange, size);
+}
+
+}}
@@ -32,12 +32,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::ImGuiIntegration::textureId(), @ref Magnum::ImGuiIntegration::image(), @ref Magnum::ImGuiIntegration::imageButton()
+ * @brief Function @ref Magnum::ImGuiIntegration::textureId(), @ref Magnum::ImGuiIntegration::image(), @ref Magnum::ImGuiIntegration::imageButton(), @ref Magnum::ImGuiIntegration::list(), @ref Magnum::ImGuiIntegration::table(), @ref Magnum::ImGuiIntegration::plot(), class @ref Magnum::ImGuiIntegration::TableColumn, @ref Magnum::ImGuiIntegration::TableIndex, @ref Magnum::ImGuiIntegration::PlotCache
  */
 
 #include "Magnum/ImGuiIntegration/visibility.h" /* defines IMGUI_API */
 
 #include <imgui.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
 #include <Magnum/Math/Range.h>
 #include <Magnum/Math/Color.h>
 #include <Magnum/GL/Texture.h>
@@ -176,6 +179,309 @@ CORRADE_DEPRECATED("use imageButton(const char*, GL::Texture2D&, const Vector2&,
 }
 #endif
 
+/**
+@brief Table column
+@m_since_latest_{integration}
+
+References data of a single column displayed by @ref table() or filtered and
+sorted by @ref TableIndex. The data aren't copied, so they have to stay in
+scope for as long as the column is used.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT TableColumn {
+    public:
+        /** @brief Column type */
+        enum class Type: UnsignedByte {
+            String,         /**< @ref Containers::StringView */
+            Int,            /**< @ref Magnum::Int */
+            UnsignedInt,    /**< @ref Magnum::UnsignedInt */
+            Float,          /**< @ref Magnum::Float */
+            Double,         /**< @ref Magnum::Double */
+            Color           /**< @ref Color4, shown as a color square */
+        };
+
+        /**
+         * @brief Construct a string column
+         *
+         * The strings are displayed as-is, they don't need to be
+         * null-terminated.
+         */
+        explicit TableColumn(const char* name, const Containers::StridedArrayView1D<const Containers::StringView>& data);
+
+        /**
+         * @brief Construct an integer column
+         *
+         * The @p format is a @cpp printf() @ce-style format string used to
+         * display the values.
+         */
+        explicit TableColumn(const char* name, const Containers::StridedArrayView1D<const Int>& data, const char* format = "%d");
+
+        /** @overload */
+        explicit TableColumn(const char* name, const Containers::StridedArrayView1D<const UnsignedInt>& data, const char* format = "%u");
+
+        /** @overload */
+        explicit TableColumn(const char* name, const Containers::StridedArrayView1D<const Float>& data, const char* format = "%g");
+
+        /** @overload */
+        explicit TableColumn(const char* name, const Containers::StridedArrayView1D<const Double>& data, const char* format = "%g");
+
+        /** @brief Construct a color column */
+        explicit TableColumn(const char* name, const Containers::StridedArrayView1D<const Color4>& data);
+
+        /** @brief Column name */
+        const char* name() const { return _name; }
+
+        /** @brief Column type */
+        Type type() const { return _type; }
+
+        /**
+         * @brief Format string
+         *
+         * @cpp nullptr @ce for @ref Type::String and @ref Type::Color.
+         */
+        const char* format() const { return _format; }
+
+        /** @brief Column data */
+        Containers::StridedArrayView1D<const void> data() const { return _data; }
+
+        /** @brief Row count */
+        std::size_t size() const { return _data.size(); }
+
+    private:
+        const char* _name;
+        const char* _format;
+        Containers::StridedArrayView1D<const void> _data;
+        Type _type;
+};
+
+/**
+@brief Persistent filtering and sorting index for @ref table() and @ref list()
+@m_since_latest_{integration}
+
+Keeps a list of rows that pass the filter set with @ref setFilter(), ordered
+by the column set with @ref setSort(). The index is built only when the
+filter or sort changes, or when @ref invalidate() is called. Rows appended to
+the data since the last @ref update() are filtered, sorted and merged into the
+existing index, so data that only grow, such as logs, aren't processed again
+every frame:
+
+@snippet ImGuiIntegration.cpp TableIndex
+
+If the data change in a different way than by appending, such as when rows get
+modified, inserted or removed, call @ref invalidate(). Data with fewer rows
+than in the last @ref update() make the index rebuild automatically.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT TableIndex {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * No filtering or sorting is done by default.
+         */
+        explicit TableIndex();
+
+        /** @brief Filter */
+        Containers::StringView filter() const { return _filter; }
+
+        /**
+         * @brief Set filter
+         * @return Reference to self (for method chaining)
+         *
+         * Only rows where at least one @ref TableColumn::Type::String column
+         * contains @p filter are kept. The comparison is case-sensitive. Pass
+         * an empty string to keep all rows.
+         */
+        TableIndex& setFilter(Containers::StringView filter);
+
+        /**
+         * @brief Sort column
+         *
+         * @cpp -1 @ce if the rows aren't sorted.
+         */
+        Int sortColumn() const { return _sortColumn; }
+
+        /** @brief Whether the rows are sorted in an ascending order */
+        bool isSortAscending() const { return _sortAscending; }
+
+        /**
+         * @brief Set sort column
+         * @return Reference to self (for method chaining)
+         *
+         * Pass @cpp -1 @ce to keep the rows in the original order. Rows with
+         * equal values stay in the original order. With @ref table(), the
+         * sort is set by clicking on the column headers.
+         */
+        TableIndex& setSort(Int column, bool ascending = true);
+
+        /**
+         * @brief Invalidate the index
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the next @ref update() build the index from scratch.
+         */
+        TableIndex& invalidate();
+
+        /**
+         * @brief Update the index
+         *
+         * Called by @ref table() and @ref list(). Expects that all columns
+         * have the same size and that @ref sortColumn() is less than column
+         * count.
+         */
+        void update(Containers::ArrayView<const TableColumn> columns);
+
+        /**
+         * @brief Rows passing the filter in the sorted order
+         *
+         * Indices into the column data, as of the last @ref update().
+         */
+        Containers::ArrayView<const UnsignedInt> rows() const { return _rows; }
+
+    private:
+        Containers::String _filter;
+        Containers::Array<UnsignedInt> _rows;
+        std::size_t _rowCount{};
+        Int _sortColumn{-1};
+        bool _sortAscending{true};
+        bool _dirty{true};
+};
+
+/**
+@brief Virtualized list widget
+@param id           Widget ID
+@param items        Items to display
+@param selected     Index of the selected item in @p items, @cpp -1 @ce if
+    there's none
+@param index        Optional index for filtering and sorting the items
+@param size         Widget size. Zero fills the available space.
+@return Whether the selection changed
+@m_since_latest_{integration}
+
+Displays the items in a scrollable child window. Only the visible items are
+processed every frame, so the list can have millions of items without slowing
+the UI down. Clicking an item sets @p selected to its index.
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT bool list(const char* id, const Containers::StridedArrayView1D<const Containers::StringView>& items, Int& selected, TableIndex* index = nullptr, const Vector2& size = {});
+
+/**
+@brief Virtualized table widget
+@param id           Widget ID
+@param columns      Columns to display
+@param index        Optional index for filtering and sorting the rows
+@param size         Widget size. Zero fills the available space.
+@m_since_latest_{integration}
+
+Displays the columns in a scrollable table with headers. Only the visible
+rows are formatted and emitted every frame, so the table can have millions of
+rows without slowing the UI down:
+
+@snippet ImGuiIntegration.cpp table
+
+If @p index is passed, the table is sortable by clicking on the headers. See
+@ref TableIndex for more information. Expects that @p columns isn't empty and
+all columns have the same size.
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT void table(const char* id, Containers::ArrayView<const TableColumn> columns, TableIndex* index = nullptr, const Vector2& size = {});
+
+/**
+@brief Min/max cache for @ref plot()
+@m_since_latest_{integration}
+
+Keeps minimum and maximum of blocks of samples in a pyramid where every level
+covers blocks twice as large as the previous one. The minimum and maximum of
+an arbitrary range of samples is then calculated in a logarithmic time,
+which makes @ref plot() draw time depend only on the widget width and not on
+the sample count.
+
+When samples get appended, @ref update() only processes the new samples, so
+data that only grow, such as telemetry, aren't processed again every frame:
+
+@snippet ImGuiIntegration.cpp PlotCache
+
+If the samples change in a different way than by appending, call
+@ref invalidate(). Samples with a smaller count than in the last
+@ref update() make the cache rebuild automatically.
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT PlotCache {
+    public:
+        /**
+         * @brief Size of the smallest block in the pyramid
+         *
+         * Samples not covered by whole blocks are processed directly.
+         */
+        enum: std::size_t { BlockSize = 16 };
+
+        /** @brief Constructor */
+        explicit PlotCache();
+
+        /** @brief Count of samples processed in the last @ref update() */
+        std::size_t sampleCount() const { return _sampleCount; }
+
+        /**
+         * @brief Invalidate the cache
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the next @ref update() build the cache from scratch.
+         */
+        PlotCache& invalidate();
+
+        /**
+         * @brief Update the cache
+         *
+         * Called by @ref plot().
+         */
+        void update(const Containers::StridedArrayView1D<const Float>& samples);
+
+        /**
+         * @brief Range of sample values
+         *
+         * Returns minimum and maximum of @p samples in the range
+         * @f$ [ \text{begin}, \text{end} ) @f$. Expects that @ref update()
+         * was called with the same @p samples and that @p begin is less than
+         * @p end and @p end isn't larger than sample count.
+         */
+        Range1D range(const Containers::StridedArrayView1D<const Float>& samples, std::size_t begin, std::size_t end) const;
+
+    private:
+        Containers::Array<Containers::Array<Range1D>> _levels;
+        std::size_t _sampleCount{};
+};
+
+/**
+@brief Plot widget
+@param id           Widget ID
+@param values       Values to plot
+@param cache        Optional cache for the value ranges
+@param valueRange   Range of values mapped to the widget height. If it's
+    zero-sized, the range is calculated from @p values.
+@param size         Widget size. Zero width fills the available space, zero
+    height uses four times the frame height.
+@m_since_latest_{integration}
+
+Plots @p values as a line over the whole widget width. If there's more values
+than twice the widget width in pixels, each pixel column shows just the
+minimum and maximum of values falling into it, so the amount of drawn vertices
+depends only on the widget width. Compared to @cpp ImGui::PlotLines() @ce
+this makes it possible to plot millions of values without slowing the UI
+down:
+
+@snippet ImGuiIntegration.cpp plot
+
+Without a @p cache, all values are processed every frame. Passing a
+@ref PlotCache makes the draw time independent of the value count as well.
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT void plot(const char* id, const Containers::StridedArrayView1D<const Float>& values, PlotCache* cache = nullptr, const Range1D& valueRange = {}, const Vector2& size = {});
+
+/**
+@brief Plot widget with custom X coordinates
+@m_since_latest_{integration}
+
+Like @ref plot(const char*, const Containers::StridedArrayView1D<const Float>&, PlotCache*, const Range1D&, const Vector2&),
+but with @p values placed on the horizontal axis according to @p x instead
+of evenly. Expects that @p x and @p values have the same size and that @p x
+is sorted in an ascending order, such as time stamps of the values.
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT void plot(const char* id, const Containers::StridedArrayView1D<const Float>& x, const Containers::StridedArrayView1D<const Float>& values, PlotCache* cache = nullptr, const Range1D& valueRange = {}, const Vector2& size = {});
+
 }}
 
 #endif
@@ -30,6 +30,7 @@
 */
 
 #cmakedefine MAGNUM_IMGUIINTEGRATION_BUILD_STATIC
+#cmakedefine MAGNUM_IMGUIINTEGRATION_TARGET_VK
 
 #ifdef MAGNUM_IMGUIINTEGRATION_USER_CONFIG
 #include MAGNUM_IMGUIINTEGRATION_USER_CONFIG